@@ -30,6 +30,13 @@
  *      an unsigned long representing the length of the string in that array.
  *      And an unsigned long representing the actual amount of memory allocated
  *      to that array. 
+ *      Short strings are kept in a small buffer inside the struct itself, so the common case of an
+ *      empty or short string needs a single allocation. The pointer to the character array points
+ *      into that inline buffer until the string outgrows it, and then it is moved to the heap.
+ *      The inline buffer is a flexible array member, so a string can also be allocated (and
+ *      grown with the ...Ex functions) as a single block holding both the struct and its chars.
+ *      Arrays on the heap start with a reference count, so a clone shares the array of the
+ *      string it was cloned from until one of them is changed (copy on write).
  *      I decided to do it this way because while we need to know the length of
  *      the string, we also need the actual size since we do not always want to
  *      allocate more memory. For example, a MyStruct with string length of 8
@@ -41,14 +48,35 @@
  *
  *  Memory allocation:
  *      I allocated memory wherever needed. Mostly for new structs and new c strings.
- *      And I saved memory by using the implementation described previously and setting
- *      a bench mark of 16 bytes to realloc (as described in the doc string of reSizeMyString
+ *      And I saved memory by using the implementation described previously. Strings grow
+ *      geometrically and are only shrunk once they use a small part of their capacity (as
+ *      described in the doc string of reSizeStringArray), so realloc is rarely called.
  *
  *
  ********************************************************************************/
 
 // ------------------------------ includes ------------------------------
+#define _POSIX_C_SOURCE 200809L
+// for fwrite_unlocked
+#define _DEFAULT_SOURCE
 #include "MyString.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <float.h>
+#include <locale.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MYSTRING_X86
+#endif
 
 // -------------------------- constant definitions -------------------------
 /*
@@ -56,6 +84,11 @@
  * @brief Macro function that returns the minimum of two given ints
  */
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
+/*
+ * @def MAX
+ * @brief Macro function that returns the maximum of two given ints
+ */
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
 /*
  * @def NULL_BYTE
  * @brief A macro representing a null byte
@@ -72,25 +105,119 @@
  */
 #define START_SIZE 16
 /*
- * @def FIRST_INDEX
- * @brief First index in an array
+ * @def SHORT_SIZE
+ * @brief Default capacity of the inline buffer held at the end of every MyString struct
  */
-#define FIRST_INDEX 0
+#define SHORT_SIZE 24
+/*
+ * @def MYSTRING_GROWTH_NUMERATOR
+ * @brief Numerator of the factor by which a string's capacity grows when it runs out of room.
+ *        Can be set at compile time (i.e. -DMYSTRING_GROWTH_NUMERATOR=3)
+ */
+#ifndef MYSTRING_GROWTH_NUMERATOR
+#define MYSTRING_GROWTH_NUMERATOR 2
+#endif
+/*
+ * @def MYSTRING_GROWTH_DENOMINATOR
+ * @brief Denominator of the factor by which a string's capacity grows when it runs out of room.
+ *        Can be set at compile time (i.e. -DMYSTRING_GROWTH_DENOMINATOR=2)
+ */
+#ifndef MYSTRING_GROWTH_DENOMINATOR
+#define MYSTRING_GROWTH_DENOMINATOR 1
+#endif
+#if MYSTRING_GROWTH_DENOMINATOR <= 0 || MYSTRING_GROWTH_NUMERATOR <= MYSTRING_GROWTH_DENOMINATOR
+#error "MYSTRING_GROWTH_NUMERATOR / MYSTRING_GROWTH_DENOMINATOR must be bigger than 1"
+#endif
+/*
+ * @def MYSTRING_SHRINK_RATIO
+ * @brief A string's capacity is only shrunk once its length is below capacity / this ratio.
+ *        Must be bigger than the growth factor. Can be set at compile time.
+ */
+#ifndef MYSTRING_SHRINK_RATIO
+#define MYSTRING_SHRINK_RATIO 4
+#endif
+#if MYSTRING_SHRINK_RATIO * MYSTRING_GROWTH_DENOMINATOR <= MYSTRING_GROWTH_NUMERATOR
+#error "MYSTRING_SHRINK_RATIO must be bigger than the growth factor"
+#endif
+/*
+ * @def ARENA_SLAB_SIZE
+ * @brief Default amount of bytes an arena allocates at once
+ */
+#define ARENA_SLAB_SIZE 65536
+/*
+ * @def ARENA_ALIGNMENT
+ * @brief Every allocation from an arena starts at a multiple of this many bytes
+ */
+#define ARENA_ALIGNMENT 16
+/*
+ * @def POOL_SHARD_COUNT
+ * @brief Amount of separately locked hash tables a MyStringPool is split into
+ */
+#define POOL_SHARD_COUNT 16
+/*
+ * @def POOL_START_CAPACITY
+ * @brief Amount of slots in each hash table of a new MyStringPool
+ */
+#define POOL_START_CAPACITY 16
+/*
+ * @def NO_HASH
+ * @brief Cached hash value of a MyString whose hash was not computed yet
+ */
+#define NO_HASH 0
+/*
+ * @def HASH_SECRET_0 HASH_SECRET_1 HASH_SECRET_2 HASH_SECRET_3
+ * @brief Constants mixed into myStringHash (the wyhash secrets)
+ */
+#define HASH_SECRET_0 0xa0761d6478bd642fULL
+#define HASH_SECRET_1 0xe7037ed1a0b428dbULL
+#define HASH_SECRET_2 0x8ebc6af09c88c6e3ULL
+#define HASH_SECRET_3 0x589965cc75374cc3ULL
+/*
+ * @def MAP_GROUP_SIZE
+ * @brief Amount of control bytes of a MyStringMap checked at once
+ */
+#define MAP_GROUP_SIZE 16
 /*
- * @def POSITIVE
- * @brief Positive integer
+ * @def MAP_EMPTY
+ * @brief Control byte of an empty MyStringMap slot
  */
-#define POSITIVE 1
+#define MAP_EMPTY ((signed char) -128)
 /*
- * @def NEGATIVE
- * @brief Negative integer
+ * @def MAP_DELETED
+ * @brief Control byte of an erased MyStringMap slot (a tombstone), or of an entry waiting to be
+ *        placed while rehashing
  */
-#define NEGATIVE -1
+#define MAP_DELETED ((signed char) -2)
+/*
+ * @def MAP_HASH_BITS
+ * @brief Mask of the hash bits kept in the control byte of a full MyStringMap slot
+ */
+#define MAP_HASH_BITS 0x7F
+/*
+ * @def FIRST_INDEX
+ * @brief First index in an array
+ */
+#define FIRST_INDEX 0
 /*
  * @def MINUS
  * @brief ASCII value of '-'
  */
 #define MINUS 45
+/*
+ * @def PLUS
+ * @brief ASCII value of '+'
+ */
+#define PLUS 43
+/*
+ * @def DECIMAL_POINT
+ * @brief The char between the integer and the fraction of a number
+ */
+#define DECIMAL_POINT '.'
+/*
+ * @def EXPONENT_CHAR
+ * @brief The char before the exponent of a number (in lower case)
+ */
+#define EXPONENT_CHAR 'e'
 /*
  * @def NINE
  * @brief ASCII value of '9'
@@ -101,21 +228,11 @@
  * @brief ASCII value of '0'
  */
 #define ZERO 48
-/*
- * @def BASE
- * @brief Base double for logorithmic math use
- */
-#define BASE 10.0
 /*
  * @def CHAR_TO_INT
  * @brief ASCII value needed to add to turn an int into char representation of that int
  */
 #define CHAR_TO_INT 48
-/*
- * @def SMALLER_THAN_ZERO
- * @brief Numbers smaller than this are negative
- */
-#define SMALLER_THAN_ZERO 0
 /*
  * @def SAME
  * @brief Value representing equality for comparators
@@ -131,6 +248,226 @@
  * @brief Value representing the first element is smaller in a comparator
  */
 #define SMALLER -1
+/*
+ * @def UPPER_A UPPER_Z
+ * @brief ASCII values of 'A' and 'Z'
+ */
+#define UPPER_A 65
+#define UPPER_Z 90
+/*
+ * @def CASE_DIFFERENCE
+ * @brief ASCII value needed to add to an upper case letter to get its lower case letter
+ */
+#define CASE_DIFFERENCE 32
+/*
+ * @def SORT_KEY_END
+ * @brief Sort key of the position after the end of a string, smaller than the key of any char
+ */
+#define SORT_KEY_END 0
+/*
+ * @def SORT_SIGN_BIT
+ * @brief Bit flipped in a char to order it as a char is compared: the sign bit where char is
+ *        signed, nothing where it is unsigned
+ */
+#if CHAR_MIN < 0
+#define SORT_SIGN_BIT 0x80
+#else
+#define SORT_SIGN_BIT 0
+#endif
+/*
+ * @def RADIX_BUCKETS
+ * @brief Amount of buckets in a pass of the radix sort (the end of a string and every char)
+ */
+#define RADIX_BUCKETS 257
+/*
+ * @def RADIX_CUTOFF
+ * @brief Amount of strings below which the radix sort hands a bucket to a comparison sort
+ */
+#define RADIX_CUTOFF 64
+/*
+ * @def INSERTION_CUTOFF
+ * @brief Amount of strings below which the multikey quicksort uses an insertion sort
+ */
+#define INSERTION_CUTOFF 16
+/*
+ * @def SORT_PREFIX_LENGTH
+ * @brief Amount of chars kept in the prefix of a sort record
+ */
+#define SORT_PREFIX_LENGTH 8
+/*
+ * @def PARALLEL_SORT_CHUNK
+ * @brief Smallest amount of strings a thread of the parallel sort is given
+ */
+#define PARALLEL_SORT_CHUNK 16384
+/*
+ * @def WRITE_BATCH_SIZE
+ * @brief Most buffers written by a single writev (the IOV_MAX of Linux)
+ */
+#define WRITE_BATCH_SIZE 1024
+/*
+ * @def INT_STRING_SIZE
+ * @brief Most chars in the decimal representation of an int (sign included)
+ */
+#define INT_STRING_SIZE 11
+/*
+ * @def INT64_STRING_SIZE
+ * @brief Most chars in the decimal representation of a 64 bit integer (signed or not)
+ */
+#define INT64_STRING_SIZE 20
+/*
+ * @def DOUBLE_STRING_SIZE
+ * @brief Room for the shortest representation of any double and a null byte
+ */
+#define DOUBLE_STRING_SIZE 32
+/*
+ * @def DIGIT_CHUNK_SIZE
+ * @brief Amount of digits parsed at once
+ */
+#define DIGIT_CHUNK_SIZE 8
+/*
+ * @def MAX_EXACT_DIGITS
+ * @brief Most decimal digits that always fit in 64 bits
+ */
+#define MAX_EXACT_DIGITS 19
+/*
+ * @def MAX_EXACT_MANTISSA
+ * @brief Biggest integer that every integer up to is an exact double (2^53)
+ */
+#define MAX_EXACT_MANTISSA 9007199254740992ULL
+/*
+ * @def MAX_EXACT_POWER
+ * @brief Biggest power of 10 that is an exact double
+ */
+#define MAX_EXACT_POWER 22
+/*
+ * @def MAX_DECIMAL_EXPONENT
+ * @brief Exponents are capped at this while parsing, any number beyond it is 0 or too big anyway
+ */
+#define MAX_DECIMAL_EXPONENT 100000
+/*
+ * @def DOUBLE_PARSE_BUFFER_SIZE
+ * @brief Numbers shorter than this are copied to the stack to be given to strtod
+ */
+#define DOUBLE_PARSE_BUFFER_SIZE 64
+/*
+ * @def DOUBLE_MIN_PRECISION
+ * @brief Significant digits that are always read back as the same double they were written from
+ */
+#define DOUBLE_MIN_PRECISION 15
+/*
+ * @def DOUBLE_MAX_PRECISION
+ * @brief Significant digits enough for any double to be read back as itself
+ */
+#define DOUBLE_MAX_PRECISION 17
+/*
+ * @def WRITER_BUFFER_SIZE
+ * @brief Default size of the buffer of a MyStringWriter
+ */
+#define WRITER_BUFFER_SIZE 65536
+/*
+ * @def READER_BUFFER_SIZE
+ * @brief Default size of the block a MyStringLineReader reads at once
+ */
+#define READER_BUFFER_SIZE 1048576
+/*
+ * @def NEW_LINE
+ * @brief new line character
+ */
+#define NEW_LINE '\n'
+/*
+ * @def BUILDER_SLICES
+ * @brief Amount of slices a new MyStringBuilder has room for
+ */
+#define BUILDER_SLICES 16
+/*
+ * @def BUILDER_SCRATCH_SIZE
+ * @brief Size of the scratch buffer of a new MyStringBuilder
+ */
+#define BUILDER_SCRATCH_SIZE 64
+/*
+ * @def ROPE_MERGE_SIZE
+ * @brief Adjacent rope leaves that are together at most this long are merged into one leaf
+ */
+#define ROPE_MERGE_SIZE 512
+/*
+ * @def MATCHER_ROOT
+ * @brief The node a MyStringMatcher starts at (the empty prefix)
+ */
+#define MATCHER_ROOT 0
+/*
+ * @def NO_MATCHER_NODE
+ * @brief Marks a missing node or pattern in a MyStringMatcher
+ */
+#define NO_MATCHER_NODE UINT32_MAX
+/*
+ * @def MATCHER_LINEAR_EDGES
+ * @brief Nodes of a MyStringMatcher with at most this many edges are searched one edge at a time,
+ *        the rest with a binary search
+ */
+#define MATCHER_LINEAR_EDGES 8
+/*
+ * @def MATCHER_EDGE_BLOCK
+ * @brief Edge chars of a MyStringMatcher node compared together with SSE2 (the edge chars are
+ *        padded so a block may be read past the last node)
+ */
+#define MATCHER_EDGE_BLOCK 16
+/*
+ * @def NO_SUFFIX
+ * @brief Marks an empty slot of a suffix array or a char that starts no LMS substring
+ */
+#define NO_SUFFIX UINT32_MAX
+/*
+ * @def INDEX_MAGIC
+ * @brief The first bytes of a file written by myStringIndexSave
+ */
+#define INDEX_MAGIC "MSINDEX1"
+/*
+ * @def INDEX_MAGIC_SIZE
+ * @brief Length of INDEX_MAGIC
+ */
+#define INDEX_MAGIC_SIZE 8
+/*
+ * @def INDEX_LOAD_CHUNK
+ * @brief Bytes of an array of a loaded index allocated before any of them is read, the rest
+ *        being allocated as they arrive
+ */
+#define INDEX_LOAD_CHUNK (1 << 20)
+/*
+ * @def INDEX_BYTE_ORDER
+ * @brief Written after INDEX_MAGIC, so a file of another byte order is not loaded
+ */
+#define INDEX_BYTE_ORDER 0x01020304
+/*
+ * @def CHAR_SET_WORD_BITS
+ * @brief Bits in every word of a MyCharSet
+ */
+#define CHAR_SET_WORD_BITS 64
+/*
+ * @def FILTER_BLOCK_SIZE
+ * @brief Chars the SIMD filter kernel checks together (half of them are compressed at a time)
+ */
+#define FILTER_BLOCK_SIZE 16
+/*
+ * @def SEARCH_BLOCK_SIZE
+ * @brief Candidate positions the SIMD substring filter checks together
+ */
+#define SEARCH_BLOCK_SIZE 16
+/*
+ * @def SEARCH_WORK_FACTOR
+ * @brief Chars the substring filter may verify for every position it passed before the search
+ *        switches to Two-Way (which keeps the worst case linear)
+ */
+#define SEARCH_WORK_FACTOR 4
+/*
+ * @def SEARCH_WORK_SLACK
+ * @brief Chars the substring filter may verify before SEARCH_WORK_FACTOR applies
+ */
+#define SEARCH_WORK_SLACK 256
+/*
+ * @def MISMATCH_PROLOGUE
+ * @brief Amount of chars compared one by one before a compare kernel is called
+ */
+#define MISMATCH_PROLOGUE 8
 /*
  * @def EQUAL
  * @brief Value representing equality for equal functions
@@ -157,1201 +494,8569 @@
  *        Holds a pointer to a string.
  *        Holds an unsigned long representing the length of that string
  *        Holds and unsigned long representing the actual memory allocated to the string.
+ *        Holds a pointer to the arena the string was allocated in (NULL for heap strings).
+ *        Holds an unsigned long representing the capacity of the inline buffer.
+ *        Holds the hash of the string (NO_HASH until computed by myStringHash). It is atomic
+ *        so threads that only read a string can compute it at the same time.
+ *        Holds an inline buffer, allocated together with the struct, used for the string as long
+ *        as it fits in it (SHORT_SIZE bytes unless allocated with myStringAllocPacked).
  */
 struct _MyString
 {
     char *stringArray;
     unsigned long stringSize;
     unsigned long realSize;
+    MyStringArena *arena;
+    unsigned long shortSize;
+    atomic_uint_least64_t hash;
+    char shortArray[];
 };
 
 /**
- * @brief Allocates a new MyString and sets its value to "" (the empty string).
- * 			It is the caller's responsibility to free the returned MyString.
- *          Complexity is O(1) + whatever malloc is.
- * RETURN VALUE:
- * @return a pointer to the new string, or NULL if the allocation failed.
+ * @brief Header of every array a MyString keeps on the heap, so clones can share it.
+ *        Holds the (atomic) amount of MyStrings using the array.
+ *        Holds the amount of chars in the array when statistics are counted (so the last
+ *        MyString to release it knows how much memory is freed).
+ *        Holds the chars of the array, which is what stringArray points to.
  */
-static MyString *buildMyString(unsigned long memory)
+typedef struct SharedArray
 {
-    // creates a new pointer to a MyString struct the size of a MyString struct
-    MyString *stringPointer = malloc(sizeof(MyString));
-    // allocates enough memory for the array (length of the string) and sets to zero
-    stringPointer -> stringArray = malloc(memory);
-    // sets the string size and real size to be the length of the string
-    stringPointer -> stringSize = memory;
-    stringPointer -> realSize = memory;
-    return stringPointer;
-}
+    atomic_ulong referenceCount;
+#ifdef MYSTRING_STATS
+    unsigned long capacity;
+#endif
+    char data[];
+} SharedArray;
 
 /**
- * @brief Getter for the real size of a MyString
- *        Time complexity is O(1).
- * @param MyString we wish to get the real size of.
+ * @brief One part of a MyStringPool, an open addressing hash table with its own lock.
+ *        Holds a read/write lock, so lookups of strings already in the table run in parallel.
+ *        Holds the canonical MyStrings (NULL for empty slots) and their hashes.
+ *        Holds the amount of slots (a power of 2) and the amount of strings in the table.
  */
-static unsigned long myStringRealSize(const MyString * str1)
+typedef struct PoolShard
 {
-    return str1 -> realSize;
-}
+    pthread_rwlock_t lock;
+    MyString **strings;
+    uint64_t *hashes;
+    unsigned long capacity;
+    unsigned long count;
+} PoolShard;
 
 /**
- * @brief Function that deals with the resizing of a stringArray.
- *        Checks whether the string needs resizing (either it has too little room, or too much).
- *        The bench mark I set for too much room is 16 bytes. This is because the benchmark placed
- *        by C's string library sets that as the length of a "word" where word is not an actual
- *        word, but rather a memory size value. This is so we reallocate memory only when it is
- *        "worth" it to do so and not for every individual byte.
- *        Time complexity is O(1).
- * @param MyString we wish to maybe resize.
- * @param size we wish to maybe resize it to.
- * RETURN VALUE:
- * @return MYSTRING_SUCCESS on success MYSTRING_ERROR on error
+ * @brief MyStringPool holds one canonical MyString for every value interned in it.
+ *        Holds the shards the strings are split into by hash.
+ *        Holds atomic counters of lookups, lookups that found their string and bytes saved.
  */
-static MyStringRetVal reSizeStringArray(MyString *str, const unsigned long newSize)
+struct _MyStringPool
 {
-    // check whether we even need to resize. Either current size is too small or too big
-    if (myStringRealSize(str) < newSize || myStringRealSize(str) - newSize > 16)
-    {
-        // set a temp pointer to stringArray and attempt to realloc it to the new size
-        char *temp = str -> stringArray;
-        temp = realloc(temp, newSize);
-        // if it fails return an error (but we keep the pointer to stringArray)
-        if(temp == NULL)
-        {
-            return MYSTRING_ERROR;
-        }
-        // otherwise switch the pointers, set temp to NULL, change size and return success
-        else
-        {
-            str -> stringArray = temp;
-            temp = NULL;
-            str -> realSize = newSize;
-        }
-    }
-    return MYSTRING_SUCCESS;
-}
+    PoolShard shards[POOL_SHARD_COUNT];
+    atomic_ulong lookups;
+    atomic_ulong hits;
+    atomic_ulong bytesSaved;
+};
 
 /**
- * @brief finds the length of a c string.
- * @param pointer to a cString.
- * RETURN VALUE:
- * @return length of cString
+ * @brief MyStringMap maps MyStrings to pointers with open addressing (like a Swiss table).
+ *        Slots are checked a group of MAP_GROUP_SIZE at a time, using a control byte per slot
+ *        holding 7 bits of the key's hash, MAP_EMPTY or MAP_DELETED.
+ *        Holds the control bytes, keys and values of all slots.
+ *        Holds the amount of slots (a power of 2 and a multiple of MAP_GROUP_SIZE).
+ *        Holds the amount of keys and of tombstones in the map.
  */
-static unsigned long getCStringLength(const char *cString)
+struct _MyStringMap
 {
-    unsigned long i = EMPTY;
-    // iterate over the c string until we reach the null byte at the end
-    while (*(cString + i) != NULL_BYTE)
-    {
-        i++;
-    }
-    return i;
-}
+    signed char *controls;
+    MyString **keys;
+    void **values;
+    unsigned long capacity;
+    unsigned long count;
+    unsigned long tombstones;
+};
 
 /**
- * @brief Function receives an int and finds the number of digits in the int
- *        Time complexity is O(log digitCount). Where digitCount is the amount of digits.
- * @param n the int we want to get the length of.
- * RETURN VALUE:
- * @return (int) digitLength is the amount of digits in the int.
+ * @brief The functions used to compare arrays of chars in bulk. Each returns the index of the
+ *        first char where two arrays of a given length differ, or the length if they do not.
+ *        Holds the function comparing the chars as they are.
+ *        Holds the function comparing the chars with ASCII letters folded to lower case.
  */
-static int getLengthOfInt(int n)
+typedef struct CompareKernels
 {
-    // if it is negative just multiply by -1 to get positive
-    if(n < SMALLER_THAN_ZERO)
-    {
-        n *= NEGATIVE;
-    }
-    // find the length by flooring the result of value/10 to the power of each iteration
-    double digitLength = EMPTY;
-    double value = floor(n / pow(BASE, digitLength)) ;
-    while (value != EMPTY)
-    {
-        digitLength ++;
-        value = floor(n / pow(BASE, digitLength));
-    }
-    return (int) digitLength;
-}
+    unsigned long (*mismatch)(const char *chars1, const char *chars2, unsigned long length);
+    unsigned long (*caseMismatch)(const char *chars1, const char *chars2, unsigned long length);
+} CompareKernels;
 
 /**
- * @brief default comparator that compares two chars with a logical comparison.
- *        Time complexity is O(1).
- * @param char1 first char to compare
- * @param char2 second char to compare
- * RETURN VALUE:
- * @return MYSTR_ERROR_CODE if cannot compare, 0 if equal, 1 if char1 is bigger, -1 if char2 is.
+ * @brief A needle factored for the Two-Way search (needle = u v where |u| is critical).
+ *        Holds the chars and length of the needle.
+ *        Holds the length of u.
+ *        Holds the shift after a match: the period of the needle when it is periodic (u is a
+ *        suffix of the first period of v), a lower bound of it otherwise.
+ *        Holds whether the needle is periodic, in which case the search remembers how much of
+ *        the needle already matched after a shift.
  */
-static int defCompare(const char *char1, const char *char2)
+typedef struct TwoWayNeedle
 {
-    if(char1 == NULL || char2 == NULL)
-    {
-        return MYSTR_ERROR_CODE ;
-    }
-    if(*char1 == *char2)
-    {
-        return SAME;
-    }
-    
-    else if(*char1 > *char2)
-    {
-        return BIGGER;
-    }
-    else
-    {
-        return SMALLER;
-    }
-}
+    const char *chars;
+    unsigned long length;
+    unsigned long critical;
+    unsigned long shift;
+    bool periodic;
+} TwoWayNeedle;
 
 /**
- * @brief Equality checker compares two chars.
- *        Time complexity is O(n) where n is size entered.
- * @param Size we want to compare up till
- * @param MyString to check
- * @param second MyString to check
- * @param comparator function
- * RETURN VALUE:
- * @return 0 if equal, -1 or 1 otherwise
+ * @brief The occurrences a substring search found.
+ *        Holds the array the first occurrences are stored in (may be NULL) and its size.
+ *        Holds the amount of occurrences found.
+ *        Holds whether the search stops at the first occurrence.
  */
-static int checkEquality(const unsigned long size, const MyString *str1, const MyString *str2,
-                         int (*foo)(const char *compareChar1, const char *compareChar2))
+typedef struct SearchMatches
 {
-    // go over the strings character by character
-    for(unsigned long i = 0; i < size; i++)
-    {
-        char *char1 = (str1 -> stringArray + i);
-        char *char2 = (str2 -> stringArray + i);
-        //save the result we receive from our comparator
-        int tempResult = foo(char1, char2);
-        // if they don't match stop and return the result
-        if (tempResult != SAME)
-        {
-            return tempResult;
-        }
-    }
-    return SAME;
-}
+    unsigned long *indices;
+    unsigned long maxIndices;
+    unsigned long count;
+    bool firstOnly;
+} SearchMatches;
 
 /**
- * @brief casts the const void* it receives to be pointers to pointers to MyString and then
- *        returns our myStringCompare function with those two pointers to MyStrings.
- *        Time complexity is O(1)
- * @param arr
- * @param len
- *
- * RETURN VALUE: none
+ * @brief A string as the prefix sort sees it, so most comparisons do not read the string itself.
+ *        Holds the first SORT_PREFIX_LENGTH chars, as a number ordered like the chars are in
+ *        myStringCompare (every char has SORT_SIGN_BIT flipped, the first char is the highest
+ *        byte, and missing chars are 0).
+ *        Holds the length of the string.
+ *        Holds the string.
  */
-static int compareCaster(const void* str1, const void* str2)
+typedef struct SortRecord
 {
-    // cast str1 and str2 to be two pointers to pointers to MyString and return our compare with it
-    MyString** newStr1 = (MyString**) str1;
-    MyString** newStr2 = (MyString**) str2;
-    return myStringCompare(*newStr1, *newStr2);
-}
+    uint64_t prefix;
+    unsigned long length;
+    MyString *str;
+} SortRecord;
 
 /**
- * @brief default equality checker compares two chars with a logical comparison.
- *        Time complexity is O(1).
- * @param char1 first char to compare
- * @param char2 second char to compare
- * RETURN VALUE:
- * @return 0 if equal, 1 otherwise
+ * @brief A part of the work of the parallel sort, done by one thread.
+ *        Holds the strings to sort (first, with firstLen strings) when sorting a chunk.
+ *        Holds two sorted runs (first and second) and the part of their merge, from outStart
+ *        to outEnd, to write to out when merging.
+ *        Holds the comparator, NULL for the order of myStringCompare.
  */
-static int logicalEqual(const char *char1, const char *char2)
+typedef struct SortTask
 {
-    if (*char1 == *char2)
-    {
-        return 0;
-    }
-    return 1;
-}
+    MyString **first;
+    unsigned long firstLen;
+    MyString **second;
+    unsigned long secondLen;
+    MyString **out;
+    unsigned long outStart;
+    unsigned long outEnd;
+    int (*foo)(const void *str1, const void *str2);
+} SortTask;
 
+/**
+ * @brief MyStringWriter collects output in a buffer and writes it to a stream or a file
+ *        descriptor according to its flush policy.
+ *        Holds the stream (NULL when writing to a file descriptor) and the file descriptor.
+ *        Holds the buffer, the amount of bytes in it and its size.
+ *        Holds the flush policy, the amount of lines between flushes and the amount of lines in
+ *        the buffer.
+ *        Holds the statistics.
+ */
+struct _MyStringWriter
+{
+    FILE *stream;
+    int fd;
+    char *buffer;
+    unsigned long used;
+    unsigned long size;
+    MyStringFlushPolicy policy;
+    unsigned long flushLines;
+    unsigned long lines;
+    MyStringWriterStats stats;
+};
 
 /**
- * Complexity is O(1). Because buildMyString is O(1) and the other actions are also O(1).
+ * @brief MyStringLineReader reads big blocks of a file descriptor into a buffer and hands out
+ *        the lines in it.
+ *        Holds the file descriptor and the char ending the lines.
+ *        Holds the buffer and its size.
+ *        Holds where the next line starts, up to where the buffer was searched for the delim
+ *        without finding it, and where the chars read end.
+ *        Holds whether the end of the input was reached.
  */
-MyString * myStringAlloc()
+struct _MyStringLineReader
 {
-    // allocate a new myString of size 16 because we would like to save cost of reallocating later
-    MyString *newString = buildMyString(START_SIZE);
-    memset(newString -> stringArray, EMPTY, START_SIZE);
-    // set the first (and only) index to be a null byte, and it's string size to be 0
-    newString -> stringArray[FIRST_INDEX] = NULL_BYTE;
-    newString -> stringSize = EMPTY;
-    return newString;
-}
+    int fd;
+    char delim;
+    char *buffer;
+    unsigned long size;
+    unsigned long start;
+    unsigned long searched;
+    unsigned long end;
+    bool endOfInput;
+};
 
 /**
- * @brief Frees the memory and resources allocated to str.
- *        Time complexity is O(1).
- * @param str the MyString to free.
- * If str is NULL, no operation is performed.
- * It is the user's responsibility to set the pointer to NULL after calling this function
+ * @brief A piece recorded by a MyStringBuilder.
+ *        Holds the chars of the piece, or NULL if they are in the scratch buffer of the builder
+ *        (which may move when it grows), and then the offset of the piece in it.
+ *        Holds the length of the piece.
  */
-void myStringFree(MyString *str)
+typedef struct BuilderSlice
 {
-    // check that str is not null
-    if (str != NULL)
-    {
-        //if it isn't then free the array it's pointer points to
-        free(str -> stringArray);
-        str -> stringArray = NULL;
-        // also free the struct itself
-        free(str);
-    }
-}
+    const char *chars;
+    unsigned long offset;
+    unsigned long length;
+} BuilderSlice;
 
 /**
- * @brief Allocates a new MyString with the same value as str. It is the caller's
- * 		  responsibility to free the returned MyString.
- *        Time complexity is O(n) where n is the length of str.
- * @param str the MyString to clone.
+ * @brief MyStringBuilder records pieces to concatenate, copying them only when it is finished.
+ *        Holds the slices recorded, their amount and the amount there is room for.
+ *        Holds a scratch buffer for the chars of the pieces that are not kept anywhere else
+ *        (like formatted ints), the amount of chars in it and its size.
+ *        Holds the total length of the pieces.
+ */
+struct _MyStringBuilder
+{
+    BuilderSlice *slices;
+    unsigned long count;
+    unsigned long capacity;
+    char *scratch;
+    unsigned long scratchUsed;
+    unsigned long scratchSize;
+    unsigned long length;
+};
+
+/**
+ * @brief A node of a MyRope. Nodes are never changed once built, so ropes share them freely.
+ *        Holds the (atomic) amount of references to the node.
+ *        Holds the amount of chars under the node and its height (0 for a leaf).
+ *        An inner node holds its two children, and a leaf holds a MyString of its own and the
+ *        slice of it that belongs to the rope (str is NULL for inner nodes).
+ */
+typedef struct RopeNode
+{
+    atomic_ulong referenceCount;
+    unsigned long length;
+    int height;
+    struct RopeNode *left;
+    struct RopeNode *right;
+    MyString *str;
+    unsigned long offset;
+} RopeNode;
+
+/**
+ * @brief MyRope is a balanced (AVL) tree of chunks of chars.
+ *        Holds the root of the tree, which is NULL for an empty rope.
+ */
+struct _MyRope
+{
+    RopeNode *root;
+};
+
+/**
+ * @brief A node of a MyStringMatcher, standing for a prefix of some patterns. Nodes are numbered
+ *        in breadth first order, so the nodes near the root (which are visited the most) are
+ *        together in memory.
+ *        Holds the index of its first edge and its amount of edges (sorted by char).
+ *        Holds its failure node: the node of its longest proper suffix that is a node too.
+ *        Holds the first node on the failure chain (itself included) that ends a pattern.
+ *        Holds the first pattern ending at it (the others are chained by nextPattern).
+ */
+typedef struct MatcherNode
+{
+    uint32_t firstEdge;
+    uint32_t edgeCount;
+    uint32_t fail;
+    uint32_t output;
+    uint32_t pattern;
+} MatcherNode;
+
+/**
+ * @brief MyStringIndex is a suffix array of a text and its LCP array.
+ *        Holds a copy of the text, twice in a row for a cyclic index.
+ *        Holds the length of the text (once) and whether the index is cyclic.
+ *        Holds the start of every suffix of the text in sorted order (every rotation for a
+ *        cyclic index).
+ *        Holds the length of the common prefix of every suffix and the one before it (0 for
+ *        the first), at most the length of the text.
+ */
+struct _MyStringIndex
+{
+    char *text;
+    unsigned long length;
+    bool cyclic;
+    uint32_t *suffixes;
+    uint32_t *lcp;
+};
+
+/**
+ * @brief A node of the trie a MyStringMatcher is built from, with its children in a list sorted
+ *        by char.
+ */
+typedef struct TrieNode
+{
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    uint32_t pattern;
+    unsigned char c;
+} TrieNode;
+
+/**
+ * @brief MyStringMatcher is an Aho-Corasick automaton of its patterns.
+ *        Holds the transitions of the root for every char, dense since every scanned char is
+ *        looked up in it at least once (MATCHER_ROOT when the root has no edge).
+ *        Holds the nodes, and the chars and targets of their edges (sparse, in separate arrays
+ *        so a search only reads the chars).
+ *        Holds the next pattern ending at the node of every pattern and the length of every
+ *        pattern.
+ */
+struct _MyStringMatcher
+{
+    uint32_t rootEdges[UCHAR_MAX + 1];
+    MatcherNode *nodes;
+    unsigned long nodeCount;
+    unsigned char *edgeChars;
+    uint32_t *edgeTargets;
+    uint32_t *nextPattern;
+    unsigned long *patternLengths;
+    unsigned long patternCount;
+};
+
+/**
+ * @brief A single block of memory an arena hands out allocations from.
+ *        Holds a pointer to the next slab in the arena.
+ *        Holds an unsigned long representing the amount of usable bytes in data.
+ *        Holds the usable bytes themselves.
+ */
+typedef struct ArenaSlab
+{
+    struct ArenaSlab *next;
+    unsigned long size;
+    char data[];
+} ArenaSlab;
+
+/**
+ * @brief MyStringArena allocates MyStrings and their arrays by bumping a pointer in big slabs.
+ *        Holds a list of the slabs allocated so far, the one being allocated from first.
+ *        Holds the last slab of that list, so the list can be moved to the free slabs at once.
+ *        Holds a list of the slabs released by resets, which are used before new ones.
+ *        Holds an unsigned long representing the amount of bytes used in the first slab.
+ *        Holds an unsigned long representing the size of a regular slab.
+ */
+struct _MyStringArena
+{
+    ArenaSlab *slabs;
+    ArenaSlab *lastSlab;
+    ArenaSlab *freeSlabs;
+    unsigned long used;
+    unsigned long slabSize;
+};
+
+/**
+ * @brief Allocates memory from an arena. Memory is only released when the arena is reset
+ *        or destroyed. A request bigger than a slab gets a slab of its own. A new slab is taken
+ *        from the slabs released by the last resets when the first of them is big enough.
+ *        Time complexity is O(1) + whatever malloc is when a new slab is needed.
+ * @param arena the arena to allocate from.
+ * @param size the amount of bytes needed.
  * RETURN VALUE:
- *   @return a pointer to the new string, or NULL if the allocation failed.
+ * @return a pointer to the memory, or NULL if the allocation failed.
  */
-MyString * myStringClone(const MyString *str)
+static void *arenaAlloc(MyStringArena *arena, unsigned long size)
 {
-    // declare a MyString do be initialized later
-    MyString *newString = NULL;
-    unsigned long size = myStringLen(str);
-    // if the MyString we are cloning is an "empty" string, then use myStringAlloc to initialize
-    if (size == EMPTY)
+    size = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    if (arena -> slabs != NULL && arena -> used + size <= arena -> slabs -> size)
     {
-        newString = myStringAlloc();
-        if(newString == NULL)
-        {
-            return NULL;
-        }
+        void *memory = arena -> slabs -> data + arena -> used;
+        arena -> used += size;
+        return memory;
+    }
+    ArenaSlab *slab = arena -> freeSlabs;
+    if (slab != NULL && slab -> size >= size)
+    {
+        arena -> freeSlabs = slab -> next;
     }
-    // otherwise allocate a new MyString the size needed and use myStringSetFromMyString to clone
     else
     {
-        newString = buildMyString(myStringLen(str));
-        if (newString == NULL)
+        slab = malloc(sizeof(ArenaSlab) + MAX(size, arena -> slabSize));
+        if (slab == NULL)
         {
             return NULL;
         }
-        myStringSetFromMyString(newString, str);
-    }
-    return newString;
-}
-
-/**
- * @brief Sets the value of str to the value of other.
- *        Time complexity is O(n) where n is the length of other's string.
- * @param str the MyString to set
- * @param other the MyString to set from
- * RETURN VALUE:
- *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
- */
-MyStringRetVal myStringSetFromMyString(MyString *str, const MyString *other)
-{
-    // if either string is null then return an error
-    if(str == NULL || other == NULL)
-    {
-        return MYSTRING_ERROR;
+        slab -> size = MAX(size, arena -> slabSize);
     }
-    // get the length we want and update our string length
-    unsigned long StringLength = myStringLen(other);
-    str -> stringSize = StringLength;
-    // if the string we are setting from is empty, change the length match the actual space we want
-    if (StringLength == 0)
+    // an oversized request goes behind the current slab so we keep allocating from it
+    if (size > arena -> slabSize && arena -> slabs != NULL)
     {
-        StringLength = 16;
+        slab -> next = arena -> slabs -> next;
+        arena -> slabs -> next = slab;
     }
-    // if the length of str is smaller than the length of other then reallocate enough memory
-    if (reSizeStringArray(str, StringLength) == MYSTRING_ERROR)
+    else
     {
-        return MYSTRING_ERROR;
+        slab -> next = arena -> slabs;
+        arena -> slabs = slab;
+        arena -> used = size;
     }
-    if(myStringLen(other) == 0)
+    if (slab -> next == NULL)
     {
-        StringLength = 1;
+        arena -> lastSlab = slab;
     }
-    // use memcpy to copy the values from other to str
-    memcpy(str -> stringArray, other -> stringArray, StringLength);
-    // return success
-    return MYSTRING_SUCCESS;
+    return slab -> data;
 }
 
+#ifdef MYSTRING_STATS
+/*
+ * The counters behind myStringStatsSnapshot (see MyStringStats). They are only updated with
+ * relaxed atomics since nothing is ordered by them.
+ */
+static atomic_ulong statsAllocs;
+static atomic_ulong statsFrees;
+static atomic_ulong statsReallocs;
+static atomic_ulong statsBytesCopied;
+static atomic_ulong statsLiveBytes;
+static atomic_ulong statsFreedSlack;
+static atomic_ulong statsFreedLengths[MYSTRING_STATS_BUCKETS];
+
 /**
- * @brief gets the length of a MyString.
- * @param The MyString we wish to check.
- * @return the length of the string in str1.
+ * @brief Adds an amount to a counter. Time complexity is O(1).
  */
-unsigned long myStringLen(const MyString *str1)
+static void addStat(atomic_ulong *counter, unsigned long amount)
 {
-    if(str1 == NULL)
+    atomic_fetch_add_explicit(counter, amount, memory_order_relaxed);
+}
+
+/**
+ * @brief Counts a malloc of the memory of a string. Time complexity is O(1).
+ */
+static void countAlloc(unsigned long bytes)
+{
+    addStat(&statsAllocs, 1);
+    addStat(&statsLiveBytes, bytes);
+}
+
+/**
+ * @brief Counts a free of the memory of a string. Time complexity is O(1).
+ */
+static void countFree(unsigned long bytes)
+{
+    addStat(&statsFrees, 1);
+    atomic_fetch_sub_explicit(&statsLiveBytes, bytes, memory_order_relaxed);
+}
+
+/**
+ * @brief Counts a realloc of the memory of a string. Time complexity is O(1).
+ */
+static void countRealloc(unsigned long oldBytes, unsigned long newBytes)
+{
+    addStat(&statsReallocs, 1);
+    // adding the difference modulo 2^64 also takes away bytes when the memory shrinks
+    addStat(&statsLiveBytes, newBytes - oldBytes);
+}
+
+/**
+ * @brief Counts the length and unused capacity of a string that is freed.
+ *        Time complexity is O(1).
+ */
+static void countFreedString(const MyString *str)
+{
+    unsigned long length = str -> stringSize;
+    int bucket = 0;
+    if (length != EMPTY)
     {
-        return (unsigned long) MYSTR_ERROR_CODE;
+        bucket = (int) (sizeof(unsigned long) * CHAR_BIT) - __builtin_clzl(length);
     }
-    return str1 -> stringSize;
+    addStat(&statsFreedLengths[MIN(bucket, MYSTRING_STATS_BUCKETS - 1)], 1);
+    addStat(&statsFreedSlack, str -> realSize - length);
 }
+/*
+ * Hooks that count the memory of strings. Without MYSTRING_STATS they are empty, so they cost
+ * nothing.
+ */
+#define COUNT_ALLOC(bytes) countAlloc(bytes)
+#define COUNT_FREE(bytes) countFree(bytes)
+#define COUNT_REALLOC(oldBytes, newBytes) countRealloc(oldBytes, newBytes)
+#define COUNT_COPY(bytes) addStat(&statsBytesCopied, bytes)
+#define COUNT_FREED_STRING(str) countFreedString(str)
+#else
+#define COUNT_ALLOC(bytes)
+#define COUNT_FREE(bytes)
+#define COUNT_REALLOC(oldBytes, newBytes)
+#define COUNT_COPY(bytes)
+#define COUNT_FREED_STRING(str)
+#endif
 
+/**
+ * @brief Checks whether the string of a MyString is currently held in its inline buffer.
+ *        Time complexity is O(1).
+ * @param str the MyString to check.
+ * RETURN VALUE:
+ * @return true if stringArray points to the inline buffer, false if it is on the heap.
+ */
+static bool isShortString(const MyString *str)
+{
+    return str -> stringArray == str -> shortArray;
+}
 
 /**
- * @brief Sets the value of str to the value of the given C string.
- * 			The given C string must be terminated by the null character.
- * 			Checking will not use a string without the null character.
- *          Time complexity is O(n) where n is the length of cString. This is the cost of getting
- *          cString's length and the cost of memcpy from cString to str.
- * @param str the MyString to set.
- * @param cString the C string to set from.
+ * @brief Gets the header of an array allocated by allocSharedArray.
+ *        Time complexity is O(1).
+ * @param array the chars of the array.
  * RETURN VALUE:
- *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ * @return the header of the array.
  */
-MyStringRetVal myStringSetFromCString(MyString *str, const char * cString)
+static SharedArray *sharedArrayOf(const char *array)
 {
-    // find the length of cString and check whether the strings are null
-    if (str == NULL || cString == NULL)
-    {
-        return MYSTRING_ERROR;
-    }
-    // if no errors then proceed
-    else
-    {
-        unsigned long cStringLength = getCStringLength(cString);
-        // check whether cString is an empty string
-        if (cStringLength == EMPTY)
-        {
-            // create a temp struct using myStringAlloc() and copy it, then free the struct
-            MyString *tempStruct = myStringAlloc();
-            myStringSetFromMyString(str, tempStruct);
-            myStringFree(tempStruct);
-            tempStruct = NULL;
-        }
-        // resize the array as needed and copy the cString into it without null byte
-        else
-        {
-            if (reSizeStringArray(str, cStringLength) == MYSTRING_ERROR)
-            {
-                return MYSTRING_ERROR;
-            }
-            // use memcpy to copy cString to str
-            memcpy(str ->stringArray, cString, cStringLength);
-        }
-        // resize stringArray for str and return success
-        str -> stringSize = cStringLength;
-        return MYSTRING_SUCCESS;
-    }
+    return (SharedArray *) (array - offsetof(SharedArray, data));
 }
 
 /**
- * @brief Returns the value of str as a C string, terminated with the
- * 	null character. It is the caller's responsibility to free the returned
- * 	string by calling free().
- *  Time complexity is O(n) where n is the length of str + 1. This is the cost of memcpy from str
- *  to newCString.
- * @param str the MyString
+ * @brief Allocates a heap array for a MyString, used by a single MyString for now.
+ *        Time complexity is O(1) + whatever malloc is.
+ * @param capacity the amount of chars in the array.
  * RETURN VALUE:
- *  @return the new string, or NULL if the allocation failed.
+ * @return a pointer to the chars of the array, or NULL if the allocation failed.
  */
-char * myStringToCString(const MyString *str)
+static char *allocSharedArray(unsigned long capacity)
 {
-    if(str == NULL)
-    {
-        return NULL;
-    }
-    // set a long to be the size of str's string
-    unsigned long size = myStringLen(str);
-    // allocate new memory the size of that string + 1 for the null byte
-    char *newCString = malloc(size + 1);
-    // if the allocation failed, return null
-    if (newCString == NULL)
+    SharedArray *array = malloc(sizeof(SharedArray) + capacity);
+    if (array == NULL)
     {
         return NULL;
     }
-    // otherwise use memcpy to copy str to newCString and then add the nullbyte
-    memcpy(newCString, str -> stringArray, size);
-    *(newCString + size) = NULL_BYTE;
-    return newCString;
+    atomic_init(&array -> referenceCount, 1);
+#ifdef MYSTRING_STATS
+    array -> capacity = capacity;
+#endif
+    COUNT_ALLOC(sizeof(SharedArray) + capacity);
+    return array -> data;
 }
 
 /**
- * @brief Returns the value of str as an integer.
- * 	If str cannot be parsed as an integer,
- * 	the return value should be MYSTR_ERROR_CODE
- * 	NOTE: positive and negative integers should be supported.
- *  Time complexity is O(n) where n is the length of str. This is because we go over every char
- *  to calculate it's int value.
- * @param str the MyString
- * @return an integer
+ * @brief Stops using a heap array, the last MyString that uses it frees it.
+ *        Time complexity is O(1).
+ * @param array the chars of the array.
  */
-int myStringToInt(const MyString *str)
+static void releaseSharedArray(char *array)
 {
-    if(str == NULL || myStringLen(str) == EMPTY)
-    {
-        return MYSTR_ERROR_CODE;
-    }
-    // set our result to 0 and the sign to 1 to start and set a pointer to the array
-    int result = EMPTY;
-    int sign = POSITIVE;
-    char *toCheck = str -> stringArray;
-    // go over the array and check that it is a proper int, if it is negative change sign
-    for(unsigned long i = 0; i < myStringLen(str); i++)
+    SharedArray *header = sharedArrayOf(array);
+    if (atomic_fetch_sub_explicit(&header -> referenceCount, 1, memory_order_acq_rel) == 1)
     {
-        // if it is a number then add to our result
-        if (*(toCheck + i) <= NINE && *(toCheck + i) >= ZERO)
-        {
-            result = BASE * result + (*(toCheck + i) - CHAR_TO_INT);
-        }
-        // otherwise except when we are at the first index and it is a MINUS return an error
-        else
-        {
-            if (i == FIRST_INDEX && *toCheck == MINUS)
-            {
-                sign = NEGATIVE;
-            }
-            else
-            {
-                return MYSTR_ERROR_CODE;
-            }
-        }
+        COUNT_FREE(sizeof(SharedArray) + header -> capacity);
+        free(header);
     }
-    // return our result times the sign to make it positive or negative
-    return result * sign;
 }
 
 /**
- * @brief Sets the value of str to the value of the integer n.
- *        (i.e. if n=7 than str should contain ‘7’)
- *        You are not allowed to use itoa (or a similar functions) here but
- *        must code your own conversion function.
- *        Time complexity is O(n) where n is the amount of digits in the int. This is because
- *        the dominant action is going over the digits one by one after finding them.
- * @param str the MyString to set.
- * @param n the int to set from.
+ * @brief Checks whether the array of a MyString is shared with other MyStrings, in which case
+ *        it must be copied before it is changed.
+ *        Time complexity is O(1).
+ * @param str the MyString to check.
  * RETURN VALUE:
- *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ * @return true if the array is a heap array used by more than one MyString.
  */
-MyStringRetVal myStringSetFromInt(MyString *str, int n)
+static bool isSharedString(const MyString *str)
 {
-    // check that str is not null, if it is return an error
-    if (str == NULL)
-    {
-        return MYSTRING_ERROR;
-    }
-    // find the length of the int (including it's sign)
-    unsigned long stringLength = getLengthOfInt(n);
-    if (n <= SMALLER_THAN_ZERO)
-    {
-        stringLength ++;
-    }
-    // if our length was not enough, reallocate memory
-    reSizeStringArray(str, stringLength);
-    // update the struct's size
-    str -> stringSize = stringLength;
-    // initialize a pointer to our array
-    char *toCheck = str -> stringArray;
-    // if the sign is negative then set the first char to be '-', if not by digits and update
-    unsigned long i = FIRST_INDEX;
-    unsigned long digitCounter = stringLength;
-    if (n < 0)
-    {
-        *(toCheck) =  MINUS;
-        i++;
-        n *= NEGATIVE;
-        digitCounter--;
-    }
-    for (; i < stringLength; i++)
-    {
-        long divider = (n / pow(BASE, digitCounter - 1));
-        *(toCheck + i) =  floor(divider) + CHAR_TO_INT;
-        n -= (pow(BASE, digitCounter - 1) * divider);
-        digitCounter --;
-    }
-    return MYSTRING_SUCCESS;
+    return !isShortString(str) && str -> arena == NULL &&
+           atomic_load_explicit(&sharedArrayOf(str -> stringArray) -> referenceCount,
+                                memory_order_acquire) > 1;
 }
 
 /**
- * @brief filter the value of str acording to a filter.
- * 	remove from str all the occurrence of chars that are filtered by filt
- *	(i.e. filr(char)==true)
- *  Time complexity is O(n) where n is the length of str. This is the cost of memcpy of
- *  str in the case where nothing is filtered
- * @param str the MyString to filter
- * @param filt the filter
+ * @brief Allocates a new MyString and sets its value to "" (the empty string).
+ * 			It is the caller's responsibility to free the returned MyString.
+ *          If the requested memory fits in the inline buffer no second allocation is made.
+ *          Complexity is O(1) + whatever malloc is.
  * RETURN VALUE:
- *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure. */
-MyStringRetVal myStringFilter(MyString *str, bool (*filt)(const char *))
+ * @return a pointer to the new string, or NULL if the allocation failed.
+ */
+static MyString *buildMyString(unsigned long memory)
 {
-    // check for null string
-    if(str == NULL)
+    // creates a new pointer to a MyString struct the size of a MyString struct and inline buffer
+    MyString *stringPointer = malloc(sizeof(MyString) + SHORT_SIZE);
+    if (stringPointer == NULL)
     {
-        return MYSTRING_ERROR;
+        return NULL;
     }
-    // set amount found to 0 and allocate temporary array
-    long amountFound = EMPTY;
-    char *tempArray = malloc(myStringLen(str));
-    // go over original string
-    for (unsigned long i = 0; i < myStringLen(str); i++)
+    COUNT_ALLOC(sizeof(MyString) + SHORT_SIZE);
+    stringPointer -> shortSize = SHORT_SIZE;
+    // short strings live in the inline buffer, otherwise allocate enough memory for the array
+    if (memory <= SHORT_SIZE)
     {
-        // each time we find a filter match raise amount found
-        if (filt((str ->stringArray + i)) == true)
-        {
-            amountFound ++;
-        }
-        // each time we find they don't match then insert into temp array
-        else
+        stringPointer -> stringArray = stringPointer -> shortArray;
+        stringPointer -> realSize = SHORT_SIZE;
+    }
+    else
+    {
+        stringPointer -> stringArray = allocSharedArray(memory);
+        if (stringPointer -> stringArray == NULL)
         {
-            *(tempArray + i - amountFound) = *(str -> stringArray + i);
+            COUNT_FREE(sizeof(MyString) + SHORT_SIZE);
+            free(stringPointer);
+            return NULL;
         }
+        stringPointer -> realSize = memory;
     }
-    // Set our stringSize to change
-    str -> stringSize -= amountFound;
-    // copy the tempArray into stringArray
-    memcpy(str -> stringArray, tempArray, myStringLen(str));
-    free(tempArray);
-    tempArray = NULL;
-    return MYSTRING_SUCCESS;
+    // sets the string size to be the length of the string
+    stringPointer -> stringSize = memory;
+    stringPointer -> arena = NULL;
+    atomic_init(&stringPointer -> hash, NO_HASH);
+    return stringPointer;
 }
 
 /**
- * @brief Compare str1 and str2.
- * Time complexity is O(min(length str1, length str2)).
- * @param str1
- * @param str2
- * RETURN VALUE:
- * @return an integral value indicating the relationship between the strings:
- * 	A zero value indicates that the strings are equal.
- * 	A value greater than zero indicates that the first character that does not 
- *  match has a greater ASCII value in str1 than in str2;
- * 	And a value less than zero indicates the opposite.
- * 	If strings cannot be compared, the return value should be MYSTR_ERROR_CODE
+ * @brief Getter for the real size of a MyString
+ *        Time complexity is O(1).
+ * @param MyString we wish to get the real size of.
  */
-int myStringCompare(const MyString *str1, const MyString *str2)
+static unsigned long myStringRealSize(const MyString * str1)
 {
-    // returns a call to the custom compare with the default comparator we made
-    return myStringCustomCompare(str1, str2, defCompare);
+    return str1 -> realSize;
 }
 
 /**
- * @brief Compares str1 and str2.
- *        Time complexity is O(n) where n is min(length str1 , length str2) in worst case these are
- *        equal.
- * @param str1
- * @param str2
- * @param comparator
+ * @brief Moves the string of a MyString to a buffer of exactly the given capacity.
+ *        A capacity that fits in the inline buffer means it is used. The contents are
+ *        kept up to the new capacity. Strings that belong to an arena get their new array from
+ *        it and leave the old one behind. A shared heap array is copied and never changed.
+ *        Time complexity is O(1) + whatever realloc is, or O(k) when moving between the heap and
+ *        an inline buffer of size k, or O(n) when relocating an arena string of length n.
+ * @param str the MyString to move.
+ * @param capacity the capacity we want str to have.
  * RETURN VALUE:
- * @return an integral value indicating the relationship between the strings:
- * 	A zero value indicates that the strings are equal according to the custom comparator 
- *  (3rd parameter).
- * 	A value greater than zero indicates that the first MyString is bigger according to 
- *  the comparator. And a value less than zero indicates the opposite.
- * 	If strings cannot be compared, the return value should be MYSTR_ERROR_CODE
+ * @return MYSTRING_SUCCESS on success MYSTRING_ERROR on error (str is left unchanged)
  */
-int myStringCustomCompare(const MyString *str1, const MyString *str2,
-                          int (*foo)(const char *compareChar1, const char *compareChar2))
+static MyStringRetVal setCapacity(MyString *str, const unsigned long capacity)
 {
-    if(str1 == NULL || str2 == NULL)
+    if (capacity <= str -> shortSize)
     {
-        return MYSTR_ERROR_CODE;
+        // a heap string that fits in the inline buffer goes back into it
+        if (!isShortString(str))
+        {
+            memcpy(str -> shortArray, str -> stringArray,
+                   MIN(myStringRealSize(str), str -> shortSize));
+            COUNT_COPY(MIN(myStringRealSize(str), str -> shortSize));
+            if (str -> arena == NULL)
+            {
+                releaseSharedArray(str -> stringArray);
+            }
+            str -> stringArray = str -> shortArray;
+            str -> realSize = str -> shortSize;
+        }
+        return MYSTRING_SUCCESS;
     }
-    // save the sizes and find the minimum size
-    long size1 = myStringLen(str1);
-    long size2 = myStringLen(str2);
-    long minSize = MIN(size1, size2);
-    // check the equality up to that size
-    int result = checkEquality(minSize, str1, str2, foo);
-    // if already here we find an imbalance return it
-    if(result != SAME)
+    if (isShortString(str))
     {
-        return result;
+        // move the inline buffer to the heap (or the arena)
+        char *temp = (str -> arena == NULL) ? allocSharedArray(capacity) :
+                                              arenaAlloc(str -> arena, capacity);
+        if (temp == NULL)
+        {
+            return MYSTRING_ERROR;
+        }
+        memcpy(temp, str -> shortArray, str -> shortSize);
+        COUNT_COPY(str -> shortSize);
+        str -> stringArray = temp;
     }
-    // otherwise according to their sizes return proper int
-    else
+    else if (str -> arena != NULL)
     {
-        if(size1 == size2)
+        // relocate within the arena
+        char *temp = arenaAlloc(str -> arena, capacity);
+        if (temp == NULL)
         {
-            return SAME;
+            return MYSTRING_ERROR;
         }
-        else if(size1 > size2)
+        memcpy(temp, str -> stringArray, MIN(myStringRealSize(str), capacity));
+        COUNT_COPY(MIN(myStringRealSize(str), capacity));
+        str -> stringArray = temp;
+    }
+    else if (isSharedString(str))
+    {
+        // copy a shared array instead of changing it
+        char *temp = allocSharedArray(capacity);
+        if (temp == NULL)
         {
-            return BIGGER;
+            return MYSTRING_ERROR;
         }
-        else
+        memcpy(temp, str -> stringArray, MIN(myStringRealSize(str), capacity));
+        COUNT_COPY(MIN(myStringRealSize(str), capacity));
+        releaseSharedArray(str -> stringArray);
+        str -> stringArray = temp;
+    }
+    else
+    {
+        // set a temp pointer to stringArray and attempt to realloc it to the new size
+        SharedArray *temp = realloc(sharedArrayOf(str -> stringArray),
+                                    sizeof(SharedArray) + capacity);
+        // if it fails return an error (but we keep the pointer to stringArray)
+        if (temp == NULL)
         {
-            return SMALLER;
+            return MYSTRING_ERROR;
         }
+#ifdef MYSTRING_STATS
+        COUNT_REALLOC(sizeof(SharedArray) + temp -> capacity, sizeof(SharedArray) + capacity);
+        temp -> capacity = capacity;
+#endif
+        str -> stringArray = temp -> data;
     }
+    str -> realSize = capacity;
+    return MYSTRING_SUCCESS;
 }
 
-
 /**
- * @brief Check if str1 is equal to str2.
- *        Time complexity is O(n) where n is the length of str1 and and str2 in worst case.
- *        In best case it is O(1) because if the strings are not the same length they are for sure
- *        not equal.
- * @param str1
- * @param str2
- * @param comparator
+ * @brief Function that deals with the resizing of a stringArray.
+ *        Checks whether the string needs resizing (either it has too little room, or too much).
+ *        When it has too little room the capacity grows by MYSTRING_GROWTH_NUMERATOR /
+ *        MYSTRING_GROWTH_DENOMINATOR (or to newSize if that is bigger), so appending n bytes one
+ *        at a time only reallocates O(log n) times and costs amortized O(n).
+ *        It only counts as too much room once newSize is below 1 / MYSTRING_SHRINK_RATIO of the
+ *        capacity, and then the string shrinks to newSize grown by the growth factor. This
+ *        band keeps strings whose length goes back and forth from reallocating every time.
+ *        Sizes that fit in the inline buffer are kept in it. Arena strings never shrink
+ *        since the arena can not reuse the memory anyway.
+ *        Every function that changes the chars of a MyString calls this first, so a shared
+ *        array is always copied here (copy on write) even when the size does not change, and
+ *        the cached hash is dropped here.
+ *        Time complexity is that of setCapacity.
+ * @param MyString we wish to maybe resize.
+ * @param size we wish to maybe resize it to.
  * RETURN VALUE:
- * @return an integral value indicating the equality of the strings using a 
- *  custom comparator (3rd parameter):
- * 	A zero value indicates that the strings are not equal.
- * 	A greater than zero value indicates that the strings are equal.
- * 	If string cannot be compared, the return value should be MYSTR_ERROR_CODE
+ * @return MYSTRING_SUCCESS on success MYSTRING_ERROR on error
  */
-int myStringCustomEqual(const MyString *str1, const MyString *str2,
-                        int (*foo)(const char *char1, const char * char2))
+static MyStringRetVal reSizeStringArray(MyString *str, const unsigned long newSize)
 {
-    if(str1 == NULL || str2 == NULL)
+    atomic_store_explicit(&str -> hash, NO_HASH, memory_order_relaxed);
+    unsigned long capacity = myStringRealSize(str);
+    // too little room, grow geometrically
+    if (capacity < newSize)
     {
-        return MYSTR_ERROR_CODE;
+        unsigned long grownSize = capacity / MYSTRING_GROWTH_DENOMINATOR * MYSTRING_GROWTH_NUMERATOR;
+        return setCapacity(str, MAX(newSize, grownSize));
     }
-    // save their sizes. If the sizes don't match they are definitely not equal
-    long size1 = myStringLen(str1);
-    long size2 = myStringLen(str2);
-    if(size1 != size2)
+    // too much room, shrink but leave room to grow again
+    if (!isShortString(str) && str -> arena == NULL && newSize < capacity / MYSTRING_SHRINK_RATIO)
     {
-        return UNEQUAL;
+        unsigned long shrunkSize = newSize / MYSTRING_GROWTH_DENOMINATOR * MYSTRING_GROWTH_NUMERATOR;
+        return setCapacity(str, MAX(newSize, shrunkSize));
     }
-    // otherwise use checkEquality to get whether they are equal according to foo
-    else
+    // the size is fine, but we are about to change an array other strings are using
+    if (isSharedString(str))
     {
-        int result = checkEquality(size1, str1, str2, foo);
-        if(result == SAME)
-        {
-            return EQUAL;
-        }
-        else
-        {
-            return UNEQUAL;
-        }
+        return setCapacity(str, capacity);
     }
+    return MYSTRING_SUCCESS;
 }
 
-
 /**
- * @brief Check if str1 is equal to str2.
- *        Time complexity is that of myStringCustomEqual which is O(n) in worst case and O(1) in
- *        best. Where n is the length of str1 and str2,
- * @param str1
- * @param str2
+ * @brief finds the length of a c string.
+ * @param pointer to a cString.
  * RETURN VALUE:
- * @return an integral value indicating the equality of the strings 
- *         (logical equality - that they are composed of the very same characters):
- * 	A zero value indicates that the strings are not equal.
- * 	A greater than zero value indicates that the strings are equal.
- * 	If strings cannot be compared, the return value should be MYSTR_ERROR_CODE
+ * @return length of cString
  */
-int myStringEqual(const MyString *str1, const MyString *str2)
+static unsigned long getCStringLength(const char *cString)
 {
-    // uses myStringCustomEqual with a default comparator to decide whether they are equal
-    return myStringCustomEqual(str1, str2, logicalEqual);
+    unsigned long i = EMPTY;
+    // iterate over the c string until we reach the null byte at the end
+    while (*(cString + i) != NULL_BYTE)
+    {
+        i++;
+    }
+    return i;
 }
 
+static MyStringRetVal writeBuffers(int fd, struct iovec *buffers, int count);
+static unsigned long formatInt(int n, char *toCheck);
+
 /**
- * @brief Getter for the total amount of memory used by a MyString.
- *        Time complexity is O(1)
- * @param the Mystring we wish to check.
- * @return the amount of memory (all the memory that used by the MyString 
- *         object itself and its allocations), in bytes, allocated to str1.
+ * @brief The decimal digits of 0 to 99, two chars for each, so integers are written a pair of
+ *        digits at a time.
  */
-unsigned long myStringMemUsage(const MyString *str1)
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/**
+ * @brief The powers of 10 that fit in 64 bits, 10^i at index i.
+ */
+static const uint64_t POWERS_OF_10[] =
 {
-    if(str1 == NULL)
-    {
-        return (unsigned long) MYSTR_ERROR_CODE;
-    }
-    return sizeof(str1 -> stringSize) + sizeof(str1 -> realSize) +
-    sizeof(str1 ->stringArray) + myStringRealSize(str1);
-}
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
 
 /**
- * @brief Writes the content of str to stream. (like fputs())
- *        Time complexity is that of myStringToCString which is O(n) where n is length of str.
- * @param MyString we wish to write to file.
- * @param open file stream.
- * RETURNS:
- *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ * @brief The powers of 10 that are exact doubles, 10^i at index i.
  */
-MyStringRetVal myStringWrite(const MyString *str, FILE *stream)
+static const double EXACT_POWERS_OF_10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+    1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * @brief Finds the amount of decimal digits of a number.
+ *        The bit length of n gives floor(log10(2^bits)) with a multiplication (1233 / 4096 is
+ *        just above log10(2)), which is the amount of digits or one less, and a single compare
+ *        with a power of 10 tells which.
+ *        Time complexity is O(1).
+ * @param n the number.
+ * RETURN VALUE:
+ * @return the amount of digits of n, 1 for 0.
+ */
+static unsigned long countDigits(uint64_t n)
 {
-    // allocate a new c string from the MyString
-    char *newCString = myStringToCString(str);
-    // if it isn't NULL and we are able to write it in then continue
-    if (newCString == NULL || fputs(newCString, stream) == EOF)
+#if defined(__GNUC__)
+    unsigned long bits = 64 - __builtin_clzll(n | 1);
+#else
+    unsigned long bits = 1;
+    while (bits < 64 && (n >> bits) != 0)
     {
-        return MYSTRING_ERROR;
+        bits++;
     }
-    // flush it to the stream so we can read it right away if needed
-    fflush(stream);
-    // free the string we allocated and set it the pointer to it to NULL
-    free(newCString);
-    newCString = NULL;
-    return MYSTRING_SUCCESS;
+#endif
+    // 0 is counted like 1, which has the same amount of digits
+    unsigned long digits = (bits * 1233) >> 12;
+    return digits + 1 - ((n | 1) < POWERS_OF_10[digits]);
 }
 
 /**
- * @brief Sets result to be the concatenation of str1 and str2.
- * 	result should be initially allocated by the caller.
- * 	result shouldn't be the same struct as str1 or str2.
- *  Time complexity is O(m + k) where m is the length of str1 and k is the length of str2.
- * @param str1
- * @param str2
- * @param result
+ * @brief Writes the decimal representation of an unsigned number to a buffer (without a null
+ *        byte), from its end two digits at a time.
+ *        Time complexity is O(d) where d is the amount of digits, with d / 2 divisions.
+ * @param n the number to write.
+ * @param buffer buffer of at least INT64_STRING_SIZE chars.
  * RETURN VALUE:
- *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ * @return the amount of chars written.
  */
-MyStringRetVal myStringCatTo(const MyString *str1, const MyString *str2, MyString *result)
+static unsigned long formatUInt64(uint64_t n, char *buffer)
 {
-    // check whether any struct is null
-    if (str1 == NULL || str2 == NULL || result == NULL)
+    unsigned long length = countDigits(n);
+    char *end = buffer + length;
+    while (n >= 100)
     {
-        return MYSTRING_ERROR;
+        unsigned long pair = (unsigned long) (n % 100) * 2;
+        n /= 100;
+        end -= 2;
+        memcpy(end, DIGIT_PAIRS + pair, 2);
     }
-    // check that result is not equal to str1 or str2
-    if(result == str1 || result == str2)
+    if (n >= 10)
     {
-        return MYSTRING_ERROR;
+        memcpy(end - 2, DIGIT_PAIRS + n * 2, 2);
     }
-    // save the total size needed for result, and reallocate as needed
-    unsigned long totalSize = myStringLen(str1) + myStringLen(str2);
-    if(reSizeStringArray(result, totalSize) == MYSTRING_ERROR)
+    else
     {
-        return MYSTRING_ERROR;
+        *(end - 1) = (char) (ZERO + n);
     }
-    result -> stringSize = totalSize;
-    // copy str1 and str2 into the proper spots in result
-    memcpy(result -> stringArray, str1 -> stringArray, myStringLen(str1));
-    memcpy(result -> stringArray + myStringLen(str1), str2 -> stringArray, myStringLen(str2));
-    return MYSTRING_SUCCESS;
+    return length;
 }
 
 /**
- * @brief Appends a copy of the source MyString src to the destination MyString dst.
- *        Time complexity is O(m + k) where m is the length of dest and k is the length of src.
- * @param dest the destination
- * @param src the MyString to append
+ * @brief Writes the decimal representation of a signed number to a buffer (without a null
+ *        byte). The magnitude is taken as unsigned, so the most negative number works too.
+ *        Time complexity is O(d) where d is the amount of digits.
+ * @param n the number to write.
+ * @param buffer buffer of at least INT64_STRING_SIZE chars.
  * RETURN VALUE:
- *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ * @return the amount of chars written.
  */
-MyStringRetVal myStringCat(MyString * dest, const MyString * src)
+static unsigned long formatInt64(int64_t n, char *buffer)
 {
-    // allocate a new empty struct
-    MyString *tempStruct = myStringAlloc();
-    // copy dest and src to temp_struct using myStringCatTo
-    if (myStringCatTo(dest, src, tempStruct) == MYSTRING_ERROR)
+    if (n < 0)
     {
-        return MYSTRING_ERROR;
+        *buffer = MINUS;
+        return 1 + formatUInt64(0 - (uint64_t) n, buffer + 1);
     }
-    // set our dest to be what we got in tempStruct and free temptStruct
-    myStringSetFromMyString(dest, tempStruct);
-    myStringFree(tempStruct);
-    return MYSTRING_SUCCESS;
+    return formatUInt64((uint64_t) n, buffer);
 }
 
-
 /**
- * @brief sort an array of MyString pointers
- *        In this sort we use qSort to sort an array of MyString pointers using a comparator.
- *        However the comparator itself also uses a comparator to compare between individual chars
- *        in each MyString. Therefore the time complexity of this function is O(n*log(n)*k) where
- *        n is the length of our MyString pointer array and k is (in the worst case where all the
- *        MyString lengths are equal) the length of each MyString. This is an average run time
- *        due to the implementation of quicksort. In worst case it is O(n^2 * k), but we learned in
- *        data structures that this is unlikely.
- * @param arr
- * @param len
- * @param comparator custom comparator
- *
- * RETURN VALUE:none
+ * @brief default comparator that compares two chars with a logical comparison.
+ *        Time complexity is O(1).
+ * @param char1 first char to compare
+ * @param char2 second char to compare
+ * RETURN VALUE:
+ * @return MYSTR_ERROR_CODE if cannot compare, 0 if equal, 1 if char1 is bigger, -1 if char2 is.
  */
-void myStringCustomSort(MyString **arr, int len, int (*foo)(const void* str1, const void* str2))
+static int defCompare(const char *char1, const char *char2)
 {
-    // use the standard qsort function to sort based on the comparator received
-    qsort(arr, len, sizeof(MyString *), foo);
+    if(char1 == NULL || char2 == NULL)
+    {
+        return MYSTR_ERROR_CODE ;
+    }
+    if(*char1 == *char2)
+    {
+        return SAME;
+    }
+    
+    else if(*char1 > *char2)
+    {
+        return BIGGER;
+    }
+    else
+    {
+        return SMALLER;
+    }
 }
 
 /**
- * @brief sorts an array of MyString pointers according to the default 
- *        comparison (like in myStringCompare).
- *        We will sort using myStringCustomSort and using a casting function as a comparator which
- *        will deal with qsort only accepting void pointers in a comparator.
- *        Time complexity is that of myStringCustomSort.
- * @param arr
- * @param len
- *
- * RETURN VALUE: none
+ * @brief Equality checker compares two chars.
+ *        Time complexity is O(n) where n is size entered.
+ * @param Size we want to compare up till
+ * @param MyString to check
+ * @param second MyString to check
+ * @param comparator function
+ * RETURN VALUE:
+ * @return 0 if equal, -1 or 1 otherwise
  */
-void myStringSort(MyString **arr, int len)
+static int checkEquality(const unsigned long size, const MyString *str1, const MyString *str2,
+                         int (*foo)(const char *compareChar1, const char *compareChar2))
 {
-    // call our custom sort function with the casting helper function as a comparator
-    myStringCustomSort(arr, len, compareCaster);
+    // go over the strings character by character
+    for(unsigned long i = 0; i < size; i++)
+    {
+        char *char1 = (str1 -> stringArray + i);
+        char *char2 = (str2 -> stringArray + i);
+        //save the result we receive from our comparator
+        int tempResult = foo(char1, char2);
+        // if they don't match stop and return the result
+        if (tempResult != SAME)
+        {
+            return tempResult;
+        }
+    }
+    return SAME;
 }
 
-
-
-#ifndef NDEBUG
-static void printImproperError(const char *func, const int line)
+/**
+ * @brief Reads 8 chars as a number (in the machine's byte order).
+ */
+static uint64_t read64(const char *chars)
 {
-    printf("Error returned improperly in %s at line %d.\n", func, line);
-    printf("Expected: MYSTRING_SUCCESS");
-    printf("Actual: MYSTRING_ERROR");
+    uint64_t value;
+    memcpy(&value, chars, sizeof(value));
+    return value;
 }
-static void printComparisonHelper(const char *str, const char* func,
-                                  const int expected, const int actual)
+
+/**
+ * @brief Reads 4 chars as a number (in the machine's byte order).
+ */
+static uint64_t read32(const char *chars)
 {
-    printf("Wrong value for %s between two equal MyStrings in %s.\n", str, func );
-    printf("Expected: %d\n", expected);
-    printf("Actual: %d\n", actual);
+    uint32_t value;
+    memcpy(&value, chars, sizeof(value));
+    return value;
 }
 
-static void printCalculatorHelper(const char* str, const char* func,
-                                  const unsigned long expected, const unsigned long actual)
+static int logicalEqual(const char *char1, const char *char2);
+
+/**
+ * @brief Folds an ASCII upper case letter to lower case, other chars are left as they are.
+ *        Time complexity is O(1).
+ */
+static char foldCase(char c)
 {
-    printf("%s was not calculated properly in %s.\n", str, func);
-    printf("Expected: %lu\n", expected);
-    printf("Actual: %lu\n", actual);
+    if (c >= UPPER_A && c <= UPPER_Z)
+    {
+        return (char) (c + CASE_DIFFERENCE);
+    }
+    return c;
 }
+
 /**
- * @brief Tester for myStringAlloc()
- *
- * RETURN VALUE: none
+ * Complexity is O(1).
  */
-static void testMyStringAlloc()
+int myStringCharCaseCompare(const char *char1, const char *char2)
 {
-    printf("Start test for myStringAlloc\n");
-    MyString *testString = myStringAlloc();
-    // tests the length of an "empty" struct
-    if(testString -> stringSize != EMPTY)
+    if(char1 == NULL || char2 == NULL)
     {
-        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, testString -> stringSize);
+        return MYSTR_ERROR_CODE;
     }
-    // tests the size of an empty "struct"
-    if(testString -> realSize != 16)
+    char folded1 = foldCase(*char1);
+    char folded2 = foldCase(*char2);
+    return defCompare(&folded1, &folded2);
+}
+
+/**
+ * @brief Finds the first mismatch between two arrays of chars, a word of 8 chars at a time.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the index of the first mismatch, or length if the arrays are equal.
+ */
+static unsigned long mismatchScalar(const char *chars1, const char *chars2, unsigned long length)
+{
+    unsigned long i = 0;
+    while (i + sizeof(uint64_t) <= length && read64(chars1 + i) == read64(chars2 + i))
     {
-        printCalculatorHelper(STRING_SIZE, __func__, START_SIZE, testString -> realSize);
+        i += sizeof(uint64_t);
     }
-    char testChar = testString -> stringArray[0];
-    // tests for NULL_BYTE in first index of empty struct
-    if (testChar != NULL_BYTE)
+    while (i < length && chars1[i] == chars2[i])
     {
-        printf("Null byte not added to empty MyString in myStringAlloc.");
-        printf("Expected: %c\n", NULL_BYTE);
-        printf("Actual: %c\n", testChar);
+        i++;
     }
-    myStringFree(testString);
-    printf("End test for myStringAlloc\n");
+    return i;
 }
 
 /**
- * @brief Tester for myStringLen()
- *
- * RETURN VALUE: none
+ * @brief Finds the first mismatch between two arrays of chars with letters folded to lower case.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the index of the first mismatch, or length if the arrays are equal.
  */
-static void testMyStringLen()
+static unsigned long caseMismatchScalar(const char *chars1, const char *chars2,
+                                        unsigned long length)
 {
-    printf("Start test for myStringLen\n");
-    MyString *testStruct = myStringAlloc();
-    // checks that length is returned properly for empty struct
-    if(myStringLen(testStruct) != 0)
+    unsigned long i = 0;
+    while (i < length && foldCase(chars1[i]) == foldCase(chars2[i]))
     {
-        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, testStruct -> stringSize);
+        i++;
     }
-    myStringFree(testStruct);
-    printf("End test for myStringLen\n");
+    return i;
 }
 
+#ifdef __SSE2__
 /**
- * @brief Tester for myStringClone()
- *
- * RETURN VALUE: none
+ * @brief Finds the first mismatch between two arrays of chars, 16 chars at a time with SSE2.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the index of the first mismatch, or length if the arrays are equal.
  */
-static void testMyStringClone()
+static unsigned long mismatchSse2(const char *chars1, const char *chars2, unsigned long length)
 {
-    printf("Start test for myStringClone\n");
-    MyString *testString1 = myStringAlloc();
-    MyString *testString2 = myStringClone(testString1);
-    // checks length of cloned struct
-    if(myStringLen(testString2) != EMPTY)
+    unsigned long i = 0;
+    for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i))
     {
-        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, myStringLen(testString2));
-
+        __m128i block1 = _mm_loadu_si128((const __m128i *) (chars1 + i));
+        __m128i block2 = _mm_loadu_si128((const __m128i *) (chars2 + i));
+        unsigned int equal = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2));
+        if (equal != 0xFFFF)
+        {
+            return i + __builtin_ctz(~equal);
+        }
     }
-    // checks length of cloned struct
-    if(myStringLen(testString2) != myStringLen(testString1))
+    return i + mismatchScalar(chars1 + i, chars2 + i, length - i);
+}
+
+/**
+ * @brief Folds the ASCII upper case letters of 16 chars to lower case.
+ */
+static __m128i foldCaseSse2(__m128i chars)
+{
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(UPPER_A - 1)),
+                                  _mm_cmplt_epi8(chars, _mm_set1_epi8(UPPER_Z + 1)));
+    return _mm_add_epi8(chars, _mm_and_si128(upper, _mm_set1_epi8(CASE_DIFFERENCE)));
+}
+
+/**
+ * @brief Finds the first mismatch between two arrays of chars with letters folded to lower case,
+ *        16 chars at a time with SSE2.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the index of the first mismatch, or length if the arrays are equal.
+ */
+static unsigned long caseMismatchSse2(const char *chars1, const char *chars2,
+                                      unsigned long length)
+{
+    unsigned long i = 0;
+    for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i))
     {
-        printCalculatorHelper(STRING_LENGTH, __func__,
-                              myStringLen(testString1), myStringLen(testString2));
+        __m128i block1 = foldCaseSse2(_mm_loadu_si128((const __m128i *) (chars1 + i)));
+        __m128i block2 = foldCaseSse2(_mm_loadu_si128((const __m128i *) (chars2 + i)));
+        unsigned int equal = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2));
+        if (equal != 0xFFFF)
+        {
+            return i + __builtin_ctz(~equal);
+        }
     }
-    char testChar = testString2 -> stringArray[0];
-    // checks struct was cloned properly
-    if (testChar != NULL_BYTE)
+    return i + caseMismatchScalar(chars1 + i, chars2 + i, length - i);
+}
+#endif
+
+#ifdef MYSTRING_X86
+/**
+ * @brief Finds the first mismatch between two arrays of chars, 32 chars at a time with AVX2.
+ *        Only called after checking the CPU supports AVX2.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the index of the first mismatch, or length if the arrays are equal.
+ */
+__attribute__((target("avx2")))
+static unsigned long mismatchAvx2(const char *chars1, const char *chars2, unsigned long length)
+{
+    unsigned long i = 0;
+    for (; i + sizeof(__m256i) <= length; i += sizeof(__m256i))
     {
-        printf("Null byte not added to empty MyString in myStringClone.\n");
-        printf("Expected: %c\n", NULL_BYTE);
-        printf("Actual: %c\n", testChar);
+        __m256i block1 = _mm256_loadu_si256((const __m256i *) (chars1 + i));
+        __m256i block2 = _mm256_loadu_si256((const __m256i *) (chars2 + i));
+        unsigned int equal = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block1,
+                                                                                  block2));
+        if (equal != 0xFFFFFFFF)
+        {
+            return i + __builtin_ctz(~equal);
+        }
     }
-    myStringFree(testString1);
-    myStringFree(testString2);
-    printf("End test for myStringClone\n");
+    return i + mismatchScalar(chars1 + i, chars2 + i, length - i);
 }
 
 /**
- * @brief Tester for myStringSetFromMyString()
- *
- * RETURN VALUE: none
+ * @brief Folds the ASCII upper case letters of 32 chars to lower case.
  */
-static void testMyStringSetFromMyString()
+__attribute__((target("avx2")))
+static __m256i foldCaseAvx2(__m256i chars)
 {
-    printf("Start test for myStringSetFromMyString\n");
-    MyString *startStruct = myStringAlloc();
-    char *startString = "Testing this nown";
-    myStringSetFromCString(startStruct, startString);
-    MyString *destStruct = myStringAlloc();
-    // checks setting struct from other struct doesn't return an error
-    if(myStringSetFromMyString(destStruct, startStruct) == MYSTRING_ERROR)
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8(UPPER_A - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8(UPPER_Z + 1), chars));
+    return _mm256_add_epi8(chars, _mm256_and_si256(upper, _mm256_set1_epi8(CASE_DIFFERENCE)));
+}
+
+/**
+ * @brief Finds the first mismatch between two arrays of chars with letters folded to lower case,
+ *        32 chars at a time with AVX2. Only called after checking the CPU supports AVX2.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the index of the first mismatch, or length if the arrays are equal.
+ */
+__attribute__((target("avx2")))
+static unsigned long caseMismatchAvx2(const char *chars1, const char *chars2,
+                                      unsigned long length)
+{
+    unsigned long i = 0;
+    for (; i + sizeof(__m256i) <= length; i += sizeof(__m256i))
     {
-        printImproperError(__func__, __LINE__);
+        __m256i block1 = foldCaseAvx2(_mm256_loadu_si256((const __m256i *) (chars1 + i)));
+        __m256i block2 = foldCaseAvx2(_mm256_loadu_si256((const __m256i *) (chars2 + i)));
+        unsigned int equal = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block1,
+                                                                                  block2));
+        if (equal != 0xFFFFFFFF)
+        {
+            return i + __builtin_ctz(~equal);
+        }
     }
-    // checks length of copied struct
-    if(myStringLen(destStruct) != 17)
+    return i + caseMismatchScalar(chars1 + i, chars2 + i, length - i);
+}
+#endif
+
+/**
+ * @brief Lists the compare kernels this machine can run, from the slowest to the fastest.
+ *        Time complexity is O(1).
+ * @param kernels array of at least 3 kernels to fill.
+ * RETURN VALUE:
+ * @return the amount of kernels listed.
+ */
+static int listCompareKernels(CompareKernels *kernels)
+{
+    int count = 0;
+    kernels[count++] = (CompareKernels) {mismatchScalar, caseMismatchScalar};
+#ifdef __SSE2__
+    kernels[count++] = (CompareKernels) {mismatchSse2, caseMismatchSse2};
+#endif
+#ifdef MYSTRING_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
     {
-        printCalculatorHelper(STRING_LENGTH, __func__, 17, myStringLen(destStruct));
+        kernels[count++] = (CompareKernels) {mismatchAvx2, caseMismatchAvx2};
     }
-    // checks size of copied struct
-    if(destStruct -> realSize != 17)
-    {
-        printCalculatorHelper(STRING_SIZE, __func__, 17, myStringRealSize(destStruct));
+#endif
+    return count;
+}
+
+/*
+ * The fastest compare kernels of this machine, chosen once by getCompareKernels
+ */
+static CompareKernels compareKernels;
+static pthread_once_t compareKernelsOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Sets compareKernels to the fastest kernels this machine can run.
+ */
+static void selectCompareKernels()
+{
+    CompareKernels kernels[3];
+    compareKernels = kernels[listCompareKernels(kernels) - 1];
+}
+
+/**
+ * @brief Gets the fastest compare kernels of this machine, checking the CPU on the first call.
+ *        Time complexity is O(1).
+ */
+static const CompareKernels * getCompareKernels()
+{
+    pthread_once(&compareKernelsOnce, selectCompareKernels);
+    return &compareKernels;
+}
 
+/**
+ * @brief Finds the first index where two char arrays differ.
+ *        Time complexity is O(n) where n is size.
+ * RETURN VALUE:
+ * @return the index of the first mismatch, or size if there is none.
+ */
+static unsigned long findCharsMismatch(const char *chars1, const char *chars2, unsigned long size)
+{
+    // most strings differ early (like neighbours while sorting), so check a few chars
+    // before paying for the call to the kernel
+    unsigned long prologue = MIN(size, MISMATCH_PROLOGUE);
+    unsigned long i = 0;
+    while (i < prologue && chars1[i] == chars2[i])
+    {
+        i++;
     }
-    char testChar = destStruct-> stringArray[START_SIZE];
-    // checks struct was copied properly
-    if (testChar != 'n')
+    if (i < prologue)
     {
-        printf("Improper character in destStruct in myStringSetFromMyString.\n");
-        printf("Expected: %c\n", 'n');
-        printf("Actual: %c\n", testChar);
+        return i;
     }
-    myStringFree(startStruct);
-    myStringFree(destStruct);
-    printf("End test for myStringSetFromMyString\n");
+    return i + getCompareKernels() -> mismatch(chars1 + i, chars2 + i, size - i);
 }
 
 /**
- * @brief Tester for myStringSetFromCString()
- *
- * RETURN VALUE: none
+ * @brief Finds the first mismatch between the first size chars of two strings according to
+ *        a comparator, with a compare kernel when the comparator is one of the library's.
+ *        Time complexity is O(n) where n is size.
+ * @param size the amount of chars to compare.
+ * @param str1 first MyString.
+ * @param str2 second MyString.
+ * @param foo the comparator.
+ * @param index set to the index of the first mismatch, or size if there is none.
+ * RETURN VALUE:
+ * @return true if a kernel was used, false if foo has to be called for every char.
  */
-static void testMyStringSetFromCString()
+static bool findMismatch(const unsigned long size, const MyString *str1, const MyString *str2,
+                         int (*foo)(const char *compareChar1, const char *compareChar2),
+                         unsigned long *index)
 {
-    printf("Start test for MyStringSetFromCString\n");
-    char *testCString = "Testing this now";
-    MyString *testStruct = myStringAlloc();
-    // checks that setting a MyString from c string doesn't return an error
-    if(myStringSetFromCString(testStruct, testCString) == MYSTRING_ERROR)
-    {
-        printImproperError(__func__, __LINE__);
-    }
-    // checks that length of setting a MyString from c string is correct
-    if(myStringLen(testStruct) != START_SIZE)
-    {
-        printCalculatorHelper(STRING_LENGTH, __func__, START_SIZE, myStringLen(testStruct));
-    }
-    // checks that size of setting a MyString from c string is correct
-    if(testStruct -> realSize != START_SIZE)
-    {
-        printCalculatorHelper(STRING_SIZE, __func__, START_SIZE, myStringRealSize(testStruct));
-    }
-    char testChar = testStruct-> stringArray[FIRST_INDEX];
-    // check that MyString was set properly
-    if (testChar != 'T')
+    if (foo == defCompare || foo == logicalEqual)
     {
-        printf("Improper character in test_struct in myStringSetFromCString.\n");
-        printf("Expected: %c\n", 'T');
-        printf("Actual: %c\n", testChar);
+        *index = findCharsMismatch(str1 -> stringArray, str2 -> stringArray, size);
+        return true;
     }
-    char *testEmptyCString = "";
-    // check edge case of copying empty string
-    if(myStringSetFromCString(testStruct, testEmptyCString) == MYSTRING_ERROR)
+    if (foo == myStringCharCaseCompare)
     {
-        printImproperError(__func__, __LINE__);
+        *index = getCompareKernels() -> caseMismatch(str1 -> stringArray, str2 -> stringArray,
+                                                     size);
+        return true;
     }
-    if(myStringLen(testStruct) != EMPTY)
+    return false;
+}
+
+/**
+ * @brief casts the const void* it receives to be pointers to pointers to MyString and then
+ *        returns our myStringCompare function with those two pointers to MyStrings.
+ *        Time complexity is O(n) where n is the length of the shorter MyString.
+ */
+int myStringDefaultCompare(const void* str1, const void* str2)
+{
+    // cast str1 and str2 to be two pointers to pointers to MyString and return our compare with it
+    MyString** newStr1 = (MyString**) str1;
+    MyString** newStr2 = (MyString**) str2;
+    return myStringCompare(*newStr1, *newStr2);
+}
+
+/**
+ * @brief default equality checker compares two chars with a logical comparison.
+ *        Time complexity is O(1).
+ * @param char1 first char to compare
+ * @param char2 second char to compare
+ * RETURN VALUE:
+ * @return 0 if equal, 1 otherwise
+ */
+static int logicalEqual(const char *char1, const char *char2)
+{
+    if (*char1 == *char2)
     {
-        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, myStringLen(testStruct));
+        return 0;
     }
-    if(testStruct -> realSize != START_SIZE)
+    return 1;
+}
+
+
+/**
+ * Complexity is O(1). Because buildMyString is O(1) and the other actions are also O(1).
+ * The empty string is held in the inline buffer so only the struct itself is allocated.
+ */
+MyString * myStringAlloc()
+{
+    // allocate a new myString of size 16 because we would like to save cost of reallocating later
+    MyString *newString = buildMyString(START_SIZE);
+    if (newString == NULL)
     {
-        printCalculatorHelper(STRING_SIZE, __func__, START_SIZE, myStringRealSize(testStruct));
+        return NULL;
     }
-    char testChar2 = testStruct-> stringArray[FIRST_INDEX];
-    if (testChar2 != NULL_BYTE)
+    memset(newString -> stringArray, EMPTY, START_SIZE);
+    // set the first (and only) index to be a null byte, and it's string size to be 0
+    newString -> stringArray[FIRST_INDEX] = NULL_BYTE;
+    newString -> stringSize = EMPTY;
+    return newString;
+}
+
+/**
+ * @brief Allocates a new MyString whose inline buffer holds capacity chars, so the struct and
+ *        its chars are a single block. It is the caller's responsibility to free it.
+ *        Time complexity is O(1) + whatever malloc is.
+ * @param capacity the length the string can reach before leaving its inline buffer.
+ * RETURN VALUE:
+ * @return a pointer to the new string, or NULL if the allocation failed.
+ */
+MyString * myStringAllocPacked(unsigned long capacity)
+{
+    capacity = MAX(capacity, SHORT_SIZE);
+    MyString *newString = malloc(sizeof(MyString) + capacity);
+    if (newString == NULL)
     {
-        printf("Improper null byte for empty string in myStringSetFromCString.\n");
-        printf("Expected: %c\n", NULL_BYTE);
-        printf("Actual: %c\n", testChar);
+        return NULL;
     }
-    myStringFree(testStruct);
-    printf("End test for MyStringSetFromCString\n");
+    COUNT_ALLOC(sizeof(MyString) + capacity);
+    newString -> stringArray = newString -> shortArray;
+    newString -> stringSize = EMPTY;
+    newString -> realSize = capacity;
+    newString -> arena = NULL;
+    newString -> shortSize = capacity;
+    atomic_init(&newString -> hash, NO_HASH);
+    newString -> stringArray[FIRST_INDEX] = NULL_BYTE;
+    return newString;
 }
 
 /**
- * @brief Tester for myStringFree()
- *
- * RETURN VALUE: none
+ * @brief Grows a heap MyString whose string is in its inline buffer by reallocating the whole
+ *        block, so the string stays next to the struct. The MyString may move.
+ *        Time complexity is O(1) + whatever realloc is.
+ * @param str pointer to the MyString to grow, set to its new address.
+ * @param capacity the capacity str should have, bigger than its current one.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success MYSTRING_ERROR on error (str is left unchanged)
  */
-static void testMyStringFree()
+static MyStringRetVal growPacked(MyString **str, unsigned long capacity)
 {
-    printf("Start test for myStringFree\n");
-    /*
-     There is no reliable way to tell if a pointer has been freed. The freed memory could be 
-     occupied by other irrelevant data and you'll get wrong result.
-     And indeed there is no standard way to check if a pointer is freed. 
-     That said, glibc does have functions (mcheck, mprobe) to find the malloc status of a pointer 
-     for heap consistency checking, and one of them is to see if a pointer is freed.
-     However, these functions are mainly used for debugging only, and they are not thread-safe. 
-     So I just made sure I have paired malloc/free and used valgrind to double check.
-     */
-    printf("End test for myStringFree\n");
+    MyString *grown = realloc(*str, sizeof(MyString) + capacity);
+    if (grown == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    COUNT_REALLOC(sizeof(MyString) + grown -> shortSize, sizeof(MyString) + capacity);
+    // the array pointed into the old block, so point it into the new one
+    grown -> stringArray = grown -> shortArray;
+    grown -> realSize = capacity;
+    grown -> shortSize = capacity;
+    *str = grown;
+    return MYSTRING_SUCCESS;
 }
 
 /**
- * @brief Tester for myStringToCString()
- *
- * RETURN VALUE: none
+ * @brief Makes sure *str can hold a string of the given length without reallocating.
+ *        A heap string still in its inline buffer grows as a single block and *str is set to
+ *        its new address, any other string is passed on to myStringReserve.
+ *        Time complexity is that of growPacked or myStringReserve.
+ * @param str pointer to the MyString to reserve memory for.
+ * @param capacity the length the string should be able to hold.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
  */
-static void testMyStringToCString()
+MyStringRetVal myStringReserveEx(MyString **str, unsigned long capacity)
 {
-    printf("Start test for myStringToCString\n");
-    char *testCString = "Testing this now";
-    MyString *testStruct = myStringAlloc();
-    myStringSetFromCString(testStruct, testCString);
-    char *newCString = myStringToCString(testStruct);
-    char testChar = newCString[START_SIZE];
-    // check that string was copied with a null byte at end to make it a cstring
-    if(testChar != NULL_BYTE)
+    if(str == NULL || *str == NULL)
     {
-        printf("Improper null byte at end of c string in myStringToCString.\n");
-        printf("Expected: %c\n", NULL_BYTE);
-        printf("Actual: %c\n", testChar);
+        return MYSTRING_ERROR;
     }
-    MyString *testStruct2 = NULL;
-    char *newCString2 = myStringToCString(testStruct2);
-    // check that c string was copied properly
-    if(newCString2 != NULL)
+    if(capacity > myStringRealSize(*str) && isShortString(*str) && (*str) -> arena == NULL)
     {
-        printf("No null in cString2 in myStringToCString.\n");
-        printf("Expected: NULL");
-        printf("Actual: %s\n", newCString2);
+        return growPacked(str, capacity);
     }
-    myStringFree(testStruct);
-    free(newCString);
-    free(newCString2);
-    printf("End test for MyStringToCString\n");
+    return myStringReserve(*str, capacity);
 }
 
 /**
- * @brief Tester for myStringToInt()
- *
- * RETURN VALUE: none
+ * @brief Appends a copy of src to *dest, growing a heap string that is still in its inline
+ *        buffer as a single block (geometrically, like reSizeStringArray). *dest is set to its
+ *        new address. src may be *dest itself.
+ *        Time complexity is amortized O(k) where k is the length of src.
+ * @param dest pointer to the destination
+ * @param src the MyString to append
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
  */
-static void testMyStringToInt()
+MyStringRetVal myStringCatEx(MyString **dest, const MyString *src)
 {
-    printf("Start test for myStringToInt\n");
-    char *correctInt = "1234";
-    char *incorrectInt = "12a4";
-    char *negativeInt = "-1234";
-    char *emptyString = "";
-    char *complexInt = "1234567";
-    char *complexNegative = "-1234567";
-    char *badNegative = "12-34";
-    MyString *testStruct = myStringAlloc();
-    myStringSetFromCString(testStruct, correctInt);
-    int testInt = myStringToInt(testStruct);
-    // test that correct int was copied properly
-    if(testInt != 1234)
-    {
-        printf("Wrong value for int for correctInt test in myStringToInt.\n");
-        printf("Expected: %d\n", 1234);
-        printf("Actual: %d\n", testInt);
-    }
-    myStringSetFromCString(testStruct, incorrectInt);
-    testInt = myStringToInt(testStruct);
-    // check that error code is returned for improper int
-    if(testInt != MYSTR_ERROR_CODE)
+    if(dest == NULL || *dest == NULL || src == NULL)
     {
-        printImproperError(__func__, __LINE__);
+        return MYSTRING_ERROR;
     }
-    myStringSetFromCString(testStruct, negativeInt);
-    testInt = myStringToInt(testStruct);
-    // test that negative int was copied properly
-    if(testInt != -1234)
+    bool selfAppend = (src == *dest);
+    unsigned long totalSize = myStringLen(*dest) + myStringLen(src);
+    unsigned long capacity = myStringRealSize(*dest);
+    if(totalSize > capacity && isShortString(*dest) && (*dest) -> arena == NULL)
     {
-        printf("Wrong value for int for negativeInt test in myStringToInt.\n");
-        printf("Expected: %d\n", -1234);
-        printf("Actual: %d\n", testInt);
+        unsigned long grownSize = capacity / MYSTRING_GROWTH_DENOMINATOR * MYSTRING_GROWTH_NUMERATOR;
+        if(growPacked(dest, MAX(totalSize, grownSize)) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
     }
-    myStringSetFromCString(testStruct, emptyString);
-    testInt = myStringToInt(testStruct);
-    // check that error code is returned for improper int
-    if(testInt != MYSTR_ERROR_CODE)
-    {
-        printImproperError(__func__, __LINE__);
+    return myStringCat(*dest, selfAppend ? *dest : src);
+}
 
-    }
-    myStringSetFromCString(testStruct, complexInt);
-    testInt = myStringToInt(testStruct);
-    // test that complex int was copied properly
-    if(testInt != 1234567)
+/**
+ * @brief Creates a new arena to allocate MyStrings in.
+ *        Time complexity is O(1).
+ * @param slabSize the amount of bytes the arena allocates at once, 0 for the default.
+ * RETURN VALUE:
+ * @return a pointer to the new arena, or NULL if the allocation failed.
+ */
+MyStringArena * myStringArenaCreate(unsigned long slabSize)
+{
+    MyStringArena *arena = malloc(sizeof(MyStringArena));
+    if (arena == NULL)
     {
-        printf("Wrong value for int for complexInt test in myStringToInt.\n");
-        printf("Expected: %d\n", 1234567);
-        printf("Actual: %d\n", testInt);
+        return NULL;
     }
-    myStringSetFromCString(testStruct, complexNegative);
-    testInt = myStringToInt(testStruct);
-    // test that complex negative int was copied properly
-    if(testInt != -1234567)
+    arena -> slabs = NULL;
+    arena -> lastSlab = NULL;
+    arena -> freeSlabs = NULL;
+    arena -> used = EMPTY;
+    arena -> slabSize = (slabSize == EMPTY) ? ARENA_SLAB_SIZE : slabSize;
+    return arena;
+}
+
+/**
+ * @brief Allocates a new MyString inside an arena and sets its value to "".
+ *        The string and its array are released by the arena, so it must not be used after the
+ *        arena is reset or destroyed. Calling myStringFree on it does nothing.
+ *        Time complexity is that of arenaAlloc.
+ * @param arena the arena to allocate in.
+ * RETURN VALUE:
+ * @return a pointer to the new string, or NULL if the allocation failed.
+ */
+MyString * myStringAllocIn(MyStringArena *arena)
+{
+    if (arena == NULL)
     {
-        printf("Wrong value for int for complexNegative test in myStringToInt.\n");
-        printf("Expected: %d\n", -1234567);
-        printf("Actual: %d\n", testInt);
+        return NULL;
     }
-    myStringSetFromCString(testStruct, badNegative);
-    testInt = myStringToInt(testStruct);
-    // check that error code is returned for improper int
-    if(testInt != MYSTR_ERROR_CODE)
+    MyString *newString = arenaAlloc(arena, sizeof(MyString) + SHORT_SIZE);
+    if (newString == NULL)
     {
-        printImproperError(__func__, __LINE__);
+        return NULL;
     }
-    myStringFree(testStruct);
-    printf("End test for myStringToInt\n");
+    newString -> stringArray = newString -> shortArray;
+    newString -> stringSize = EMPTY;
+    newString -> realSize = SHORT_SIZE;
+    newString -> shortSize = SHORT_SIZE;
+    newString -> arena = arena;
+    atomic_init(&newString -> hash, NO_HASH);
+    newString -> stringArray[FIRST_INDEX] = NULL_BYTE;
+    return newString;
 }
 
 /**
- * @brief Tester for myStringCustomEqual()
- *
- * RETURN VALUE: none
+ * @brief Releases every MyString allocated in the arena, moving its slabs to the free slabs
+ *        so they are allocated from again instead of being freed.
+ *        Time complexity is O(1).
+ * @param arena the arena to reset. If it is NULL, no operation is performed.
  */
-static void testMyStringCustomEqual()
+void myStringArenaReset(MyStringArena *arena)
 {
-    printf("Start test for myStringCustomEqual\n");
-    char *string1 = "Testing";
-    char *string2 = "TestingWrong";
-    MyString *struct1 = myStringAlloc();
-    MyString *struct2 = myStringAlloc();
-    MyString *struct3 = myStringAlloc();
-    myStringSetFromCString(struct1, string1);
-    myStringSetFromCString(struct2, string1);
-    myStringSetFromCString(struct3, string2);
-    // check that equal recognizes that MyStrings are equal
-    if (myStringCustomEqual(struct1, struct2, logicalEqual) == UNEQUAL)
+    if (arena == NULL || arena -> slabs == NULL)
     {
-        printComparisonHelper("equality test", __func__, EQUAL,
-                              UNEQUAL);
+        return;
     }
-    // check that equal recognizes that MyStrings are unequal
-    if (myStringCustomEqual(struct1, struct3, logicalEqual) == EQUAL)
+    arena -> lastSlab -> next = arena -> freeSlabs;
+    arena -> freeSlabs = arena -> slabs;
+    arena -> slabs = NULL;
+    arena -> lastSlab = NULL;
+    arena -> used = EMPTY;
+}
+
+/**
+ * @brief Frees a list of slabs.
+ *        Time complexity is O(k) where k is the amount of slabs in the list.
+ */
+static void freeSlabs(ArenaSlab *slab)
+{
+    while (slab != NULL)
     {
-        printComparisonHelper("equality test", __func__, UNEQUAL ,
-                              EQUAL);
+        ArenaSlab *next = slab -> next;
+        free(slab);
+        slab = next;
     }
-    myStringFree(struct1);
-    myStringFree(struct2);
-    myStringFree(struct3);
-    printf("End test for myStringCustomEqual\n");
+}
+
+/**
+ * @brief Releases every MyString allocated in the arena and the arena itself.
+ *        Time complexity is O(k) where k is the amount of slabs in the arena.
+ * @param arena the arena to destroy. If it is NULL, no operation is performed.
+ */
+void myStringArenaDestroy(MyStringArena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+    freeSlabs(arena -> slabs);
+    freeSlabs(arena -> freeSlabs);
+    free(arena);
+}
+
+/**
+ * @brief Frees the memory and resources allocated to str.
+ *        Strings allocated in an arena are released with the arena instead.
+ *        Time complexity is O(1).
+ * @param str the MyString to free.
+ * If str is NULL, no operation is performed.
+ * It is the user's responsibility to set the pointer to NULL after calling this function
+ */
+void myStringFree(MyString *str)
+{
+    // check that str is not null
+    if (str != NULL && str -> arena == NULL)
+    {
+        COUNT_FREED_STRING(str);
+        //if it isn't then release the array it's pointer points to (unless it is the inline buffer)
+        if (!isShortString(str))
+        {
+            releaseSharedArray(str -> stringArray);
+        }
+        str -> stringArray = NULL;
+        // also free the struct itself
+        COUNT_FREE(sizeof(MyString) + str -> shortSize);
+        free(str);
+    }
+}
+
+/**
+ * @brief Allocates a new MyString with the same value as str. It is the caller's
+ * 		  responsibility to free the returned MyString.
+ *        A string whose array is on the heap shares that array with its clone, and the first of
+ *        them to be changed copies it. Strings in an inline buffer or an arena are copied.
+ *        Time complexity is O(1) for heap arrays, O(n) otherwise where n is the length of str.
+ * @param str the MyString to clone.
+ * RETURN VALUE:
+ *   @return a pointer to the new string, or NULL if the allocation failed.
+ */
+MyString * myStringClone(const MyString *str)
+{
+    if (str == NULL)
+    {
+        return NULL;
+    }
+    // declare a MyString do be initialized later
+    MyString *newString = NULL;
+    unsigned long size = myStringLen(str);
+    // share a heap array by taking a reference to it
+    if (!isShortString(str) && str -> arena == NULL)
+    {
+        newString = buildMyString(EMPTY);
+        if (newString == NULL)
+        {
+            return NULL;
+        }
+        atomic_fetch_add_explicit(&sharedArrayOf(str -> stringArray) -> referenceCount, 1,
+                                  memory_order_relaxed);
+        newString -> stringArray = str -> stringArray;
+        newString -> stringSize = size;
+        newString -> realSize = myStringRealSize(str);
+        atomic_store_explicit(&newString -> hash,
+                              atomic_load_explicit(&str -> hash, memory_order_relaxed),
+                              memory_order_relaxed);
+        return newString;
+    }
+    // if the MyString we are cloning is an "empty" string, then use myStringAlloc to initialize
+    if (size == EMPTY)
+    {
+        newString = myStringAlloc();
+        if(newString == NULL)
+        {
+            return NULL;
+        }
+    }
+    // otherwise allocate a new MyString the size needed and use myStringSetFromMyString to clone
+    else
+    {
+        newString = buildMyString(myStringLen(str));
+        if (newString == NULL)
+        {
+            return NULL;
+        }
+        myStringSetFromMyString(newString, str);
+    }
+    return newString;
+}
+
+/**
+ * @brief Sets the value of str to the value of other.
+ *        Time complexity is O(n) where n is the length of other's string.
+ * @param str the MyString to set
+ * @param other the MyString to set from
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringSetFromMyString(MyString *str, const MyString *other)
+{
+    // if either string is null then return an error
+    if(str == NULL || other == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    if(str == other)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    // get the length we want
+    unsigned long StringLength = myStringLen(other);
+    // if the string we are setting from is empty, change the length match the actual space we want
+    if (StringLength == 0)
+    {
+        StringLength = 16;
+    }
+    // if the length of str is smaller than the length of other then reallocate enough memory
+    if (reSizeStringArray(str, StringLength) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    // update our string length now that the array is ours and big enough
+    str -> stringSize = myStringLen(other);
+    if(myStringLen(other) == 0)
+    {
+        StringLength = 1;
+    }
+    // use memcpy to copy the values from other to str, along with its hash
+    memcpy(str -> stringArray, other -> stringArray, StringLength);
+    atomic_store_explicit(&str -> hash, atomic_load_explicit(&other -> hash, memory_order_relaxed),
+                          memory_order_relaxed);
+    // return success
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief gets the length of a MyString.
+ * @param The MyString we wish to check.
+ * @return the length of the string in str1.
+ */
+unsigned long myStringLen(const MyString *str1)
+{
+    if(str1 == NULL)
+    {
+        return (unsigned long) MYSTR_ERROR_CODE;
+    }
+    return str1 -> stringSize;
+}
+
+/**
+ * @brief gets the capacity of a MyString (the length it can reach without reallocating).
+ *        Time complexity is O(1).
+ * @param The MyString we wish to check.
+ * @return the capacity of str1.
+ */
+unsigned long myStringCapacity(const MyString *str1)
+{
+    if(str1 == NULL)
+    {
+        return (unsigned long) MYSTR_ERROR_CODE;
+    }
+    return myStringRealSize(str1);
+}
+
+/**
+ * @brief Makes sure str can hold a string of the given length without reallocating.
+ *        Never shrinks str. Time complexity is that of setCapacity.
+ * @param str the MyString to reserve memory for.
+ * @param capacity the length str should be able to hold.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringReserve(MyString *str, unsigned long capacity)
+{
+    if(str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    if(capacity <= myStringRealSize(str))
+    {
+        return MYSTRING_SUCCESS;
+    }
+    return setCapacity(str, capacity);
+}
+
+/**
+ * @brief Releases the unused capacity of str. Does nothing for strings in an arena.
+ *        Time complexity is that of setCapacity.
+ * @param str the MyString to shrink.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringShrinkToFit(MyString *str)
+{
+    if(str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    if(str -> arena != NULL)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    return setCapacity(str, myStringLen(str));
+}
+
+
+/**
+ * @brief Sets the value of str to the value of the given C string.
+ * 			The given C string must be terminated by the null character.
+ * 			Checking will not use a string without the null character.
+ *          Time complexity is O(n) where n is the length of cString. This is the cost of getting
+ *          cString's length and the cost of memcpy from cString to str.
+ * @param str the MyString to set.
+ * @param cString the C string to set from.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringSetFromCString(MyString *str, const char * cString)
+{
+    // find the length of cString and check whether the strings are null
+    if (str == NULL || cString == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // if no errors then proceed
+    else
+    {
+        unsigned long cStringLength = getCStringLength(cString);
+        // resize the array as needed and copy the cString into it without null byte
+        if (reSizeStringArray(str, cStringLength) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+        // use memcpy to copy cString to str
+        memcpy(str ->stringArray, cString, cStringLength);
+        // an empty string keeps a null byte in its first index (like myStringAlloc)
+        if (cStringLength == EMPTY)
+        {
+            str -> stringArray[FIRST_INDEX] = NULL_BYTE;
+        }
+        // resize stringArray for str and return success
+        str -> stringSize = cStringLength;
+        return MYSTRING_SUCCESS;
+    }
+}
+
+/**
+ * @brief Returns the value of str as a C string, terminated with the
+ * 	null character. It is the caller's responsibility to free the returned
+ * 	string by calling free().
+ *  Time complexity is O(n) where n is the length of str + 1. This is the cost of memcpy from str
+ *  to newCString.
+ * @param str the MyString
+ * RETURN VALUE:
+ *  @return the new string, or NULL if the allocation failed.
+ */
+char * myStringToCString(const MyString *str)
+{
+    if(str == NULL)
+    {
+        return NULL;
+    }
+    // set a long to be the size of str's string
+    unsigned long size = myStringLen(str);
+    // allocate new memory the size of that string + 1 for the null byte
+    char *newCString = malloc(size + 1);
+    // if the allocation failed, return null
+    if (newCString == NULL)
+    {
+        return NULL;
+    }
+    // otherwise use memcpy to copy str to newCString and then add the nullbyte
+    memcpy(newCString, str -> stringArray, size);
+    *(newCString + size) = NULL_BYTE;
+    return newCString;
+}
+
+/**
+ * @brief Returns the value of str as an integer.
+ * 	If str cannot be parsed as an integer,
+ * 	the return value should be MYSTR_ERROR_CODE
+ * 	NOTE: positive and negative integers should be supported.
+ *  Time complexity is O(n) where n is the length of str. This is because we go over every char
+ *  to calculate it's int value.
+ * @param str the MyString
+ * @return an integer
+ */
+int myStringToInt(const MyString *str)
+{
+    if(str == NULL)
+    {
+        return MYSTR_ERROR_CODE;
+    }
+    return myStringViewToInt(myStringViewOf(str));
+}
+
+/**
+ * @brief Sets the value of str to the value of the integer n.
+ *        (i.e. if n=7 than str should contain ‘7’)
+ *        You are not allowed to use itoa (or a similar functions) here but
+ *        must code your own conversion function.
+ *        Time complexity is O(n) where n is the amount of digits in the int. The digits are
+ *        counted in O(1) and written two at a time from a table.
+ * @param str the MyString to set.
+ * @param n the int to set from.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringSetFromInt(MyString *str, int n)
+{
+    // check that str is not null, if it is return an error
+    if (str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // if our length was not enough, reallocate memory
+    if (reSizeStringArray(str, INT_STRING_SIZE) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    // update the struct's size
+    str -> stringSize = formatInt(n, str -> stringArray);
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(d) where d is the amount of digits in n.
+ */
+MyStringRetVal myStringSetFromInt64(MyString *str, int64_t n)
+{
+    if (str == NULL || reSizeStringArray(str, INT64_STRING_SIZE) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    str -> stringSize = formatInt64(n, str -> stringArray);
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(d) where d is the amount of digits in n.
+ */
+MyStringRetVal myStringSetFromUInt64(MyString *str, uint64_t n)
+{
+    if (str == NULL || reSizeStringArray(str, INT64_STRING_SIZE) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    str -> stringSize = formatUInt64(n, str -> stringArray);
+    return MYSTRING_SUCCESS;
+}
+
+/*
+ * The C locale, in which doubles are written and read with a '.' whatever LC_NUMERIC is.
+ * Created once by useCLocale, (locale_t) 0 if that failed
+ */
+static locale_t cLocale;
+static pthread_once_t cLocaleOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Creates cLocale.
+ */
+static void createCLocale()
+{
+    cLocale = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+}
+
+/**
+ * @brief Makes the calling thread use the C locale, until restoreLocale is called with the
+ *        returned locale. Time complexity is O(1).
+ * RETURN VALUE:
+ * @return the locale the thread used, or (locale_t) 0 if the C locale could not be created and
+ *         the thread keeps its locale.
+ */
+static locale_t useCLocale()
+{
+    pthread_once(&cLocaleOnce, createCLocale);
+    return (cLocale == (locale_t) 0) ? (locale_t) 0 : uselocale(cLocale);
+}
+
+/**
+ * @brief Gives the calling thread back the locale useCLocale returned.
+ *        Time complexity is O(1).
+ */
+static void restoreLocale(locale_t previous)
+{
+    if (previous != (locale_t) 0)
+    {
+        uselocale(previous);
+    }
+}
+
+/**
+ * @brief Complexity is O(1): the value is written with at most 3 precisions, each checked by
+ *        reading it back. Both are done in the C locale, so the decimal point is a '.'.
+ */
+MyStringRetVal myStringSetFromDouble(MyString *str, double value)
+{
+    if (str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // most doubles (like 0.1) are read back from 15 digits, and every double from 17
+    char buffer[DOUBLE_STRING_SIZE];
+    int length = 0;
+    locale_t previous = useCLocale();
+    for (int precision = DOUBLE_MIN_PRECISION; precision <= DOUBLE_MAX_PRECISION; precision++)
+    {
+        length = snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (precision == DOUBLE_MAX_PRECISION || strtod(buffer, NULL) == value)
+        {
+            break;
+        }
+    }
+    restoreLocale(previous);
+    if (length < 0)
+    {
+        return MYSTRING_ERROR;
+    }
+    return myStringSetFromView(str, myStringViewOfBuffer(buffer, (unsigned long) length));
+}
+
+/**
+ * @brief Writes the decimal representation of an int to a buffer (without a null byte).
+ *        Time complexity is O(d) where d is the amount of digits in the int.
+ * @param n the int to write.
+ * @param toCheck buffer of at least INT_STRING_SIZE chars.
+ * RETURN VALUE:
+ * @return the amount of chars written.
+ */
+static unsigned long formatInt(int n, char *toCheck)
+{
+    return formatInt64(n, toCheck);
+}
+
+/**
+ * @brief filter the value of str acording to a filter.
+ * 	remove from str all the occurrence of chars that are filtered by filt
+ *	(i.e. filr(char)==true)
+ *  Time complexity is O(n) where n is the length of str. The kept chars are moved back over
+ *  the removed ones in place, without branching on what filt returns.
+ * @param str the MyString to filter
+ * @param filt the filter
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure. */
+MyStringRetVal myStringFilter(MyString *str, bool (*filt)(const char *))
+{
+    // check for null string
+    if(str == NULL || filt == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // make sure the array is not shared before changing it
+    if (reSizeStringArray(str, myStringLen(str)) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    char *chars = str -> stringArray;
+    unsigned long kept = EMPTY;
+    for (unsigned long i = 0; i < myStringLen(str); i++)
+    {
+        // every char is written to the next kept index, and only counted if it is kept
+        bool removed = filt(chars + i);
+        chars[kept] = chars[i];
+        kept += !removed;
+    }
+    str -> stringSize = kept;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+void myCharSetClear(MyCharSet *set)
+{
+    if (set != NULL)
+    {
+        memset(set, 0, sizeof(*set));
+    }
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+void myCharSetAdd(MyCharSet *set, char c)
+{
+    if (set != NULL)
+    {
+        unsigned char index = (unsigned char) c;
+        set -> bits[index / CHAR_SET_WORD_BITS] |= (uint64_t) 1 << (index % CHAR_SET_WORD_BITS);
+    }
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of chars.
+ */
+void myCharSetAddChars(MyCharSet *set, const char *chars)
+{
+    if (set == NULL || chars == NULL)
+    {
+        return;
+    }
+    for (; *chars != NULL_BYTE; chars++)
+    {
+        myCharSetAdd(set, *chars);
+    }
+}
+
+/**
+ * @brief Complexity is O(k) where k is the amount of chars in the range.
+ */
+void myCharSetAddRange(MyCharSet *set, char first, char last)
+{
+    for (unsigned int c = (unsigned char) first; c <= (unsigned char) last; c++)
+    {
+        myCharSetAdd(set, (char) c);
+    }
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+bool myCharSetHas(const MyCharSet *set, char c)
+{
+    if (set == NULL)
+    {
+        return false;
+    }
+    unsigned char index = (unsigned char) c;
+    return (set -> bits[index / CHAR_SET_WORD_BITS] >> (index % CHAR_SET_WORD_BITS)) & 1;
+}
+
+/*
+ * A filter kernel removes the chars of a set from an array of chars in place, keeping the order
+ * of the rest, and returns the amount of chars kept.
+ */
+typedef unsigned long (*FilterKernel)(char *chars, unsigned long length, const MyCharSet *set);
+
+/**
+ * @brief Removes the chars of set from chars one char at a time, without branching.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the amount of chars kept.
+ */
+static unsigned long filterScalar(char *chars, unsigned long length, const MyCharSet *set)
+{
+    unsigned long kept = 0;
+    for (unsigned long i = 0; i < length; i++)
+    {
+        char c = chars[i];
+        chars[kept] = c;
+        kept += !myCharSetHas(set, c);
+    }
+    return kept;
+}
+
+#ifdef MYSTRING_X86
+/*
+ * For every 8 bit mask, the pshufb indices moving the chars of an 8 char half whose bits are set
+ * to its start (the rest are 0x80, which pshufb turns to 0). Filled by selectFilterKernel.
+ */
+static uint8_t filterShuffles[1 << 8][8];
+
+/**
+ * @brief Fills filterShuffles. Time complexity is O(1).
+ */
+static void buildFilterShuffles()
+{
+    for (unsigned int mask = 0; mask < (1 << 8); mask++)
+    {
+        unsigned int count = 0;
+        for (unsigned int bit = 0; bit < 8; bit++)
+        {
+            if (mask & (1u << bit))
+            {
+                filterShuffles[mask][count++] = (uint8_t) bit;
+            }
+        }
+        while (count < 8)
+        {
+            filterShuffles[mask][count++] = 0x80;
+        }
+    }
+}
+
+/**
+ * @brief Removes the chars of set from chars 16 chars at a time with SSSE3. Membership is looked
+ *        up with pshufb in two 16 entry tables indexed by the low nibble, whose bytes hold a bit
+ *        for every high nibble, and the kept chars of every 8 char half are moved together with
+ *        a pshufb from filterShuffles. A block is never written past its own end, so it is safe
+ *        in place. Only called after checking the CPU supports SSSE3.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return the amount of chars kept.
+ */
+__attribute__((target("ssse3")))
+static unsigned long filterSsse3(char *chars, unsigned long length, const MyCharSet *set)
+{
+    uint8_t lowRows[16] = {0};
+    uint8_t highRows[16] = {0};
+    for (unsigned int low = 0; low < 16; low++)
+    {
+        for (unsigned int high = 0; high < 8; high++)
+        {
+            lowRows[low] |= (uint8_t) (myCharSetHas(set, (char) (high << 4 | low)) << high);
+            highRows[low] |= (uint8_t) (myCharSetHas(set, (char) ((high + 8) << 4 | low)) << high);
+        }
+    }
+    __m128i lowTable = _mm_loadu_si128((const __m128i *) lowRows);
+    __m128i highTable = _mm_loadu_si128((const __m128i *) highRows);
+    __m128i bitTable = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i seven = _mm_set1_epi8(7);
+    unsigned long kept = 0;
+    unsigned long i = 0;
+    for (; i + FILTER_BLOCK_SIZE <= length; i += FILTER_BLOCK_SIZE)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *) (chars + i));
+        __m128i low = _mm_and_si128(block, nibble);
+        __m128i high = _mm_and_si128(_mm_srli_epi16(block, 4), nibble);
+        __m128i isHigh = _mm_cmpgt_epi8(high, seven);
+        __m128i rows = _mm_or_si128(_mm_and_si128(isHigh, _mm_shuffle_epi8(highTable, low)),
+                                    _mm_andnot_si128(isHigh, _mm_shuffle_epi8(lowTable, low)));
+        __m128i bits = _mm_shuffle_epi8(bitTable, high);
+        __m128i inSet = _mm_cmpeq_epi8(_mm_and_si128(rows, bits), bits);
+        unsigned int keep = ~(unsigned int) _mm_movemask_epi8(inSet) & 0xFFFF;
+        if (keep == 0xFFFF)
+        {
+            _mm_storeu_si128((__m128i *) (chars + kept), block);
+            kept += FILTER_BLOCK_SIZE;
+        }
+        else if (keep != 0)
+        {
+            __m128i shuffle = _mm_loadl_epi64((const __m128i *) filterShuffles[keep & 0xFF]);
+            _mm_storel_epi64((__m128i *) (chars + kept), _mm_shuffle_epi8(block, shuffle));
+            kept += __builtin_popcount(keep & 0xFF);
+            shuffle = _mm_loadl_epi64((const __m128i *) filterShuffles[keep >> 8]);
+            _mm_storel_epi64((__m128i *) (chars + kept),
+                             _mm_shuffle_epi8(_mm_srli_si128(block, 8), shuffle));
+            kept += __builtin_popcount(keep >> 8);
+        }
+    }
+    for (; i < length; i++)
+    {
+        char c = chars[i];
+        chars[kept] = c;
+        kept += !myCharSetHas(set, c);
+    }
+    return kept;
+}
+#endif
+
+/**
+ * @brief Lists the filter kernels this machine can run, from the slowest to the fastest.
+ *        Time complexity is O(1).
+ * @param kernels array of at least 2 kernels to fill.
+ * RETURN VALUE:
+ * @return the amount of kernels listed.
+ */
+static int listFilterKernels(FilterKernel *kernels)
+{
+    int count = 0;
+    kernels[count++] = filterScalar;
+#ifdef MYSTRING_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3"))
+    {
+        kernels[count++] = filterSsse3;
+    }
+#endif
+    return count;
+}
+
+/*
+ * The fastest filter kernel of this machine, chosen once by getFilterKernel
+ */
+static FilterKernel filterKernel;
+static pthread_once_t filterKernelOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Sets filterKernel to the fastest kernel this machine can run, and builds the tables
+ *        it needs.
+ */
+static void selectFilterKernel()
+{
+#ifdef MYSTRING_X86
+    buildFilterShuffles();
+#endif
+    FilterKernel kernels[2];
+    filterKernel = kernels[listFilterKernels(kernels) - 1];
+}
+
+/**
+ * @brief Gets the fastest filter kernel of this machine, checking the CPU on the first call.
+ *        Time complexity is O(1).
+ */
+static FilterKernel getFilterKernel()
+{
+    pthread_once(&filterKernelOnce, selectFilterKernel);
+    return filterKernel;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of str.
+ */
+MyStringRetVal myStringFilterSet(MyString *str, const MyCharSet *set)
+{
+    if (str == NULL || set == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // make sure the array is not shared before changing it
+    if (reSizeStringArray(str, myStringLen(str)) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    str -> stringSize = getFilterKernel()(str -> stringArray, myStringLen(str), set);
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Compare str1 and str2.
+ * Time complexity is O(min(length str1, length str2)).
+ * @param str1
+ * @param str2
+ * RETURN VALUE:
+ * @return an integral value indicating the relationship between the strings:
+ * 	A zero value indicates that the strings are equal.
+ * 	A value greater than zero indicates that the first character that does not 
+ *  match has a greater ASCII value in str1 than in str2;
+ * 	And a value less than zero indicates the opposite.
+ * 	If strings cannot be compared, the return value should be MYSTR_ERROR_CODE
+ */
+int myStringCompare(const MyString *str1, const MyString *str2)
+{
+    // returns a call to the custom compare with the default comparator we made
+    return myStringCustomCompare(str1, str2, defCompare);
+}
+
+/**
+ * @brief Compares str1 and str2.
+ *        Time complexity is O(n) where n is min(length str1 , length str2) in worst case these are
+ *        equal.
+ * @param str1
+ * @param str2
+ * @param comparator
+ * RETURN VALUE:
+ * @return an integral value indicating the relationship between the strings:
+ * 	A zero value indicates that the strings are equal according to the custom comparator 
+ *  (3rd parameter).
+ * 	A value greater than zero indicates that the first MyString is bigger according to 
+ *  the comparator. And a value less than zero indicates the opposite.
+ * 	If strings cannot be compared, the return value should be MYSTR_ERROR_CODE
+ */
+int myStringCustomCompare(const MyString *str1, const MyString *str2,
+                          int (*foo)(const char *compareChar1, const char *compareChar2))
+{
+    if(str1 == NULL || str2 == NULL)
+    {
+        return MYSTR_ERROR_CODE;
+    }
+    // save the sizes and find the minimum size
+    long size1 = myStringLen(str1);
+    long size2 = myStringLen(str2);
+    long minSize = MIN(size1, size2);
+    // check the equality up to that size. The library's comparators go through a compare kernel
+    // and are only called at the mismatch, so the result is the same as calling them on every char
+    int result;
+    unsigned long mismatch;
+    if (findMismatch(minSize, str1, str2, foo, &mismatch))
+    {
+        result = (mismatch < (unsigned long) minSize) ?
+                 foo(str1 -> stringArray + mismatch, str2 -> stringArray + mismatch) : SAME;
+    }
+    else
+    {
+        result = checkEquality(minSize, str1, str2, foo);
+    }
+    // if already here we find an imbalance return it
+    if(result != SAME)
+    {
+        return result;
+    }
+    // otherwise according to their sizes return proper int
+    else
+    {
+        if(size1 == size2)
+        {
+            return SAME;
+        }
+        else if(size1 > size2)
+        {
+            return BIGGER;
+        }
+        else
+        {
+            return SMALLER;
+        }
+    }
+}
+
+
+/**
+ * @brief Check if str1 is equal to str2.
+ *        Time complexity is O(n) where n is the length of str1 and and str2 in worst case.
+ *        In best case it is O(1) because if the strings are not the same length they are for sure
+ *        not equal.
+ * @param str1
+ * @param str2
+ * @param comparator
+ * RETURN VALUE:
+ * @return an integral value indicating the equality of the strings using a 
+ *  custom comparator (3rd parameter):
+ * 	A zero value indicates that the strings are not equal.
+ * 	A greater than zero value indicates that the strings are equal.
+ * 	If string cannot be compared, the return value should be MYSTR_ERROR_CODE
+ */
+int myStringCustomEqual(const MyString *str1, const MyString *str2,
+                        int (*foo)(const char *char1, const char * char2))
+{
+    if(str1 == NULL || str2 == NULL)
+    {
+        return MYSTR_ERROR_CODE;
+    }
+    // save their sizes. If the sizes don't match they are definitely not equal
+    long size1 = myStringLen(str1);
+    long size2 = myStringLen(str2);
+    if(size1 != size2)
+    {
+        return UNEQUAL;
+    }
+    // otherwise use checkEquality (or a compare kernel) to get whether they are equal according
+    // to foo
+    else
+    {
+        unsigned long mismatch;
+        int result = findMismatch(size1, str1, str2, foo, &mismatch) ?
+                     (mismatch != (unsigned long) size1) : checkEquality(size1, str1, str2, foo);
+        if(result == SAME)
+        {
+            return EQUAL;
+        }
+        else
+        {
+            return UNEQUAL;
+        }
+    }
+}
+
+
+/**
+ * @brief Check if str1 is equal to str2.
+ *        Time complexity is that of myStringCustomEqual which is O(n) in worst case and O(1) in
+ *        best. Where n is the length of str1 and str2,
+ * @param str1
+ * @param str2
+ * RETURN VALUE:
+ * @return an integral value indicating the equality of the strings 
+ *         (logical equality - that they are composed of the very same characters):
+ * 	A zero value indicates that the strings are not equal.
+ * 	A greater than zero value indicates that the strings are equal.
+ * 	If strings cannot be compared, the return value should be MYSTR_ERROR_CODE
+ */
+int myStringEqual(const MyString *str1, const MyString *str2)
+{
+    // uses myStringCustomEqual with a default comparator to decide whether they are equal
+    return myStringCustomEqual(str1, str2, logicalEqual);
+}
+
+/**
+ * @brief Checks if a char is a decimal digit.
+ */
+static bool isDigitChar(char c)
+{
+    return c >= ZERO && c <= NINE;
+}
+
+/**
+ * @brief Compares the numbers written by the digit runs starting at two indexes, ignoring leading
+ *        zeros, and moves both indexes past their runs.
+ *        Time complexity is O(n) where n is the length of the longer run.
+ * RETURN VALUE:
+ * @return 0 if the numbers are equal, 1 if the first is bigger, -1 if the second is.
+ */
+static int compareDigitRuns(const char *chars1, unsigned long *index1, unsigned long length1,
+                            const char *chars2, unsigned long *index2, unsigned long length2)
+{
+    unsigned long start1 = *index1;
+    unsigned long start2 = *index2;
+    while (start1 < length1 && chars1[start1] == ZERO)
+    {
+        start1++;
+    }
+    while (start2 < length2 && chars2[start2] == ZERO)
+    {
+        start2++;
+    }
+    unsigned long end1 = start1;
+    unsigned long end2 = start2;
+    while (end1 < length1 && isDigitChar(chars1[end1]))
+    {
+        end1++;
+    }
+    while (end2 < length2 && isDigitChar(chars2[end2]))
+    {
+        end2++;
+    }
+    *index1 = end1;
+    *index2 = end2;
+    // a number with more digits is bigger, otherwise the first differing digit decides
+    if (end1 - start1 != end2 - start2)
+    {
+        return (end1 - start1 > end2 - start2) ? BIGGER : SMALLER;
+    }
+    unsigned long mismatch = getCompareKernels() -> mismatch(chars1 + start1, chars2 + start2,
+                                                             end1 - start1);
+    if (mismatch == end1 - start1)
+    {
+        return SAME;
+    }
+    return defCompare(chars1 + start1 + mismatch, chars2 + start2 + mismatch);
+}
+
+/**
+ * @brief Compares str1 and str2 treating runs of digits as numbers, so "file9" is smaller than
+ *        "file10". Other chars are compared as in myStringCompare. Strings whose numbers only
+ *        differ in leading zeros are ordered by myStringCompare.
+ *        Equal parts are skipped with a compare kernel, so only the digits around a mismatch are
+ *        looked at one by one.
+ *        Time complexity is O(n) where n is the length of the longer string.
+ * @param str1
+ * @param str2
+ * RETURN VALUE:
+ * @return 0 if the strings are equal, a value greater than zero if str1 is bigger, smaller than
+ *         zero if str2 is, and MYSTR_ERROR_CODE if strings cannot be compared.
+ */
+int myStringNaturalCompare(const MyString *str1, const MyString *str2)
+{
+    if (str1 == NULL || str2 == NULL)
+    {
+        return MYSTR_ERROR_CODE;
+    }
+    const char *chars1 = str1 -> stringArray;
+    const char *chars2 = str2 -> stringArray;
+    unsigned long length1 = myStringLen(str1);
+    unsigned long length2 = myStringLen(str2);
+    unsigned long index1 = EMPTY;
+    unsigned long index2 = EMPTY;
+    while (index1 < length1 && index2 < length2)
+    {
+        unsigned long same = getCompareKernels() -> mismatch(chars1 + index1, chars2 + index2,
+                                                             MIN(length1 - index1,
+                                                                 length2 - index2));
+        // the mismatch may be inside a number, so go back to where that number starts
+        while (same > EMPTY && isDigitChar(chars1[index1 + same - 1]))
+        {
+            same--;
+        }
+        index1 += same;
+        index2 += same;
+        if (index1 == length1 || index2 == length2)
+        {
+            break;
+        }
+        if (isDigitChar(chars1[index1]) && isDigitChar(chars2[index2]))
+        {
+            int result = compareDigitRuns(chars1, &index1, length1, chars2, &index2, length2);
+            if (result != SAME)
+            {
+                return result;
+            }
+        }
+        else
+        {
+            return defCompare(chars1 + index1, chars2 + index2);
+        }
+    }
+    // the string with chars left is bigger
+    if (length1 - index1 != length2 - index2)
+    {
+        return (length1 - index1 > length2 - index2) ? BIGGER : SMALLER;
+    }
+    int result = myStringCompare(str1, str2);
+    return (result > SAME) - (result < SAME);
+}
+
+/**
+ * @brief Getter for the total amount of memory used by a MyString.
+ *        The struct already includes the inline buffer, so the string's array is only added
+ *        when it was moved to the heap. A heap array shared by clones is counted in full for
+ *        each of them (it is what freeing every other clone would leave this one with).
+ *        Time complexity is O(1)
+ * @param the Mystring we wish to check.
+ * @return the amount of memory (all the memory that used by the MyString 
+ *         object itself and its allocations), in bytes, allocated to str1.
+ */
+unsigned long myStringMemUsage(const MyString *str1)
+{
+    if(str1 == NULL)
+    {
+        return (unsigned long) MYSTR_ERROR_CODE;
+    }
+    if (isShortString(str1))
+    {
+        return sizeof(MyString) + str1 -> shortSize;
+    }
+    if (str1 -> arena != NULL)
+    {
+        return sizeof(MyString) + str1 -> shortSize + myStringRealSize(str1);
+    }
+    return sizeof(MyString) + str1 -> shortSize + sizeof(SharedArray) + myStringRealSize(str1);
+}
+
+/**
+ * @brief Writes the content of str to stream. (like fputs())
+ *        The chars are written as they are stored, so nothing is allocated and null bytes in str
+ *        are written too. The stream is not flushed, like with fputs.
+ *        Time complexity is O(n) where n is length of str.
+ * @param MyString we wish to write to file.
+ * @param open file stream.
+ * RETURNS:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWrite(const MyString *str, FILE *stream)
+{
+    if (str == NULL || stream == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return myStringViewWrite(myStringViewOf(str), stream);
+}
+
+/**
+ * @brief Writes the chars of str to a stream the caller has locked, without locking it again
+ *        for every call like fwrite does.
+ *        Time complexity is O(n) where n is length of str.
+ * RETURNS:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal writeUnlocked(const MyString *str, FILE *stream)
+{
+    unsigned long length = myStringLen(str);
+#ifdef __GLIBC__
+    if (fwrite_unlocked(str -> stringArray, sizeof(char), length, stream) != length)
+    {
+        return MYSTRING_ERROR;
+    }
+#else
+    for (unsigned long i = 0; i < length; i++)
+    {
+        if (putc_unlocked(str -> stringArray[i], stream) == EOF)
+        {
+            return MYSTRING_ERROR;
+        }
+    }
+#endif
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Writes n strings to stream, each followed by sep.
+ *        The stream is locked once for the whole batch, and is not flushed.
+ *        Time complexity is O(m) where m is the total length of the strings and separators.
+ * @param strs the strings.
+ * @param n the amount of strings.
+ * @param sep separator written after every string, NULL for none.
+ * @param stream open file stream.
+ * RETURNS:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriteMany(const MyString * const *strs, unsigned long n,
+                                 const MyString *sep, FILE *stream)
+{
+    if ((strs == NULL && n > 0) || stream == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    MyStringRetVal result = MYSTRING_SUCCESS;
+    flockfile(stream);
+    for (unsigned long i = 0; i < n && result == MYSTRING_SUCCESS; i++)
+    {
+        if (strs[i] == NULL || writeUnlocked(strs[i], stream) == MYSTRING_ERROR ||
+            (sep != NULL && writeUnlocked(sep, stream) == MYSTRING_ERROR))
+        {
+            result = MYSTRING_ERROR;
+        }
+    }
+    funlockfile(stream);
+    return result;
+}
+
+/**
+ * @brief Writes all the buffers of an array of buffers to a file descriptor, calling writev
+ *        again after partial writes and interrupts.
+ *        Time complexity is O(m) where m is the total length of the buffers.
+ * @param fd the file descriptor.
+ * @param buffers the buffers, changed to point past what was written.
+ * @param count the amount of buffers.
+ * RETURNS:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal writeBuffers(int fd, struct iovec *buffers, int count)
+{
+    while (count > 0)
+    {
+        // skip empty buffers, so writing nothing means the file descriptor takes no more
+        if (buffers -> iov_len == EMPTY)
+        {
+            buffers++;
+            count--;
+            continue;
+        }
+        ssize_t written = writev(fd, buffers, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return MYSTRING_ERROR;
+        }
+        if (written == 0)
+        {
+            return MYSTRING_ERROR;
+        }
+        // skip the buffers that were written, and the written part of the next one
+        while (count > 0 && (size_t) written >= buffers -> iov_len)
+        {
+            written -= buffers -> iov_len;
+            buffers++;
+            count--;
+        }
+        if (count > 0)
+        {
+            buffers -> iov_base = (char *) buffers -> iov_base + written;
+            buffers -> iov_len -= written;
+        }
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Writes n strings to a file descriptor, each followed by sep, straight from their
+ *        arrays with a writev for every WRITE_BATCH_SIZE buffers.
+ *        Time complexity is O(m) where m is the total length of the strings and separators.
+ * @param strs the strings.
+ * @param n the amount of strings.
+ * @param sep separator written after every string, NULL for none.
+ * @param fd open file descriptor.
+ * RETURNS:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriteManyFd(const MyString * const *strs, unsigned long n,
+                                   const MyString *sep, int fd)
+{
+    if ((strs == NULL && n > 0) || fd < 0)
+    {
+        return MYSTRING_ERROR;
+    }
+    struct iovec buffers[WRITE_BATCH_SIZE];
+    int count = 0;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        if (strs[i] == NULL)
+        {
+            return MYSTRING_ERROR;
+        }
+        buffers[count++] = (struct iovec) {strs[i] -> stringArray, myStringLen(strs[i])};
+        if (sep != NULL)
+        {
+            buffers[count++] = (struct iovec) {sep -> stringArray, myStringLen(sep)};
+        }
+        // leave room for a string and its separator
+        if (count > WRITE_BATCH_SIZE - 2 || i == n - 1)
+        {
+            if (writeBuffers(fd, buffers, count) == MYSTRING_ERROR)
+            {
+                return MYSTRING_ERROR;
+            }
+            count = 0;
+        }
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Creates a writer for a stream or a file descriptor.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return a pointer to the new writer, or NULL on failure.
+ */
+static MyStringWriter * buildWriter(FILE *stream, int fd, unsigned long bufferSize,
+                                    MyStringFlushPolicy policy, unsigned long lines)
+{
+    if (policy == MYSTRING_FLUSH_LINES && lines == EMPTY)
+    {
+        return NULL;
+    }
+    MyStringWriter *writer = malloc(sizeof(MyStringWriter));
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+    writer -> size = (bufferSize == EMPTY) ? WRITER_BUFFER_SIZE : bufferSize;
+    writer -> buffer = malloc(writer -> size);
+    if (writer -> buffer == NULL)
+    {
+        free(writer);
+        return NULL;
+    }
+    writer -> stream = stream;
+    writer -> fd = fd;
+    writer -> used = EMPTY;
+    writer -> policy = policy;
+    writer -> flushLines = lines;
+    writer -> lines = EMPTY;
+    writer -> stats = (MyStringWriterStats) {EMPTY, EMPTY};
+    return writer;
+}
+
+/**
+ * Complexity is O(1).
+ */
+MyStringWriter * myStringWriterCreate(FILE *stream, unsigned long bufferSize,
+                                      MyStringFlushPolicy policy, unsigned long lines)
+{
+    if (stream == NULL)
+    {
+        return NULL;
+    }
+    return buildWriter(stream, fileno(stream), bufferSize, policy, lines);
+}
+
+/**
+ * Complexity is O(1).
+ */
+MyStringWriter * myStringWriterCreateFd(int fd, unsigned long bufferSize,
+                                        MyStringFlushPolicy policy, unsigned long lines)
+{
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    return buildWriter(NULL, fd, bufferSize, policy, lines);
+}
+
+/**
+ * @brief Writes chars to the target of a writer, skipping its buffer.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal writeToTarget(MyStringWriter *writer, const char *chars,
+                                    unsigned long length)
+{
+    if (writer -> stream != NULL)
+    {
+        if (fwrite(chars, sizeof(char), length, writer -> stream) != length)
+        {
+            return MYSTRING_ERROR;
+        }
+    }
+    else
+    {
+        struct iovec buffer = {(char *) chars, length};
+        if (writeBuffers(writer -> fd, &buffer, 1) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+    }
+    writer -> stats.bytesWritten += length;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * Complexity is O(n) where n is the amount of bytes in the buffer.
+ */
+MyStringRetVal myStringWriterFlush(MyStringWriter *writer)
+{
+    if (writer == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    if (writeToTarget(writer, writer -> buffer, writer -> used) == MYSTRING_ERROR ||
+        (writer -> stream != NULL && fflush(writer -> stream) == EOF))
+    {
+        return MYSTRING_ERROR;
+    }
+    writer -> used = EMPTY;
+    writer -> lines = EMPTY;
+    writer -> stats.flushes++;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * Complexity is O(n) where n is the amount of bytes in the buffer.
+ */
+void myStringWriterDestroy(MyStringWriter *writer)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+    if (writer -> used > EMPTY)
+    {
+        myStringWriterFlush(writer);
+    }
+    free(writer -> buffer);
+    free(writer);
+}
+
+/**
+ * @brief Makes room for length more bytes in the buffer of a writer, by flushing it or (with
+ *        MYSTRING_FLUSH_EXPLICIT) by growing it.
+ *        Time complexity is O(n) where n is the amount of bytes in the buffer.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal reserveWriter(MyStringWriter *writer, unsigned long length)
+{
+    if (writer -> used + length <= writer -> size)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    if (writer -> policy != MYSTRING_FLUSH_EXPLICIT)
+    {
+        return myStringWriterFlush(writer);
+    }
+    unsigned long size = MAX(writer -> size * 2, writer -> used + length);
+    char *buffer = realloc(writer -> buffer, size);
+    if (buffer == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    writer -> buffer = buffer;
+    writer -> size = size;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Counts the new lines in chars added to a writer, and flushes it if the
+ *        MYSTRING_FLUSH_LINES policy says so.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal countWriterLines(MyStringWriter *writer, const char *chars,
+                                       unsigned long length)
+{
+    if (writer -> policy != MYSTRING_FLUSH_LINES)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    const char *end = chars + length;
+    const char *newLine = memchr(chars, NEW_LINE, length);
+    while (newLine != NULL)
+    {
+        writer -> lines++;
+        newLine = memchr(newLine + 1, NEW_LINE, end - newLine - 1);
+    }
+    if (writer -> lines >= writer -> flushLines)
+    {
+        return myStringWriterFlush(writer);
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Adds chars to a writer. Chars that do not fit in the (flushed) buffer are written out
+ *        directly.
+ *        Time complexity is O(n) where n is length, plus that of a flush.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal writerAppend(MyStringWriter *writer, const char *chars,
+                                   unsigned long length)
+{
+    if (reserveWriter(writer, length) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    if (length > writer -> size)
+    {
+        if (writeToTarget(writer, chars, length) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+        writer -> stats.flushes++;
+        return MYSTRING_SUCCESS;
+    }
+    memcpy(writer -> buffer + writer -> used, chars, length);
+    writer -> used += length;
+    return countWriterLines(writer, chars, length);
+}
+
+/**
+ * Complexity is O(n) where n is the length of str.
+ */
+MyStringRetVal myStringWriterWrite(MyStringWriter *writer, const MyString *str)
+{
+    if (writer == NULL || str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return writerAppend(writer, str -> stringArray, myStringLen(str));
+}
+
+/**
+ * Complexity is O(n) where n is the length of cString.
+ */
+MyStringRetVal myStringWriterWriteCString(MyStringWriter *writer, const char *cString)
+{
+    if (writer == NULL || cString == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return writerAppend(writer, cString, getCStringLength(cString));
+}
+
+/**
+ * Complexity is O(1).
+ */
+MyStringRetVal myStringWriterWriteChar(MyStringWriter *writer, char c)
+{
+    if (writer == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return writerAppend(writer, &c, sizeof(char));
+}
+
+/**
+ * Complexity is O(n) where n is the amount of digits in the int.
+ */
+MyStringRetVal myStringWriterWriteInt(MyStringWriter *writer, int n)
+{
+    if (writer == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // the int is formatted straight into the buffer when it fits
+    if (writer -> size < INT_STRING_SIZE)
+    {
+        char digits[INT_STRING_SIZE];
+        return writerAppend(writer, digits, formatInt(n, digits));
+    }
+    if (reserveWriter(writer, INT_STRING_SIZE) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    writer -> used += formatInt(n, writer -> buffer + writer -> used);
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * Complexity is O(1).
+ */
+MyStringRetVal myStringWriterGetStats(const MyStringWriter *writer, MyStringWriterStats *stats)
+{
+    if (writer == NULL || stats == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    *stats = writer -> stats;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * Complexity is O(n) where n is the length of the line read.
+ */
+MyStringRetVal myStringReadUntil(MyString *str, FILE *stream, char delim)
+{
+    if (str == NULL || stream == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // asking for the current capacity keeps the array (instead of shrinking it for a short line)
+    unsigned long capacity = myStringRealSize(str);
+    if (reSizeStringArray(str, capacity) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    unsigned long length = EMPTY;
+    int c = EOF;
+    MyStringRetVal result = MYSTRING_SUCCESS;
+    // the stream is locked once, so every char is read without taking the lock again
+    flockfile(stream);
+    while ((c = getc_unlocked(stream)) != EOF && c != (unsigned char) delim)
+    {
+        if (length == capacity)
+        {
+            str -> stringSize = length;
+            if (reSizeStringArray(str, length + 1) == MYSTRING_ERROR)
+            {
+                result = MYSTRING_ERROR;
+                break;
+            }
+            capacity = myStringRealSize(str);
+        }
+        str -> stringArray[length++] = (char) c;
+    }
+    if (c == EOF && result == MYSTRING_SUCCESS)
+    {
+        if (ferror(stream))
+        {
+            result = MYSTRING_ERROR;
+        }
+        else if (length == EMPTY)
+        {
+            result = MYSTRING_EOF;
+        }
+    }
+    funlockfile(stream);
+    str -> stringSize = length;
+    return result;
+}
+
+/**
+ * Complexity is O(n) where n is the length of the line read.
+ */
+MyStringRetVal myStringReadLine(MyString *str, FILE *stream)
+{
+    return myStringReadUntil(str, stream, NEW_LINE);
+}
+
+/**
+ * Complexity is O(1).
+ */
+MyStringLineReader * myStringLineReaderCreate(int fd, char delim, unsigned long bufferSize)
+{
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    MyStringLineReader *reader = malloc(sizeof(MyStringLineReader));
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+    reader -> size = (bufferSize == EMPTY) ? READER_BUFFER_SIZE : bufferSize;
+    reader -> buffer = malloc(reader -> size);
+    if (reader -> buffer == NULL)
+    {
+        free(reader);
+        return NULL;
+    }
+    reader -> fd = fd;
+    reader -> delim = delim;
+    reader -> start = EMPTY;
+    reader -> searched = EMPTY;
+    reader -> end = EMPTY;
+    reader -> endOfInput = false;
+    return reader;
+}
+
+/**
+ * Complexity is O(1).
+ */
+void myStringLineReaderDestroy(MyStringLineReader *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    free(reader -> buffer);
+    free(reader);
+}
+
+/**
+ * @brief Reads the next block of input into the buffer of a reader. The line that was not
+ *        finished is moved to the start of the buffer first, and the buffer is doubled if that
+ *        line fills all of it.
+ *        Time complexity is O(n) where n is the size of the buffer.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal fillLineReader(MyStringLineReader *reader)
+{
+    if (reader -> start > EMPTY)
+    {
+        memmove(reader -> buffer, reader -> buffer + reader -> start,
+                reader -> end - reader -> start);
+        reader -> end -= reader -> start;
+        reader -> searched -= reader -> start;
+        reader -> start = EMPTY;
+    }
+    if (reader -> end == reader -> size)
+    {
+        char *buffer = realloc(reader -> buffer, reader -> size * 2);
+        if (buffer == NULL)
+        {
+            return MYSTRING_ERROR;
+        }
+        reader -> buffer = buffer;
+        reader -> size *= 2;
+    }
+    ssize_t bytesRead;
+    do
+    {
+        bytesRead = read(reader -> fd, reader -> buffer + reader -> end,
+                         reader -> size - reader -> end);
+    } while (bytesRead < 0 && errno == EINTR);
+    if (bytesRead < 0)
+    {
+        return MYSTRING_ERROR;
+    }
+    reader -> endOfInput = (bytesRead == 0);
+    reader -> end += bytesRead;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * Complexity is amortized O(n) where n is the length of the line, the delim is found with memchr
+ * (which compares many chars at once).
+ */
+MyStringRetVal myStringLineReaderNext(MyStringLineReader *reader, const char **line,
+                                      unsigned long *length)
+{
+    if (reader == NULL || line == NULL || length == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    while (true)
+    {
+        // chars that were already searched are not searched again after a read
+        char *delim = memchr(reader -> buffer + reader -> searched, reader -> delim,
+                             reader -> end - reader -> searched);
+        if (delim != NULL)
+        {
+            *line = reader -> buffer + reader -> start;
+            *length = delim - *line;
+            reader -> start = delim - reader -> buffer + 1;
+            reader -> searched = reader -> start;
+            return MYSTRING_SUCCESS;
+        }
+        reader -> searched = reader -> end;
+        if (reader -> endOfInput)
+        {
+            if (reader -> start == reader -> end)
+            {
+                return MYSTRING_EOF;
+            }
+            *line = reader -> buffer + reader -> start;
+            *length = reader -> end - reader -> start;
+            reader -> start = reader -> end;
+            return MYSTRING_SUCCESS;
+        }
+        if (fillLineReader(reader) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+    }
+}
+
+/**
+ * @brief Sets result to be the concatenation of str1 and str2.
+ * 	result should be initially allocated by the caller.
+ * 	result shouldn't be the same struct as str1 or str2.
+ *  Time complexity is O(m + k) where m is the length of str1 and k is the length of str2.
+ * @param str1
+ * @param str2
+ * @param result
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringCatTo(const MyString *str1, const MyString *str2, MyString *result)
+{
+    // check whether any struct is null
+    if (str1 == NULL || str2 == NULL || result == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // check that result is not equal to str1 or str2
+    if(result == str1 || result == str2)
+    {
+        return MYSTRING_ERROR;
+    }
+    // save the total size needed for result, and reallocate as needed
+    unsigned long totalSize = myStringLen(str1) + myStringLen(str2);
+    if(reSizeStringArray(result, totalSize) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    result -> stringSize = totalSize;
+    // copy str1 and str2 into the proper spots in result
+    memcpy(result -> stringArray, str1 -> stringArray, myStringLen(str1));
+    memcpy(result -> stringArray + myStringLen(str1), str2 -> stringArray, myStringLen(str2));
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Appends a copy of the source MyString src to the destination MyString dst.
+ *        dest grows in place, so only src is copied. src may be dest itself.
+ *        Time complexity is amortized O(k) where k is the length of src.
+ * @param dest the destination
+ * @param src the MyString to append
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringCat(MyString * dest, const MyString * src)
+{
+    return myStringCatMany(dest, &src, 1);
+}
+
+/**
+ * @brief Appends copies of all the MyStrings in srcs (in order) to dest.
+ *        The total length is computed first so dest is resized at most once. Any of the
+ *        sources may be dest itself, in which case dest's value before the call is appended.
+ *        Time complexity is O(n + k) where n is the amount of sources and k is their total length.
+ * @param dest the destination
+ * @param srcs array of the MyStrings to append
+ * @param n the amount of MyStrings in srcs
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure (dest is left unchanged).
+ */
+MyStringRetVal myStringCatMany(MyString *dest, const MyString * const *srcs, unsigned long n)
+{
+    if (dest == NULL || (srcs == NULL && n != EMPTY))
+    {
+        return MYSTRING_ERROR;
+    }
+    // find the total size needed for dest, sources that are dest add its original length
+    unsigned long destLength = myStringLen(dest);
+    unsigned long totalSize = destLength;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        if (srcs[i] == NULL)
+        {
+            return MYSTRING_ERROR;
+        }
+        totalSize += (srcs[i] == dest) ? destLength : myStringLen(srcs[i]);
+    }
+    if (reSizeStringArray(dest, totalSize) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    // copy every source right after the previous one. This is done after the resize so a source
+    // that is dest is read from its new array (its first destLength chars never overlap the copy)
+    unsigned long position = destLength;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        unsigned long length = (srcs[i] == dest) ? destLength : myStringLen(srcs[i]);
+        memcpy(dest -> stringArray + position, srcs[i] -> stringArray, length);
+        position += length;
+    }
+    dest -> stringSize = totalSize;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyStringBuilder * myStringBuilderCreate()
+{
+    MyStringBuilder *builder = malloc(sizeof(MyStringBuilder));
+    if (builder == NULL)
+    {
+        return NULL;
+    }
+    builder -> slices = malloc(BUILDER_SLICES * sizeof(BuilderSlice));
+    builder -> scratch = malloc(BUILDER_SCRATCH_SIZE);
+    if (builder -> slices == NULL || builder -> scratch == NULL)
+    {
+        myStringBuilderDestroy(builder);
+        return NULL;
+    }
+    builder -> capacity = BUILDER_SLICES;
+    builder -> scratchSize = BUILDER_SCRATCH_SIZE;
+    myStringBuilderReset(builder);
+    return builder;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+void myStringBuilderDestroy(MyStringBuilder *builder)
+{
+    if (builder != NULL)
+    {
+        free(builder -> slices);
+        free(builder -> scratch);
+        free(builder);
+    }
+}
+
+/**
+ * @brief Complexity is O(1). The arrays of the builder are kept for the next pieces.
+ */
+void myStringBuilderReset(MyStringBuilder *builder)
+{
+    if (builder != NULL)
+    {
+        builder -> count = EMPTY;
+        builder -> scratchUsed = EMPTY;
+        builder -> length = EMPTY;
+    }
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+unsigned long myStringBuilderLen(const MyStringBuilder *builder)
+{
+    return (builder == NULL) ? EMPTY : builder -> length;
+}
+
+/**
+ * @brief Makes room for one more slice in a builder, doubling its array if needed.
+ *        Time complexity is O(1) amortized.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal reserveBuilderSlice(MyStringBuilder *builder)
+{
+    if (builder -> count < builder -> capacity)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    BuilderSlice *slices = realloc(builder -> slices,
+                                   2 * builder -> capacity * sizeof(BuilderSlice));
+    if (slices == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    builder -> slices = slices;
+    builder -> capacity *= 2;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Gets room for size chars at the end of the scratch buffer of a builder, doubling it if
+ *        needed. The chars are recorded with addScratchSlice once they are written.
+ *        Time complexity is O(1) amortized.
+ * RETURN VALUE:
+ * @return the room, or NULL on failure.
+ */
+static char * reserveBuilderScratch(MyStringBuilder *builder, unsigned long size)
+{
+    if (builder -> scratchUsed + size > builder -> scratchSize)
+    {
+        unsigned long scratchSize = MAX(2 * builder -> scratchSize, builder -> scratchUsed + size);
+        char *scratch = realloc(builder -> scratch, scratchSize);
+        if (scratch == NULL)
+        {
+            return NULL;
+        }
+        builder -> scratch = scratch;
+        builder -> scratchSize = scratchSize;
+    }
+    return builder -> scratch + builder -> scratchUsed;
+}
+
+/**
+ * @brief Records the length chars written at the end of the scratch buffer of a builder,
+ *        extending the last slice when it ends right before them (like consecutive chars).
+ *        Time complexity is O(1) amortized.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+static MyStringRetVal addScratchSlice(MyStringBuilder *builder, unsigned long length)
+{
+    BuilderSlice *last = (builder -> count == EMPTY) ? NULL :
+                         &builder -> slices[builder -> count - 1];
+    if (last == NULL || last -> chars != NULL ||
+        last -> offset + last -> length != builder -> scratchUsed)
+    {
+        if (reserveBuilderSlice(builder) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+        last = &builder -> slices[builder -> count++];
+        last -> chars = NULL;
+        last -> offset = builder -> scratchUsed;
+        last -> length = EMPTY;
+    }
+    last -> length += length;
+    builder -> scratchUsed += length;
+    builder -> length += length;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(1) amortized. The chars are not copied.
+ */
+MyStringRetVal myStringBuilderAppendView(MyStringBuilder *builder, MyStringView view)
+{
+    if (builder == NULL || reserveBuilderSlice(builder) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    if (view.length != EMPTY)
+    {
+        BuilderSlice *slice = &builder -> slices[builder -> count++];
+        slice -> chars = view.chars;
+        slice -> offset = EMPTY;
+        slice -> length = view.length;
+        builder -> length += view.length;
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(1) amortized. The chars are not copied.
+ */
+MyStringRetVal myStringBuilderAppend(MyStringBuilder *builder, const MyString *str)
+{
+    if (str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return myStringBuilderAppendView(builder, myStringViewOf(str));
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of cString. The chars are not copied.
+ */
+MyStringRetVal myStringBuilderAppendCString(MyStringBuilder *builder, const char *cString)
+{
+    if (cString == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return myStringBuilderAppendView(builder, myStringViewOfCString(cString));
+}
+
+/**
+ * @brief Complexity is O(d) where d is the amount of digits of n.
+ */
+MyStringRetVal myStringBuilderAppendInt(MyStringBuilder *builder, int n)
+{
+    char *room = (builder == NULL) ? NULL : reserveBuilderScratch(builder, INT_STRING_SIZE);
+    if (room == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return addScratchSlice(builder, formatInt(n, room));
+}
+
+/**
+ * @brief Complexity is O(1) amortized.
+ */
+MyStringRetVal myStringBuilderAppendChar(MyStringBuilder *builder, char c)
+{
+    char *room = (builder == NULL) ? NULL : reserveBuilderScratch(builder, sizeof(char));
+    if (room == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    *room = c;
+    return addScratchSlice(builder, sizeof(char));
+}
+
+/**
+ * @brief Copies the pieces of a builder one after the other.
+ *        Time complexity is O(n + k) where n is the amount of pieces and k is their total length.
+ */
+static void copyBuilderSlices(const MyStringBuilder *builder, char *dest)
+{
+    for (unsigned long i = 0; i < builder -> count; i++)
+    {
+        const BuilderSlice *slice = &builder -> slices[i];
+        const char *chars = (slice -> chars == NULL) ? builder -> scratch + slice -> offset :
+                                                       slice -> chars;
+        memcpy(dest, chars, slice -> length);
+        dest += slice -> length;
+    }
+}
+
+/**
+ * @brief Complexity is O(n + k) where n is the amount of pieces and k is their total length.
+ */
+MyStringRetVal myStringBuilderFinish(MyStringBuilder *builder, MyString *str)
+{
+    if (builder == NULL || str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // a piece that is str itself would be moved (or changed) by resizing str, so it is built in
+    // another MyString first
+    const char *chars = str -> stringArray;
+    for (unsigned long i = 0; i < builder -> count; i++)
+    {
+        const BuilderSlice *slice = &builder -> slices[i];
+        if (slice -> chars != NULL && slice -> chars < chars + myStringRealSize(str) &&
+            slice -> chars + slice -> length > chars)
+        {
+            MyString *temp = myStringAlloc();
+            MyStringRetVal result = myStringBuilderFinish(builder, temp);
+            if (result == MYSTRING_SUCCESS)
+            {
+                result = myStringSetFromMyString(str, temp);
+            }
+            myStringFree(temp);
+            return result;
+        }
+    }
+    if (reSizeStringArray(str, builder -> length) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    copyBuilderSlices(builder, str -> stringArray);
+    if (builder -> length == EMPTY)
+    {
+        // an empty string keeps a null byte in its first index (like myStringAlloc)
+        str -> stringArray[FIRST_INDEX] = NULL_BYTE;
+    }
+    str -> stringSize = builder -> length;
+    myStringBuilderReset(builder);
+    return MYSTRING_SUCCESS;
+}
+
+
+/**
+ * @brief sort an array of MyString pointers
+ *        In this sort we use qSort to sort an array of MyString pointers using a comparator.
+ *        However the comparator itself also uses a comparator to compare between individual chars
+ *        in each MyString. Therefore the time complexity of this function is O(n*log(n)*k) where
+ *        n is the length of our MyString pointer array and k is (in the worst case where all the
+ *        MyString lengths are equal) the length of each MyString. This is an average run time
+ *        due to the implementation of quicksort. In worst case it is O(n^2 * k), but we learned in
+ *        data structures that this is unlikely.
+ *        With the default comparator the array is sorted by myStringSort instead.
+ * @param arr
+ * @param len
+ * @param comparator custom comparator
+ *
+ * RETURN VALUE:none
+ */
+void myStringCustomSort(MyString **arr, int len, int (*foo)(const void* str1, const void* str2))
+{
+    // the default order is sorted by the prefix sort, which does not need a comparator
+    if (foo == myStringDefaultCompare)
+    {
+        myStringSort(arr, len);
+        return;
+    }
+    // use the standard qsort function to sort based on the comparator received
+    qsort(arr, len, sizeof(MyString *), foo);
+}
+
+/**
+ * @brief Gets the sort key of the char of a string at a given depth. Keys are ordered like the
+ *        chars are in myStringCompare (as signed chars where char is signed), and the end of the string is smaller
+ *        than any char so a string is smaller than the strings it is a prefix of.
+ *        Time complexity is O(1).
+ * @param str the MyString.
+ * @param depth index of the char.
+ * RETURN VALUE:
+ * @return SORT_KEY_END if str is not longer than depth, the key of the char (1 to 256) otherwise.
+ */
+static unsigned int sortKey(const MyString *str, unsigned long depth)
+{
+    if (depth >= str -> stringSize)
+    {
+        return SORT_KEY_END;
+    }
+    return ((unsigned char) str -> stringArray[depth] ^ SORT_SIGN_BIT) + 1;
+}
+
+/**
+ * @brief Compares two strings like myStringCompare, knowing their first depth chars are equal.
+ *        Time complexity is O(n) where n is the length of the shorter string minus depth.
+ * RETURN VALUE:
+ * @return 0 if equal, 1 if str1 is bigger, -1 if str2 is.
+ */
+static int compareFromDepth(const MyString *str1, const MyString *str2, unsigned long depth)
+{
+    unsigned long minSize = MIN(str1 -> stringSize, str2 -> stringSize);
+    unsigned long mismatch = depth + getCompareKernels() -> mismatch(str1 -> stringArray + depth,
+                                                                     str2 -> stringArray + depth,
+                                                                     minSize - depth);
+    if (mismatch < minSize)
+    {
+        return defCompare(str1 -> stringArray + mismatch, str2 -> stringArray + mismatch);
+    }
+    return (str1 -> stringSize > str2 -> stringSize) - (str1 -> stringSize < str2 -> stringSize);
+}
+
+/**
+ * @brief Stable insertion sort of strings whose first depth chars are equal.
+ *        Time complexity is O(n^2 * k) where n is len and k the length of the strings.
+ */
+static void insertionSortStrings(MyString **arr, unsigned long len, unsigned long depth)
+{
+    for (unsigned long i = 1; i < len; i++)
+    {
+        MyString *str = arr[i];
+        unsigned long j = i;
+        while (j > 0 && compareFromDepth(arr[j - 1], str, depth) > SAME)
+        {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = str;
+    }
+}
+
+/**
+ * @brief Swaps two MyString pointers.
+ */
+static void swapStrings(MyString **str1, MyString **str2)
+{
+    MyString *temp = *str1;
+    *str1 = *str2;
+    *str2 = temp;
+}
+
+/**
+ * @brief Multikey quicksort (Bentley and Sedgewick) of strings whose first depth chars are equal.
+ *        Splits the strings into those whose char at depth is smaller, equal and bigger than the
+ *        pivot's, and goes on to the next char only in the equal part, so every char is looked at
+ *        about log n times instead of once per comparison. Not stable.
+ *        Time complexity is O(n*log(n) + k) on average where n is len and k the length of the
+ *        distinguishing prefixes of all the strings.
+ */
+static void multikeyQuicksort(MyString **arr, unsigned long len, unsigned long depth)
+{
+    while (len >= INSERTION_CUTOFF)
+    {
+        // the pivot is the median of the first, middle and last keys
+        unsigned int first = sortKey(arr[0], depth);
+        unsigned int middle = sortKey(arr[len / 2], depth);
+        unsigned int last = sortKey(arr[len - 1], depth);
+        unsigned int pivot = MAX(MIN(first, middle), MIN(MAX(first, middle), last));
+        unsigned long smaller = 0;
+        unsigned long i = 0;
+        unsigned long bigger = len;
+        while (i < bigger)
+        {
+            unsigned int key = sortKey(arr[i], depth);
+            if (key < pivot)
+            {
+                swapStrings(&arr[smaller++], &arr[i++]);
+            }
+            else if (key > pivot)
+            {
+                swapStrings(&arr[i], &arr[--bigger]);
+            }
+            else
+            {
+                i++;
+            }
+        }
+        multikeyQuicksort(arr, smaller, depth);
+        multikeyQuicksort(arr + bigger, len - bigger, depth);
+        // strings that ended at depth are all equal
+        if (pivot == SORT_KEY_END)
+        {
+            return;
+        }
+        arr += smaller;
+        len = bigger - smaller;
+        depth++;
+    }
+    insertionSortStrings(arr, len, depth);
+}
+
+/**
+ * @brief MSD radix sort of strings whose first depth chars are equal. Distributes the strings
+ *        into a bucket for every char at depth and sorts every bucket on the next char, handing
+ *        buckets below RADIX_CUTOFF strings to a comparison sort. The distribution is stable, so
+ *        the whole sort is stable when the comparison sort is.
+ *        The largest bucket is sorted by the loop instead of a recursive call, so the recursion
+ *        is at most log n deep (every other bucket holds at most half the strings).
+ *        Time complexity is O(n + k) where n is len and k the length of the distinguishing
+ *        prefixes of all the strings, plus that of the comparison sorts.
+ * @param arr the strings.
+ * @param len the amount of strings.
+ * @param depth amount of chars known to be equal.
+ * @param temp buffer of len pointers.
+ * @param keys buffer of len keys.
+ * @param stable true to keep equal strings in their order.
+ */
+static void radixSortStrings(MyString **arr, unsigned long len, unsigned long depth,
+                             MyString **temp, unsigned short *keys, bool stable)
+{
+    while (len >= RADIX_CUTOFF)
+    {
+        unsigned long counts[RADIX_BUCKETS] = {0};
+        // the keys are kept so the strings are only read once per pass
+        for (unsigned long i = 0; i < len; i++)
+        {
+            keys[i] = (unsigned short) sortKey(arr[i], depth);
+            counts[keys[i]]++;
+        }
+        // if every string has the same char there is nothing to move
+        if (counts[keys[0]] == len)
+        {
+            if (keys[0] == SORT_KEY_END)
+            {
+                return;
+            }
+            depth++;
+            continue;
+        }
+        unsigned long starts[RADIX_BUCKETS];
+        unsigned long position = 0;
+        unsigned int largest = SORT_KEY_END + 1;
+        for (unsigned int bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+        {
+            starts[bucket] = position;
+            position += counts[bucket];
+            if (bucket > SORT_KEY_END && counts[bucket] > counts[largest])
+            {
+                largest = bucket;
+            }
+        }
+        for (unsigned long i = 0; i < len; i++)
+        {
+            temp[starts[keys[i]]++] = arr[i];
+        }
+        memcpy(arr, temp, len * sizeof(MyString *));
+        // starts now holds where every bucket ends. Strings that ended are all equal, so they
+        // stay as they are
+        for (unsigned int bucket = SORT_KEY_END + 1; bucket < RADIX_BUCKETS; bucket++)
+        {
+            if (bucket != largest && counts[bucket] > 1)
+            {
+                radixSortStrings(arr + starts[bucket] - counts[bucket], counts[bucket], depth + 1,
+                                 temp, keys, stable);
+            }
+        }
+        arr += starts[largest] - counts[largest];
+        len = counts[largest];
+        depth++;
+    }
+    if (stable)
+    {
+        insertionSortStrings(arr, len, depth);
+    }
+    else
+    {
+        multikeyQuicksort(arr, len, depth);
+    }
+}
+
+/**
+ * @brief Builds the sort record of a string.
+ *        Time complexity is O(1).
+ */
+static SortRecord buildSortRecord(MyString *str)
+{
+    SortRecord record = {0, str -> stringSize, str};
+    if (str -> stringSize >= SORT_PREFIX_LENGTH)
+    {
+        // read the prefix at once and put the first char in the highest byte
+        record.prefix = read64(str -> stringArray);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        record.prefix = __builtin_bswap64(record.prefix);
+#endif
+        record.prefix ^= SORT_SIGN_BIT * 0x0101010101010101ULL;
+        return record;
+    }
+    for (unsigned long i = 0; i < SORT_PREFIX_LENGTH; i++)
+    {
+        unsigned char key = (i < str -> stringSize) ?
+                            (unsigned char) str -> stringArray[i] ^ SORT_SIGN_BIT : 0;
+        record.prefix = (record.prefix << 8) | key;
+    }
+    return record;
+}
+
+/**
+ * @brief Gets a digit of the radix sort of records: one of the bytes of the prefix, or after
+ *        them the length capped at SORT_PREFIX_LENGTH. Two strings whose prefixes are equal and
+ *        one of which is shorter than SORT_PREFIX_LENGTH are ordered by their lengths (the
+ *        missing chars of the shorter one were 0 like the chars of the longer one, so it is a
+ *        prefix of the longer one).
+ *        Time complexity is O(1).
+ */
+static unsigned int recordDigit(const SortRecord *record, unsigned int digit)
+{
+    if (digit < SORT_PREFIX_LENGTH)
+    {
+        return (unsigned int) (record -> prefix >> (8 * (SORT_PREFIX_LENGTH - 1 - digit))) & 0xFF;
+    }
+    return MIN(record -> length, SORT_PREFIX_LENGTH);
+}
+
+/**
+ * @brief Compares two records like myStringCompare compares their strings, reading the strings
+ *        only when the prefixes and capped lengths are equal.
+ *        Time complexity is O(1), or O(n) when the strings are read where n is the length of the
+ *        shorter one.
+ */
+static int compareRecords(const SortRecord *record1, const SortRecord *record2)
+{
+    if (record1 -> prefix != record2 -> prefix)
+    {
+        return (record1 -> prefix > record2 -> prefix) ? BIGGER : SMALLER;
+    }
+    unsigned long length1 = MIN(record1 -> length, SORT_PREFIX_LENGTH);
+    unsigned long length2 = MIN(record2 -> length, SORT_PREFIX_LENGTH);
+    if (length1 != length2)
+    {
+        return (length1 > length2) ? BIGGER : SMALLER;
+    }
+    if (length1 < SORT_PREFIX_LENGTH)
+    {
+        return SAME;
+    }
+    return compareFromDepth(record1 -> str, record2 -> str, SORT_PREFIX_LENGTH);
+}
+
+/**
+ * @brief The buffers of the prefix sort.
+ *        Holds a buffer of records the radix sort distributes into.
+ *        Holds the array being sorted, used to sort strings with equal prefixes (the array is
+ *        only filled with the result at the end).
+ *        Holds the buffers of radixSortStrings.
+ */
+typedef struct PrefixSortBuffers
+{
+    SortRecord *temp;
+    MyString **arr;
+    MyString **strings;
+    unsigned short *keys;
+} PrefixSortBuffers;
+
+/**
+ * @brief MSD radix sort of records, one byte of the prefix at a time and then the capped length.
+ *        Buckets below RADIX_CUTOFF records are sorted with an insertion sort comparing whole
+ *        records, and records whose prefixes and capped lengths are all equal are handed to
+ *        radixSortStrings (which reads the strings) from SORT_PREFIX_LENGTH on. Stable when
+ *        stable is true.
+ *        Time complexity is O(n) for the radix passes, where n is len, plus that of
+ *        radixSortStrings for strings with equal prefixes.
+ * @param records the records.
+ * @param len the amount of records.
+ * @param digit amount of digits known to be equal.
+ * @param offset index of the first record in the whole array.
+ * @param buffers the buffers of the sort.
+ * @param stable true to keep equal strings in their order.
+ */
+static void radixSortRecords(SortRecord *records, unsigned long len, unsigned int digit,
+                             unsigned long offset, const PrefixSortBuffers *buffers, bool stable)
+{
+    while (len >= RADIX_CUTOFF && digit <= SORT_PREFIX_LENGTH)
+    {
+        unsigned long counts[RADIX_BUCKETS - 1] = {0};
+        for (unsigned long i = 0; i < len; i++)
+        {
+            counts[recordDigit(&records[i], digit)]++;
+        }
+        if (counts[recordDigit(&records[0], digit)] == len)
+        {
+            digit++;
+            continue;
+        }
+        unsigned long starts[RADIX_BUCKETS - 1];
+        unsigned long position = 0;
+        unsigned int largest = 0;
+        for (unsigned int bucket = 0; bucket < RADIX_BUCKETS - 1; bucket++)
+        {
+            starts[bucket] = position;
+            position += counts[bucket];
+            if (counts[bucket] > counts[largest])
+            {
+                largest = bucket;
+            }
+        }
+        for (unsigned long i = 0; i < len; i++)
+        {
+            buffers -> temp[starts[recordDigit(&records[i], digit)]++] = records[i];
+        }
+        memcpy(records, buffers -> temp, len * sizeof(SortRecord));
+        for (unsigned int bucket = 0; bucket < RADIX_BUCKETS - 1; bucket++)
+        {
+            unsigned long start = starts[bucket] - counts[bucket];
+            if (bucket != largest && counts[bucket] > 1)
+            {
+                radixSortRecords(records + start, counts[bucket], digit + 1, offset + start,
+                                 buffers, stable);
+            }
+        }
+        records += starts[largest] - counts[largest];
+        offset += starts[largest] - counts[largest];
+        len = counts[largest];
+        digit++;
+    }
+    if (digit <= SORT_PREFIX_LENGTH)
+    {
+        for (unsigned long i = 1; i < len; i++)
+        {
+            SortRecord record = records[i];
+            unsigned long j = i;
+            while (j > 0 && compareRecords(&records[j - 1], &record) > SAME)
+            {
+                records[j] = records[j - 1];
+                j--;
+            }
+            records[j] = record;
+        }
+    }
+    else if (len > 1 && records[0].length >= SORT_PREFIX_LENGTH)
+    {
+        // the prefixes are all equal, so the strings have to be read from there on
+        MyString **strings = buffers -> arr + offset;
+        for (unsigned long i = 0; i < len; i++)
+        {
+            strings[i] = records[i].str;
+        }
+        radixSortStrings(strings, len, SORT_PREFIX_LENGTH, buffers -> strings, buffers -> keys,
+                         stable);
+        for (unsigned long i = 0; i < len; i++)
+        {
+            records[i].str = strings[i];
+        }
+    }
+}
+
+/**
+ * @brief Sorts an array of MyString pointers like myStringCompare by sorting records of their
+ *        prefixes, lengths and pointers. The records are next to each other in memory, so most
+ *        comparisons are decided without following the pointers to the strings.
+ *        Time complexity is O(n) for the records, plus that of radixSortStrings for strings
+ *        with equal prefixes.
+ * @param arr
+ * @param len
+ * @param stable true to keep equal strings in their order.
+ * RETURN VALUE:
+ * @return false if the buffers of the sort cannot be allocated (arr is left as it was), true
+ *         otherwise.
+ */
+static bool sortStringsByPrefix(MyString **arr, unsigned long len, bool stable)
+{
+    SortRecord *records = malloc(len * sizeof(SortRecord));
+    PrefixSortBuffers buffers = {malloc(len * sizeof(SortRecord)), arr,
+                                 malloc(len * sizeof(MyString *)),
+                                 malloc(len * sizeof(unsigned short))};
+    bool allocated = (records != NULL && buffers.temp != NULL && buffers.strings != NULL &&
+                      buffers.keys != NULL);
+    if (allocated)
+    {
+        for (unsigned long i = 0; i < len; i++)
+        {
+            records[i] = buildSortRecord(arr[i]);
+        }
+        radixSortRecords(records, len, 0, 0, &buffers, stable);
+        for (unsigned long i = 0; i < len; i++)
+        {
+            arr[i] = records[i].str;
+        }
+    }
+    free(records);
+    free(buffers.temp);
+    free(buffers.strings);
+    free(buffers.keys);
+    return allocated;
+}
+
+/**
+ * @brief Sorts an array of MyString pointers like myStringCompare with the prefix sort.
+ *        If its buffers cannot be allocated, falls back to the radix sort of the pointers, which
+ *        needs less memory, and then to qsort (or to an insertion sort if the sort has to be
+ *        stable).
+ * @param arr
+ * @param len
+ * @param stable true to keep equal strings in their order.
+ */
+static void sortStrings(MyString **arr, int len, bool stable)
+{
+    if (arr == NULL || len <= 1)
+    {
+        return;
+    }
+    if (sortStringsByPrefix(arr, len, stable))
+    {
+        return;
+    }
+    MyString **temp = malloc(len * sizeof(MyString *));
+    unsigned short *keys = malloc(len * sizeof(unsigned short));
+    if (temp == NULL || keys == NULL)
+    {
+        if (stable)
+        {
+            insertionSortStrings(arr, len, EMPTY);
+        }
+        else
+        {
+            qsort(arr, len, sizeof(MyString *), myStringDefaultCompare);
+        }
+    }
+    else
+    {
+        radixSortStrings(arr, len, EMPTY, temp, keys, stable);
+    }
+    free(temp);
+    free(keys);
+}
+
+/**
+ * @brief sorts an array of MyString pointers according to the default 
+ *        comparison (like in myStringCompare).
+ *        Reading the chars directly is much faster than calling a comparator for every
+ *        comparison, so this uses an MSD radix sort. It first sorts records holding the first
+ *        SORT_PREFIX_LENGTH chars of every string, so most strings are only read once, and only
+ *        the strings whose prefixes are equal are sorted on from there (with a multikey quicksort
+ *        for small buckets).
+ *        Time complexity is O(n + k) for the radix passes, where n is len and k the length of the
+ *        distinguishing prefixes of all the strings, plus O(m*log(m)) for every small bucket of
+ *        m strings.
+ * @param arr
+ * @param len
+ *
+ * RETURN VALUE: none
+ */
+void myStringSort(MyString **arr, int len)
+{
+    sortStrings(arr, len, false);
+}
+
+/**
+ * @brief sorts an array of MyString pointers like myStringSort, keeping equal strings in the
+ *        order they had. Small buckets are sorted with an insertion sort.
+ *        Time complexity is that of myStringSort, with O(m^2) for every small bucket of m strings
+ *        (m is less than RADIX_CUTOFF).
+ * @param arr
+ * @param len
+ *
+ * RETURN VALUE: none
+ */
+void myStringSortStable(MyString **arr, int len)
+{
+    sortStrings(arr, len, true);
+}
+
+/**
+ * @brief Compares two strings for the parallel sort.
+ * @param foo the comparator of the sort, NULL for myStringCompare.
+ * RETURN VALUE:
+ * @return the result of the comparator.
+ */
+static int compareForSort(MyString *str1, MyString *str2,
+                          int (*foo)(const void *str1, const void *str2))
+{
+    if (foo == NULL)
+    {
+        return myStringCompare(str1, str2);
+    }
+    return foo(&str1, &str2);
+}
+
+/**
+ * @brief Thread function sorting the chunk of a task.
+ * @param task pointer to the SortTask.
+ * RETURN VALUE:
+ * @return NULL
+ */
+static void * sortChunkTask(void *task)
+{
+    SortTask *sortTask = task;
+    if (sortTask -> foo == NULL)
+    {
+        myStringSort(sortTask -> first, sortTask -> firstLen);
+    }
+    else
+    {
+        myStringCustomSort(sortTask -> first, sortTask -> firstLen, sortTask -> foo);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Finds how many of the first outIndex strings in the merge of two sorted runs come from
+ *        the first run, with a binary search along the merge path. On ties the first run goes
+ *        first, like in mergeTask.
+ *        Time complexity is O(log(n)) comparisons where n is the length of the shorter run.
+ * RETURN VALUE:
+ * @return the amount of strings taken from the first run.
+ */
+static unsigned long splitMerge(const SortTask *task, unsigned long outIndex)
+{
+    unsigned long low = (outIndex > task -> secondLen) ? outIndex - task -> secondLen : 0;
+    unsigned long high = MIN(outIndex, task -> firstLen);
+    while (low < high)
+    {
+        unsigned long middle = low + (high - low) / 2;
+        if (compareForSort(task -> first[middle], task -> second[outIndex - middle - 1],
+                           task -> foo) <= SAME)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Thread function writing a part of the merge of two sorted runs.
+ * @param task pointer to the SortTask.
+ * RETURN VALUE:
+ * @return NULL
+ */
+static void * mergeTask(void *task)
+{
+    SortTask *mergeTask = task;
+    unsigned long i = splitMerge(mergeTask, mergeTask -> outStart);
+    unsigned long j = mergeTask -> outStart - i;
+    for (unsigned long k = mergeTask -> outStart; k < mergeTask -> outEnd; k++)
+    {
+        if (j == mergeTask -> secondLen ||
+            (i < mergeTask -> firstLen &&
+             compareForSort(mergeTask -> first[i], mergeTask -> second[j],
+                            mergeTask -> foo) <= SAME))
+        {
+            mergeTask -> out[k] = mergeTask -> first[i++];
+        }
+        else
+        {
+            mergeTask -> out[k] = mergeTask -> second[j++];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Runs tasks at the same time, each in its own thread, and waits for all of them.
+ *        A task whose thread cannot be created is run in the calling thread.
+ * @param worker the thread function.
+ * @param tasks the tasks.
+ * @param count the amount of tasks.
+ * @param threads buffer of count threads.
+ * @param started buffer of count flags.
+ */
+static void runSortTasks(void * (*worker)(void *), SortTask *tasks, unsigned long count,
+                         pthread_t *threads, bool *started)
+{
+    for (unsigned long i = 1; i < count; i++)
+    {
+        started[i] = (pthread_create(&threads[i], NULL, worker, &tasks[i]) == 0);
+        if (!started[i])
+        {
+            worker(&tasks[i]);
+        }
+    }
+    // the calling thread does the first task instead of waiting
+    worker(&tasks[0]);
+    for (unsigned long i = 1; i < count; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+/**
+ * @brief Sorts with several threads: every thread sorts a chunk, and then the chunks are merged
+ *        in pairs. Every merge is split into parts along its merge path so all the threads keep
+ *        working even in the last rounds with few merges left.
+ *        Time complexity is O((n/t)*log(n) + n*log(t)/t) for n strings and t threads (plus the
+ *        cost of the comparisons).
+ * @param arr
+ * @param len
+ * @param foo the comparator, NULL for the order of myStringCompare.
+ * @param nthreads amount of threads, 0 or less for one per core.
+ */
+static void sortParallel(MyString **arr, unsigned long len,
+                         int (*foo)(const void *str1, const void *str2), int nthreads)
+{
+    if (nthreads <= 0)
+    {
+        nthreads = (int) MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+    }
+    // chunks smaller than PARALLEL_SORT_CHUNK are not worth a thread
+    unsigned long chunks = MIN((unsigned long) nthreads, len / PARALLEL_SORT_CHUNK);
+    MyString **temp = NULL;
+    SortTask *tasks = NULL;
+    unsigned long *bounds = NULL;
+    pthread_t *threads = NULL;
+    bool *started = NULL;
+    if (chunks > 1)
+    {
+        temp = malloc(len * sizeof(MyString *));
+        tasks = malloc((chunks + 1) * sizeof(SortTask));
+        bounds = malloc((chunks + 1) * sizeof(unsigned long));
+        threads = malloc((chunks + 1) * sizeof(pthread_t));
+        started = malloc((chunks + 1) * sizeof(bool));
+    }
+    if (temp == NULL || tasks == NULL || bounds == NULL || threads == NULL || started == NULL)
+    {
+        SortTask task = {arr, len, NULL, 0, NULL, 0, 0, foo};
+        sortChunkTask(&task);
+    }
+    else
+    {
+        for (unsigned long i = 0; i <= chunks; i++)
+        {
+            bounds[i] = len * i / chunks;
+        }
+        for (unsigned long i = 0; i < chunks; i++)
+        {
+            tasks[i] = (SortTask) {arr + bounds[i], bounds[i + 1] - bounds[i], NULL, 0, NULL, 0, 0,
+                                   foo};
+        }
+        runSortTasks(sortChunkTask, tasks, chunks, threads, started);
+        // every round merges the runs in pairs from source to target, so half of them are left
+        MyString **source = arr;
+        MyString **target = temp;
+        for (unsigned long runs = chunks; runs > 1; runs = (runs + 1) / 2)
+        {
+            unsigned long parts = MAX(chunks / (runs / 2), 1);
+            unsigned long count = 0;
+            for (unsigned long run = 0; run < runs; run += 2)
+            {
+                unsigned long start = bounds[run];
+                unsigned long middle = bounds[run + 1];
+                unsigned long end = (run + 2 <= runs) ? bounds[run + 2] : middle;
+                // a run left without a pair is copied as a merge with an empty run
+                unsigned long runParts = (end == middle) ? 1 : parts;
+                for (unsigned long part = 0; part < runParts; part++)
+                {
+                    tasks[count++] = (SortTask) {source + start, middle - start, source + middle,
+                                                 end - middle, target + start,
+                                                 (end - start) * part / runParts,
+                                                 (end - start) * (part + 1) / runParts, foo};
+                }
+                // the merged run starts where its first run did
+                bounds[run / 2] = start;
+            }
+            bounds[(runs + 1) / 2] = len;
+            runSortTasks(mergeTask, tasks, count, threads, started);
+            MyString **swap = source;
+            source = target;
+            target = swap;
+        }
+        if (source != arr)
+        {
+            memcpy(arr, source, len * sizeof(MyString *));
+        }
+    }
+    free(temp);
+    free(tasks);
+    free(bounds);
+    free(threads);
+    free(started);
+}
+
+/**
+ * @brief sorts an array of MyString pointers like myStringSort with several threads.
+ *        Arrays too small to split into chunks of PARALLEL_SORT_CHUNK strings are sorted with
+ *        myStringSort. If the merge buffer cannot be allocated the array is also sorted serially.
+ *        Time complexity is O((n/t)*log(n) + n*log(t)/t) for n strings and t threads.
+ * @param arr
+ * @param len
+ * @param nthreads amount of threads, 0 or less for one per core.
+ *
+ * RETURN VALUE: none
+ */
+void myStringSortParallel(MyString **arr, int len, int nthreads)
+{
+    if (arr == NULL || len <= 1)
+    {
+        return;
+    }
+    sortParallel(arr, len, NULL, nthreads);
+}
+
+/**
+ * @brief sorts an array of MyString pointers like myStringCustomSort with several threads.
+ *        The comparator is called from several threads at once.
+ *        Time complexity is that of myStringSortParallel.
+ * @param arr
+ * @param len
+ * @param comparator custom comparator
+ * @param nthreads amount of threads, 0 or less for one per core.
+ *
+ * RETURN VALUE: none
+ */
+void myStringCustomSortParallel(MyString **arr, int len,
+                                int (*foo)(const void *str1, const void *str2), int nthreads)
+{
+    if (arr == NULL || len <= 1 || foo == NULL)
+    {
+        return;
+    }
+    // the default comparator is merged with myStringCompare directly
+    sortParallel(arr, len, (foo == myStringDefaultCompare) ? NULL : foo, nthreads);
+}
+
+
+/**
+ * @brief Multiplies two 64 bit numbers into a 128 bit result.
+ *        Time complexity is O(1).
+ * @param a first number, set to the low 64 bits of the result.
+ * @param b second number, set to the high 64 bits of the result.
+ */
+static void multiply128(uint64_t *a, uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t result = (__uint128_t) *a * *b;
+    *a = (uint64_t) result;
+    *b = (uint64_t) (result >> 64);
+#else
+    uint64_t aHigh = *a >> 32, aLow = (uint32_t) *a, bHigh = *b >> 32, bLow = (uint32_t) *b;
+    uint64_t highHigh = aHigh * bHigh, highLow = aHigh * bLow;
+    uint64_t lowHigh = aLow * bHigh, lowLow = aLow * bLow;
+    uint64_t middle = highLow + (lowLow >> 32) + (uint32_t) lowHigh;
+    *a = (middle << 32) | (uint32_t) lowLow;
+    *b = highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+#endif
+}
+
+/**
+ * @brief Mixes two 64 bit numbers by folding their 128 bit product.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return the mixed number.
+ */
+static uint64_t hashMix(uint64_t a, uint64_t b)
+{
+    multiply128(&a, &b);
+    return a ^ b;
+}
+
+/**
+ * @brief Hashes an array of chars with wyhash, which reads 16 to 48 chars per step.
+ *        Time complexity is O(n) where n is length.
+ * @param chars the chars to hash.
+ * @param length the amount of chars.
+ * RETURN VALUE:
+ * @return the 64 bit hash.
+ */
+static uint64_t hashChars(const char *chars, unsigned long length)
+{
+    uint64_t seed = hashMix(HASH_SECRET_0, HASH_SECRET_1);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            unsigned long middle = (length >> 3) << 2;
+            a = (read32(chars) << 32) | read32(chars + middle);
+            b = (read32(chars + length - 4) << 32) | read32(chars + length - 4 - middle);
+        }
+        else if (length > 0)
+        {
+            a = ((uint64_t) (unsigned char) chars[0] << 16) |
+                ((uint64_t) (unsigned char) chars[length >> 1] << 8) |
+                (unsigned char) chars[length - 1];
+        }
+    }
+    else
+    {
+        unsigned long left = length;
+        if (left > 48)
+        {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do
+            {
+                seed = hashMix(read64(chars) ^ HASH_SECRET_1, read64(chars + 8) ^ seed);
+                seed1 = hashMix(read64(chars + 16) ^ HASH_SECRET_2, read64(chars + 24) ^ seed1);
+                seed2 = hashMix(read64(chars + 32) ^ HASH_SECRET_3, read64(chars + 40) ^ seed2);
+                chars += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (left > 16)
+        {
+            seed = hashMix(read64(chars) ^ HASH_SECRET_1, read64(chars + 8) ^ seed);
+            chars += 16;
+            left -= 16;
+        }
+        a = read64(chars + left - 16);
+        b = read64(chars + left - 8);
+    }
+    a ^= HASH_SECRET_1;
+    b ^= seed;
+    multiply128(&a, &b);
+    return hashMix(a ^ HASH_SECRET_0 ^ length, b ^ HASH_SECRET_1);
+}
+
+/**
+ * @brief Returns the 64 bit hash of str, computing it only if it is not cached yet. Any function
+ *        that changes str drops the cached hash.
+ *        Time complexity is O(1) when cached, O(n) otherwise where n is the length of str.
+ * @param str the MyString to hash.
+ * RETURN VALUE:
+ * @return the hash of str, or 0 if str is NULL.
+ */
+uint64_t myStringHash(const MyString *str)
+{
+    if (str == NULL)
+    {
+        return NO_HASH;
+    }
+    uint64_t hash = atomic_load_explicit(&((MyString *) str) -> hash, memory_order_relaxed);
+    if (hash == NO_HASH)
+    {
+        hash = myStringViewHash(myStringViewOf(str));
+        atomic_store_explicit(&((MyString *) str) -> hash, hash, memory_order_relaxed);
+    }
+    return hash;
+}
+
+/**
+ * @brief Looks for a string in a pool shard. The caller must hold the shard's lock.
+ *        Time complexity is O(1) on average + O(n) to compare a match of length n.
+ * @param shard the shard to look in.
+ * @param str the string to look for.
+ * @param hash the hash of str.
+ * RETURN VALUE:
+ * @return the slot of the string, or of the empty slot it would be inserted in.
+ */
+static unsigned long findPoolSlot(const PoolShard *shard, const MyString *str, uint64_t hash)
+{
+    unsigned long mask = shard -> capacity - 1;
+    unsigned long slot = (unsigned long) hash & mask;
+    while (shard -> strings[slot] != NULL &&
+           (shard -> hashes[slot] != hash || myStringEqual(shard -> strings[slot], str) == UNEQUAL))
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief Doubles the amount of slots in a pool shard. The caller must hold its write lock.
+ *        Time complexity is O(n) where n is the amount of slots.
+ * @param shard the shard to grow.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success MYSTRING_ERROR on error (the shard is left unchanged)
+ */
+static MyStringRetVal growPoolShard(PoolShard *shard)
+{
+    PoolShard grown = *shard;
+    grown.capacity = shard -> capacity * 2;
+    grown.strings = calloc(grown.capacity, sizeof(MyString *));
+    grown.hashes = malloc(grown.capacity * sizeof(uint64_t));
+    if (grown.strings == NULL || grown.hashes == NULL)
+    {
+        free(grown.strings);
+        free(grown.hashes);
+        return MYSTRING_ERROR;
+    }
+    for (unsigned long i = 0; i < shard -> capacity; i++)
+    {
+        if (shard -> strings[i] != NULL)
+        {
+            unsigned long slot = findPoolSlot(&grown, shard -> strings[i], shard -> hashes[i]);
+            grown.strings[slot] = shard -> strings[i];
+            grown.hashes[slot] = shard -> hashes[i];
+        }
+    }
+    free(shard -> strings);
+    free(shard -> hashes);
+    shard -> strings = grown.strings;
+    shard -> hashes = grown.hashes;
+    shard -> capacity = grown.capacity;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Creates a new, empty MyStringPool.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return a pointer to the new pool, or NULL if the allocation failed.
+ */
+MyStringPool * myStringPoolCreate()
+{
+    MyStringPool *pool = malloc(sizeof(MyStringPool));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+    for (int i = 0; i < POOL_SHARD_COUNT; i++)
+    {
+        PoolShard *shard = &pool -> shards[i];
+        shard -> capacity = POOL_START_CAPACITY;
+        shard -> count = EMPTY;
+        shard -> strings = calloc(POOL_START_CAPACITY, sizeof(MyString *));
+        shard -> hashes = malloc(POOL_START_CAPACITY * sizeof(uint64_t));
+        pthread_rwlock_init(&shard -> lock, NULL);
+        if (shard -> strings == NULL || shard -> hashes == NULL)
+        {
+            // destroy the shards made so far (including this one)
+            for (int j = 0; j <= i; j++)
+            {
+                free(pool -> shards[j].strings);
+                free(pool -> shards[j].hashes);
+                pthread_rwlock_destroy(&pool -> shards[j].lock);
+            }
+            free(pool);
+            return NULL;
+        }
+    }
+    atomic_init(&pool -> lookups, 0);
+    atomic_init(&pool -> hits, 0);
+    atomic_init(&pool -> bytesSaved, 0);
+    return pool;
+}
+
+/**
+ * @brief Frees a MyStringPool and all of its canonical MyStrings.
+ *        Time complexity is O(n) where n is the amount of slots in the pool.
+ * @param pool the pool to free. If it is NULL, no operation is performed.
+ */
+void myStringPoolDestroy(MyStringPool *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < POOL_SHARD_COUNT; i++)
+    {
+        PoolShard *shard = &pool -> shards[i];
+        for (unsigned long j = 0; j < shard -> capacity; j++)
+        {
+            myStringFree(shard -> strings[j]);
+        }
+        free(shard -> strings);
+        free(shard -> hashes);
+        pthread_rwlock_destroy(&shard -> lock);
+    }
+    free(pool);
+}
+
+/**
+ * @brief Returns the canonical MyString with the value of str, adding a clone of str to the
+ *        pool if it has no such string yet. Two interned strings are equal if and only if they
+ *        are the same pointer. Lookups of strings already in the pool only take a read lock
+ *        of one shard, so they run in parallel.
+ *        Time complexity is O(n) on average where n is the length of str.
+ * @param pool the pool to intern in.
+ * @param str the value to intern.
+ * RETURN VALUE:
+ * @return the canonical MyString, or NULL if either argument is NULL or the allocation failed.
+ */
+const MyString * myStringIntern(MyStringPool *pool, const MyString *str)
+{
+    if (pool == NULL || str == NULL)
+    {
+        return NULL;
+    }
+    uint64_t hash = myStringHash(str);
+    // the low bits pick the slot, so use the high bits to pick the shard
+    PoolShard *shard = &pool -> shards[(hash >> 56) % POOL_SHARD_COUNT];
+    atomic_fetch_add_explicit(&pool -> lookups, 1, memory_order_relaxed);
+    pthread_rwlock_rdlock(&shard -> lock);
+    MyString *canonical = shard -> strings[findPoolSlot(shard, str, hash)];
+    pthread_rwlock_unlock(&shard -> lock);
+    if (canonical == NULL)
+    {
+        // look again under the write lock, another thread may have added it meanwhile
+        pthread_rwlock_wrlock(&shard -> lock);
+        unsigned long slot = findPoolSlot(shard, str, hash);
+        canonical = shard -> strings[slot];
+        if (canonical == NULL)
+        {
+            if ((shard -> count + 1) * 4 > shard -> capacity * 3)
+            {
+                if (growPoolShard(shard) == MYSTRING_ERROR)
+                {
+                    pthread_rwlock_unlock(&shard -> lock);
+                    return NULL;
+                }
+                slot = findPoolSlot(shard, str, hash);
+            }
+            canonical = myStringClone(str);
+            if (canonical != NULL)
+            {
+                shard -> strings[slot] = canonical;
+                shard -> hashes[slot] = hash;
+                shard -> count++;
+            }
+            pthread_rwlock_unlock(&shard -> lock);
+            return canonical;
+        }
+        pthread_rwlock_unlock(&shard -> lock);
+    }
+    atomic_fetch_add_explicit(&pool -> hits, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool -> bytesSaved, myStringMemUsage(str), memory_order_relaxed);
+    return canonical;
+}
+
+/**
+ * @brief Gets the statistics of a MyStringPool.
+ *        Time complexity is O(1).
+ * @param pool the pool.
+ * @param stats the statistics to fill.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringPoolGetStats(MyStringPool *pool, MyStringPoolStats *stats)
+{
+    if (pool == NULL || stats == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    stats -> lookups = atomic_load_explicit(&pool -> lookups, memory_order_relaxed);
+    stats -> hits = atomic_load_explicit(&pool -> hits, memory_order_relaxed);
+    stats -> bytesSaved = atomic_load_explicit(&pool -> bytesSaved, memory_order_relaxed);
+    stats -> uniqueStrings = EMPTY;
+    for (int i = 0; i < POOL_SHARD_COUNT; i++)
+    {
+        pthread_rwlock_rdlock(&pool -> shards[i].lock);
+        stats -> uniqueStrings += pool -> shards[i].count;
+        pthread_rwlock_unlock(&pool -> shards[i].lock);
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Finds the slots of a group of control bytes that hold a given control byte.
+ *        Uses a single SSE2 comparison when available.
+ *        Time complexity is O(1).
+ * @param group the first of MAP_GROUP_SIZE control bytes.
+ * @param control the control byte to look for.
+ * RETURN VALUE:
+ * @return a mask with bit i set if group[i] == control.
+ */
+static unsigned int matchControls(const signed char *group, signed char control)
+{
+#ifdef __SSE2__
+    __m128i controls = _mm_loadu_si128((const __m128i *) group);
+    return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(control)));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < MAP_GROUP_SIZE; i++)
+    {
+        mask |= (unsigned int) (group[i] == control) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Finds the slots of a group of control bytes that hold no key (empty or deleted).
+ *        Time complexity is O(1).
+ * @param group the first of MAP_GROUP_SIZE control bytes.
+ * RETURN VALUE:
+ * @return a mask with bit i set if slot i holds no key.
+ */
+static unsigned int matchFree(const signed char *group)
+{
+#ifdef __SSE2__
+    // only the empty and deleted control bytes are negative
+    return (unsigned int) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < MAP_GROUP_SIZE; i++)
+    {
+        mask |= (unsigned int) (group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Gets the index of the lowest set bit of a mask (which must not be 0).
+ */
+static int lowestBit(unsigned int mask)
+{
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief Gets the control byte a key with the given hash has in a MyStringMap.
+ */
+static signed char mapControl(uint64_t hash)
+{
+    return (signed char) (hash & MAP_HASH_BITS);
+}
+
+/**
+ * @brief Gets the group a key with the given hash starts its search at in a MyStringMap.
+ */
+static unsigned long mapFirstGroup(const MyStringMap *map, uint64_t hash)
+{
+    return (unsigned long) (hash >> 7) & (map -> capacity / MAP_GROUP_SIZE - 1);
+}
+
+/**
+ * @brief Gets the next group in the search sequence of a MyStringMap. The n-th step moves n
+ *        groups forward, so every group is visited once (the amount of groups is a power of 2).
+ */
+static unsigned long mapNextGroup(const MyStringMap *map, unsigned long group, unsigned long step)
+{
+    return (group + step) & (map -> capacity / MAP_GROUP_SIZE - 1);
+}
+
+/**
+ * @brief Looks for a key in a MyStringMap.
+ *        Time complexity is O(1) on average + O(n) to compare a match of length n.
+ * @param map the map to look in.
+ * @param key the key to look for.
+ * @param hash the hash of key.
+ * RETURN VALUE:
+ * @return the slot of key, or -1 if it is not in map.
+ */
+static long findMapSlot(const MyStringMap *map, const MyString *key, uint64_t hash)
+{
+    signed char control = mapControl(hash);
+    unsigned long group = mapFirstGroup(map, hash);
+    for (unsigned long step = 1; step <= map -> capacity / MAP_GROUP_SIZE; step++)
+    {
+        const signed char *controls = map -> controls + group * MAP_GROUP_SIZE;
+        for (unsigned int match = matchControls(controls, control); match != 0; match &= match - 1)
+        {
+            unsigned long slot = group * MAP_GROUP_SIZE + lowestBit(match);
+            if (myStringHash(map -> keys[slot]) == hash &&
+                myStringEqual(map -> keys[slot], key) == EQUAL)
+            {
+                return (long) slot;
+            }
+        }
+        // a key is always put in the first group of its sequence with room, so stop at room
+        if (matchControls(controls, MAP_EMPTY) != 0)
+        {
+            return -1;
+        }
+        group = mapNextGroup(map, group, step);
+    }
+    return -1;
+}
+
+/**
+ * @brief Finds the slot a key with the given hash would be put in (the first slot without a
+ *        key in its search sequence).
+ *        Time complexity is O(1) on average.
+ * @param controls the control bytes of the map.
+ * @param map the map (for its capacity).
+ * @param hash the hash of the key.
+ * RETURN VALUE:
+ * @return the slot.
+ */
+static unsigned long findFreeMapSlot(const MyStringMap *map, uint64_t hash)
+{
+    unsigned long group = mapFirstGroup(map, hash);
+    for (unsigned long step = 1; ; step++)
+    {
+        unsigned int match = matchFree(map -> controls + group * MAP_GROUP_SIZE);
+        if (match != 0)
+        {
+            return group * MAP_GROUP_SIZE + lowestBit(match);
+        }
+        group = mapNextGroup(map, group, step);
+    }
+}
+
+/**
+ * @brief Allocates the slots of a MyStringMap, all of them empty.
+ *        Time complexity is O(n) where n is capacity.
+ * @param map the map.
+ * @param capacity the amount of slots.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success MYSTRING_ERROR on error (the map is left unchanged)
+ */
+static MyStringRetVal allocMapSlots(MyStringMap *map, unsigned long capacity)
+{
+    signed char *controls = malloc(capacity);
+    MyString **keys = malloc(capacity * sizeof(MyString *));
+    void **values = malloc(capacity * sizeof(void *));
+    if (controls == NULL || keys == NULL || values == NULL)
+    {
+        free(controls);
+        free(keys);
+        free(values);
+        return MYSTRING_ERROR;
+    }
+    memset(controls, MAP_EMPTY, capacity);
+    map -> controls = controls;
+    map -> keys = keys;
+    map -> values = values;
+    map -> capacity = capacity;
+    map -> tombstones = EMPTY;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Gets rid of the tombstones of a MyStringMap without allocating, by moving every key
+ *        to the first free slot of its search sequence. The keys waiting to be moved are marked
+ *        MAP_DELETED, and a key whose slot is taken by one of them swaps places with it.
+ *        Time complexity is O(n) on average where n is the amount of slots.
+ * @param map the map.
+ */
+static void rehashMapInPlace(MyStringMap *map)
+{
+    // tombstones become empty, and keys are marked as waiting
+    for (unsigned long i = 0; i < map -> capacity; i++)
+    {
+        map -> controls[i] = (map -> controls[i] < 0) ? MAP_EMPTY : MAP_DELETED;
+    }
+    for (unsigned long i = 0; i < map -> capacity; i++)
+    {
+        if (map -> controls[i] != MAP_DELETED)
+        {
+            continue;
+        }
+        uint64_t hash = myStringHash(map -> keys[i]);
+        unsigned long target = findFreeMapSlot(map, hash);
+        // a key already in the right group stays where it is
+        if (target / MAP_GROUP_SIZE == i / MAP_GROUP_SIZE)
+        {
+            map -> controls[i] = mapControl(hash);
+            continue;
+        }
+        MyString *key = map -> keys[i];
+        void *value = map -> values[i];
+        if (map -> controls[target] == MAP_EMPTY)
+        {
+            map -> controls[i] = MAP_EMPTY;
+        }
+        else
+        {
+            // the target holds a waiting key, swap them and handle that key next
+            map -> keys[i] = map -> keys[target];
+            map -> values[i] = map -> values[target];
+            i--;
+        }
+        map -> keys[target] = key;
+        map -> values[target] = value;
+        map -> controls[target] = mapControl(hash);
+    }
+    map -> tombstones = EMPTY;
+}
+
+/**
+ * @brief Makes room in a MyStringMap for one more key. Keeps at most 7/8 of the slots used,
+ *        by rehashing in place when the keys alone fill at most 25/32 of the slots (so the
+ *        tombstones are worth getting rid of) and by doubling the amount of slots otherwise.
+ *        Time complexity is amortized O(1).
+ * @param map the map.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success MYSTRING_ERROR on error
+ */
+static MyStringRetVal reserveMapSlot(MyStringMap *map)
+{
+    if ((map -> count + map -> tombstones + 1) * 8 <= map -> capacity * 7)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    if (map -> count * 32 <= map -> capacity * 25)
+    {
+        rehashMapInPlace(map);
+        return MYSTRING_SUCCESS;
+    }
+    MyStringMap old = *map;
+    if (allocMapSlots(map, old.capacity * 2) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    for (unsigned long i = 0; i < old.capacity; i++)
+    {
+        if (old.controls[i] >= 0)
+        {
+            uint64_t hash = myStringHash(old.keys[i]);
+            unsigned long slot = findFreeMapSlot(map, hash);
+            map -> controls[slot] = mapControl(hash);
+            map -> keys[slot] = old.keys[i];
+            map -> values[slot] = old.values[i];
+        }
+    }
+    free(old.controls);
+    free(old.keys);
+    free(old.values);
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Creates a new, empty MyStringMap.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return a pointer to the new map, or NULL if the allocation failed.
+ */
+MyStringMap * myStringMapCreate()
+{
+    MyStringMap *map = malloc(sizeof(MyStringMap));
+    if (map == NULL)
+    {
+        return NULL;
+    }
+    if (allocMapSlots(map, MAP_GROUP_SIZE) == MYSTRING_ERROR)
+    {
+        free(map);
+        return NULL;
+    }
+    map -> count = EMPTY;
+    return map;
+}
+
+/**
+ * @brief Frees a MyStringMap and its copies of the keys (not the values).
+ *        Time complexity is O(n) where n is the amount of slots in the map.
+ * @param map the map to free. If it is NULL, no operation is performed.
+ */
+void myStringMapDestroy(MyStringMap *map)
+{
+    if (map == NULL)
+    {
+        return;
+    }
+    for (unsigned long i = 0; i < map -> capacity; i++)
+    {
+        if (map -> controls[i] >= 0)
+        {
+            myStringFree(map -> keys[i]);
+        }
+    }
+    free(map -> controls);
+    free(map -> keys);
+    free(map -> values);
+    free(map);
+}
+
+/**
+ * @brief Maps key to value, replacing the value key had before. The map keeps a clone of key.
+ *        Time complexity is amortized O(1) + O(n) to hash and compare a key of length n.
+ * @param map the map.
+ * @param key the key.
+ * @param value the value.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringMapInsert(MyStringMap *map, const MyString *key, void *value)
+{
+    if (map == NULL || key == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    uint64_t hash = myStringHash(key);
+    long slot = findMapSlot(map, key, hash);
+    if (slot >= 0)
+    {
+        map -> values[slot] = value;
+        return MYSTRING_SUCCESS;
+    }
+    if (reserveMapSlot(map) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    MyString *keyClone = myStringClone(key);
+    if (keyClone == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    slot = (long) findFreeMapSlot(map, hash);
+    if (map -> controls[slot] == MAP_DELETED)
+    {
+        map -> tombstones--;
+    }
+    map -> controls[slot] = mapControl(hash);
+    map -> keys[slot] = keyClone;
+    map -> values[slot] = value;
+    map -> count++;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Looks for the value of key in map.
+ *        Time complexity is O(1) on average + O(n) to hash and compare a key of length n.
+ * @param map the map.
+ * @param key the key to look for.
+ * @param value set to the value of key if it is found, may be NULL.
+ * RETURN VALUE:
+ * @return true if key is in map, false otherwise.
+ */
+bool myStringMapFind(const MyStringMap *map, const MyString *key, void **value)
+{
+    if (map == NULL || key == NULL)
+    {
+        return false;
+    }
+    long slot = findMapSlot(map, key, myStringHash(key));
+    if (slot < 0)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = map -> values[slot];
+    }
+    return true;
+}
+
+/**
+ * @brief Removes key (and its value) from map.
+ *        Time complexity is O(1) on average + O(n) to hash and compare a key of length n.
+ * @param map the map.
+ * @param key the key to remove.
+ * RETURN VALUE:
+ * @return true if key was in map, false otherwise.
+ */
+bool myStringMapErase(MyStringMap *map, const MyString *key)
+{
+    if (map == NULL || key == NULL)
+    {
+        return false;
+    }
+    long slot = findMapSlot(map, key, myStringHash(key));
+    if (slot < 0)
+    {
+        return false;
+    }
+    myStringFree(map -> keys[slot]);
+    // searches stop at a group with an empty slot, so the slot can be emptied if its group
+    // already has one. Otherwise it must become a tombstone so searches go on past it
+    const signed char *group = map -> controls + (slot / MAP_GROUP_SIZE) * MAP_GROUP_SIZE;
+    if (matchControls(group, MAP_EMPTY) != 0)
+    {
+        map -> controls[slot] = MAP_EMPTY;
+    }
+    else
+    {
+        map -> controls[slot] = MAP_DELETED;
+        map -> tombstones++;
+    }
+    map -> count--;
+    return true;
+}
+
+/**
+ * @brief Gets the amount of keys in map.
+ *        Time complexity is O(1).
+ * @param map the map.
+ * @return the amount of keys in map, 0 if it is NULL.
+ */
+unsigned long myStringMapSize(const MyStringMap *map)
+{
+    if (map == NULL)
+    {
+        return EMPTY;
+    }
+    return map -> count;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyStringView myStringViewOf(const MyString *str)
+{
+    if (str == NULL)
+    {
+        return myStringViewOfBuffer(NULL, EMPTY);
+    }
+    return myStringViewOfBuffer(str -> stringArray, myStringLen(str));
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of cString.
+ */
+MyStringView myStringViewOfCString(const char *cString)
+{
+    if (cString == NULL)
+    {
+        return myStringViewOfBuffer(NULL, EMPTY);
+    }
+    return myStringViewOfBuffer(cString, getCStringLength(cString));
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyStringView myStringViewOfBuffer(const char *chars, unsigned long length)
+{
+    MyStringView view;
+    view.chars = chars;
+    view.length = (chars == NULL) ? EMPTY : length;
+    return view;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyStringView myStringViewSlice(MyStringView view, unsigned long start, unsigned long length)
+{
+    start = MIN(start, view.length);
+    return myStringViewOfBuffer(view.chars + start, MIN(length, view.length - start));
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of the shorter view.
+ */
+int myStringViewCompare(MyStringView view1, MyStringView view2)
+{
+    unsigned long minSize = MIN(view1.length, view2.length);
+    unsigned long mismatch = findCharsMismatch(view1.chars, view2.chars, minSize);
+    if (mismatch < minSize)
+    {
+        return defCompare(view1.chars + mismatch, view2.chars + mismatch);
+    }
+    if (view1.length == view2.length)
+    {
+        return SAME;
+    }
+    return (view1.length > view2.length) ? BIGGER : SMALLER;
+}
+
+/**
+ * @brief Complexity is O(1) for views of different lengths, O(n) otherwise.
+ */
+int myStringViewEqual(MyStringView view1, MyStringView view2)
+{
+    if (view1.length != view2.length)
+    {
+        return UNEQUAL;
+    }
+    return (findCharsMismatch(view1.chars, view2.chars, view1.length) == view1.length) ?
+           EQUAL : UNEQUAL;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of view.
+ */
+int myStringViewToInt(MyStringView view)
+{
+    int64_t value;
+    if (myStringViewToInt64(view, &value) == MYSTRING_ERROR || value < INT_MIN || value > INT_MAX)
+    {
+        return MYSTR_ERROR_CODE;
+    }
+    return (int) value;
+}
+
+/**
+ * @brief Reads 8 chars as a number whose lowest byte is the first char.
+ *        Time complexity is O(1).
+ */
+static uint64_t readDigitChunk(const char *chars)
+{
+    uint64_t chunk = read64(chars);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    return chunk;
+}
+
+/**
+ * @brief Checks if all 8 chars of a chunk are decimal digits, without looking at them one by one:
+ *        every byte must be 0x30 to 0x39, so its high half is 3 and adding 6 does not carry it.
+ *        Time complexity is O(1).
+ */
+static bool isDigitChunk(uint64_t chunk)
+{
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+/**
+ * @brief Gets the value of a chunk of 8 decimal digits (SWAR): the digits are combined into
+ *        pairs, then the pairs into fours and the fours into the result, each step handling all
+ *        the groups with a single multiplication.
+ *        Time complexity is O(1).
+ */
+static uint64_t parseDigitChunk(uint64_t chunk)
+{
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return chunk & 0xFFFFFFFFULL;
+}
+
+/**
+ * @brief Adds the decimal digits at the start of chars to value, 8 at a time while there are at
+ *        least 8. Only the first MAX_EXACT_DIGITS digits are added, so value never overflows.
+ *        Time complexity is O(d) where d is the amount of digits.
+ * @param chars the chars.
+ * @param length the amount of chars.
+ * @param value the value to add the digits to.
+ * @param digits the amount of digits in value so far, increased by the amount of digits read
+ *        (including the ones that were not added).
+ * RETURN VALUE:
+ * @return the amount of digits at the start of chars.
+ */
+static unsigned long scanDigits(const char *chars, unsigned long length, uint64_t *value,
+                                unsigned long *digits)
+{
+    unsigned long i = 0;
+    while (i + DIGIT_CHUNK_SIZE <= length && *digits + DIGIT_CHUNK_SIZE <= MAX_EXACT_DIGITS)
+    {
+        uint64_t chunk = readDigitChunk(chars + i);
+        if (!isDigitChunk(chunk))
+        {
+            break;
+        }
+        *value = *value * POWERS_OF_10[DIGIT_CHUNK_SIZE] + parseDigitChunk(chunk);
+        *digits += DIGIT_CHUNK_SIZE;
+        i += DIGIT_CHUNK_SIZE;
+    }
+    for (; i < length && isDigitChar(chars[i]); i++)
+    {
+        if (*digits < MAX_EXACT_DIGITS)
+        {
+            *value = *value * 10 + (uint64_t) (chars[i] - CHAR_TO_INT);
+        }
+        (*digits)++;
+    }
+    return i;
+}
+
+/**
+ * @brief Gets the value of chars that are all decimal digits, checking for overflow exactly.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success, MYSTRING_ERROR if a char is not a digit, there are no
+ *         chars or the value does not fit in 64 bits.
+ */
+static MyStringRetVal parseUInt64(const char *chars, unsigned long length, uint64_t *out)
+{
+    // leading zeros do not count towards the digits that fit
+    unsigned long zeros = 0;
+    while (zeros < length && chars[zeros] == ZERO)
+    {
+        zeros++;
+    }
+    uint64_t value = 0;
+    unsigned long digits = 0;
+    unsigned long last = (length - zeros > MAX_EXACT_DIGITS) ? length - 1 : length;
+    if (length == EMPTY || zeros + scanDigits(chars + zeros, last - zeros, &value, &digits) != last)
+    {
+        return MYSTRING_ERROR;
+    }
+    if (last != length)
+    {
+        // a number with one digit more than always fits: check that the last one fits too
+        uint64_t digit = (uint64_t) (chars[last] - CHAR_TO_INT);
+        if (digits != MAX_EXACT_DIGITS || !isDigitChar(chars[last]) ||
+            value > (UINT64_MAX - digit) / 10)
+        {
+            return MYSTRING_ERROR;
+        }
+        value = value * 10 + digit;
+    }
+    *out = value;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of view, with most digits read 8 at a time.
+ */
+MyStringRetVal myStringViewToInt64(MyStringView view, int64_t *out)
+{
+    if (out == NULL || view.length == EMPTY)
+    {
+        return MYSTRING_ERROR;
+    }
+    bool negative = view.chars[FIRST_INDEX] == MINUS;
+    uint64_t magnitude;
+    if (parseUInt64(view.chars + negative, view.length - negative, &magnitude) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    // the most negative number has no positive counterpart, so it is made from its magnitude
+    if (negative && magnitude <= (uint64_t) INT64_MAX + 1)
+    {
+        *out = (magnitude == (uint64_t) INT64_MAX + 1) ? INT64_MIN : -(int64_t) magnitude;
+        return MYSTRING_SUCCESS;
+    }
+    if (!negative && magnitude <= (uint64_t) INT64_MAX)
+    {
+        *out = (int64_t) magnitude;
+        return MYSTRING_SUCCESS;
+    }
+    return MYSTRING_ERROR;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of str.
+ */
+MyStringRetVal myStringToInt64(const MyString *str, int64_t *out)
+{
+    if (str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return myStringViewToInt64(myStringViewOf(str), out);
+}
+
+/**
+ * @brief Checks if chars are a word (like "inf") in any case.
+ *        Time complexity is O(n) where n is the length of the word.
+ */
+static bool isCaseWord(const char *chars, unsigned long length, const char *word)
+{
+    unsigned long i = 0;
+    while (i < length && word[i] != NULL_BYTE && foldCase(chars[i]) == foldCase(word[i]))
+    {
+        i++;
+    }
+    return i == length && word[i] == NULL_BYTE;
+}
+
+/**
+ * @brief Reads a double with strtod, for the numbers the fast path can not get exactly.
+ *        The chars were already checked to be a number with a '.' decimal point, so strtod
+ *        reads all of them in the C locale.
+ *        Time complexity is O(n) where n is length.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure or if the value is too big for
+ *         a double (a value too small for one is rounded to the closest double, like 0).
+ */
+static MyStringRetVal parseDoubleSlow(const char *chars, unsigned long length, double *out)
+{
+    char buffer[DOUBLE_PARSE_BUFFER_SIZE];
+    char *cString = (length < sizeof(buffer)) ? buffer : malloc(length + 1);
+    if (cString == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    memcpy(cString, chars, length);
+    cString[length] = NULL_BYTE;
+    errno = 0;
+    locale_t previous = useCLocale();
+    double value = strtod(cString, NULL);
+    restoreLocale(previous);
+    bool overflow = errno == ERANGE && (value > DBL_MAX || value < -DBL_MAX);
+    if (cString != buffer)
+    {
+        free(cString);
+    }
+    if (overflow)
+    {
+        return MYSTRING_ERROR;
+    }
+    *out = value;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of view. Numbers with at most 15 significant
+ *        digits and a small exponent (most data) are computed exactly with a single double
+ *        multiplication or division (Clinger's fast path), and the rest with strtod.
+ */
+MyStringRetVal myStringViewToDouble(MyStringView view, double *out)
+{
+    if (out == NULL || view.length == EMPTY)
+    {
+        return MYSTRING_ERROR;
+    }
+    const char *chars = view.chars;
+    unsigned long length = view.length;
+    unsigned long i = (chars[FIRST_INDEX] == MINUS || chars[FIRST_INDEX] == PLUS) ? 1 : 0;
+    bool negative = chars[FIRST_INDEX] == MINUS;
+    if (isCaseWord(chars + i, length - i, "inf") || isCaseWord(chars + i, length - i, "infinity") ||
+        isCaseWord(chars + i, length - i, "nan"))
+    {
+        return parseDoubleSlow(chars, length, out);
+    }
+    // the significant digits (up to 19 of them) and the power of 10 to multiply them by
+    uint64_t mantissa = 0;
+    unsigned long digits = 0;
+    unsigned long integerDigits = scanDigits(chars + i, length - i, &mantissa, &digits);
+    i += integerDigits;
+    unsigned long fractionDigits = 0;
+    if (i < length && chars[i] == DECIMAL_POINT)
+    {
+        i++;
+        fractionDigits = scanDigits(chars + i, length - i, &mantissa, &digits);
+        i += fractionDigits;
+    }
+    if (integerDigits + fractionDigits == EMPTY)
+    {
+        return MYSTRING_ERROR;
+    }
+    long exponent = 0;
+    if (i < length && foldCase(chars[i]) == EXPONENT_CHAR)
+    {
+        i++;
+        bool negativeExponent = i < length && chars[i] == MINUS;
+        i += (i < length && (chars[i] == MINUS || chars[i] == PLUS)) ? 1 : 0;
+        unsigned long start = i;
+        for (; i < length && isDigitChar(chars[i]); i++)
+        {
+            // any exponent this big overflows (or underflows) anyway, so stop it from growing
+            exponent = MIN(exponent * 10 + (chars[i] - CHAR_TO_INT), MAX_DECIMAL_EXPONENT);
+        }
+        if (i == start)
+        {
+            return MYSTRING_ERROR;
+        }
+        exponent = negativeExponent ? -exponent : exponent;
+    }
+    if (i != length)
+    {
+        return MYSTRING_ERROR;
+    }
+    exponent -= (long) fractionDigits;
+    // mantissas up to 2^53 are exact doubles, and so are the powers of 10 up to 10^22, so a
+    // single operation on them is rounded correctly
+    if (digits <= MAX_EXACT_DIGITS && mantissa <= MAX_EXACT_MANTISSA)
+    {
+        if (exponent > MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER + MAX_EXACT_DIGITS &&
+            mantissa < MAX_EXACT_MANTISSA / POWERS_OF_10[exponent - MAX_EXACT_POWER])
+        {
+            // move some of the exponent into the mantissa while it stays exact
+            mantissa *= POWERS_OF_10[exponent - MAX_EXACT_POWER];
+            exponent = MAX_EXACT_POWER;
+        }
+        if (mantissa == 0 || (exponent >= -MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER))
+        {
+            double value = (double) mantissa;
+            if (mantissa != 0)
+            {
+                value = (exponent < 0) ? value / EXACT_POWERS_OF_10[-exponent] :
+                                         value * EXACT_POWERS_OF_10[exponent];
+            }
+            *out = negative ? -value : value;
+            return MYSTRING_SUCCESS;
+        }
+    }
+    return parseDoubleSlow(chars, length, out);
+}
+
+/**
+ * @brief Complexity is that of myStringViewToDouble.
+ */
+MyStringRetVal myStringToDouble(const MyString *str, double *out)
+{
+    if (str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    return myStringViewToDouble(myStringViewOf(str), out);
+}
+
+/**
+ * @brief Complexity is O(n + k) where n is the amount of strings and k is their total length.
+ */
+MyStringRetVal myStringToInt64Many(const MyString * const *strs, unsigned long n, int64_t *out,
+                                   bool *valid)
+{
+    if ((strs == NULL || out == NULL) && n != EMPTY)
+    {
+        return MYSTRING_ERROR;
+    }
+    MyStringRetVal result = MYSTRING_SUCCESS;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        bool parsed = myStringToInt64(strs[i], &out[i]) == MYSTRING_SUCCESS;
+        if (!parsed)
+        {
+            out[i] = 0;
+            result = MYSTRING_ERROR;
+        }
+        if (valid != NULL)
+        {
+            valid[i] = parsed;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Complexity is O(n + k) where n is the amount of strings and k is their total length.
+ */
+MyStringRetVal myStringToDoubleMany(const MyString * const *strs, unsigned long n, double *out,
+                                    bool *valid)
+{
+    if ((strs == NULL || out == NULL) && n != EMPTY)
+    {
+        return MYSTRING_ERROR;
+    }
+    MyStringRetVal result = MYSTRING_SUCCESS;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        bool parsed = myStringToDouble(strs[i], &out[i]) == MYSTRING_SUCCESS;
+        if (!parsed)
+        {
+            out[i] = 0;
+            result = MYSTRING_ERROR;
+        }
+        if (valid != NULL)
+        {
+            valid[i] = parsed;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of view.
+ */
+MyStringRetVal myStringViewWrite(MyStringView view, FILE *stream)
+{
+    if (stream == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    if (fwrite(view.chars, sizeof(char), view.length, stream) != view.length)
+    {
+        return MYSTRING_ERROR;
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of view.
+ */
+uint64_t myStringViewHash(MyStringView view)
+{
+    uint64_t hash = hashChars(view.chars, view.length);
+    // NO_HASH marks a missing hash in a MyString, so a string that really hashes to it gets
+    // another value
+    if (hash == NO_HASH)
+    {
+        hash = ~hash;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds the maximal suffix of a needle, ordering the chars as unsigned chars or in
+ *        reverse (Crochemore and Perrin).
+ *        Time complexity is O(m) where m is length.
+ * @param chars the needle, at least 1 char long.
+ * @param reversed whether the chars are ordered in reverse.
+ * @param period set to the period of the maximal suffix.
+ * RETURN VALUE:
+ * @return the index of the maximal suffix.
+ */
+static unsigned long maximalSuffix(const char *chars, unsigned long length, bool reversed,
+                                   unsigned long *period)
+{
+    const unsigned char *needle = (const unsigned char *) chars;
+    // suffix starts one before 0 so suffix + offset wraps around to the first candidate
+    unsigned long suffix = ULONG_MAX;
+    unsigned long candidate = 0;
+    unsigned long offset = 1;
+    *period = 1;
+    while (candidate + offset < length)
+    {
+        unsigned char next = needle[candidate + offset];
+        unsigned char current = needle[suffix + offset];
+        if (reversed ? next > current : next < current)
+        {
+            candidate += offset;
+            offset = 1;
+            *period = candidate - suffix;
+        }
+        else if (next == current)
+        {
+            if (offset != *period)
+            {
+                offset++;
+            }
+            else
+            {
+                candidate += *period;
+                offset = 1;
+            }
+        }
+        else
+        {
+            suffix = candidate++;
+            offset = 1;
+            *period = 1;
+        }
+    }
+    return suffix + 1;
+}
+
+/**
+ * @brief Factors a needle at its critical position for the Two-Way search.
+ *        Time complexity is O(m) where m is the length of needle.
+ * @param needle a view of at least 1 char.
+ */
+static TwoWayNeedle factorNeedle(MyStringView needle)
+{
+    TwoWayNeedle factors = {needle.chars, needle.length, 0, 1, false};
+    unsigned long period;
+    unsigned long reversedPeriod;
+    unsigned long critical = maximalSuffix(needle.chars, needle.length, false, &period);
+    unsigned long reversedCritical = maximalSuffix(needle.chars, needle.length, true,
+                                                   &reversedPeriod);
+    if (reversedCritical > critical)
+    {
+        critical = reversedCritical;
+        period = reversedPeriod;
+    }
+    factors.critical = critical;
+    if (critical + period <= needle.length &&
+        memcmp(needle.chars, needle.chars + period, critical) == 0)
+    {
+        factors.periodic = true;
+        factors.shift = period;
+    }
+    else
+    {
+        unsigned long right = needle.length - critical;
+        factors.shift = ((critical > right) ? critical : right) + 1;
+    }
+    return factors;
+}
+
+/**
+ * @brief Adds an occurrence to the matches of a search.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return true if the search goes on, false if it stops here.
+ */
+static bool addSearchMatch(SearchMatches *matches, unsigned long index)
+{
+    if (matches -> count < matches -> maxIndices)
+    {
+        matches -> indices[matches -> count] = index;
+    }
+    matches -> count++;
+    return !matches -> firstOnly;
+}
+
+/**
+ * @brief Gets a char of text as if text repeated forever, so a cyclic search can read past its
+ *        end. Time complexity is O(1).
+ */
+static inline char cyclicCharAt(const char *text, unsigned long length, unsigned long index)
+{
+    return text[(index < length) ? index : index % length];
+}
+
+/**
+ * @brief Finds the occurrences of a needle that start in [from, to) in a text with the Two-Way
+ *        algorithm, which never compares a char of the text more than twice.
+ *        The text is read as if it repeated forever, so occurrences may wrap around its end.
+ *        Time complexity is O(k + m) where k is to - from and m is the length of the needle.
+ * RETURN VALUE:
+ * @return true if the search stopped at an occurrence, false if it got to the end.
+ */
+static bool twoWaySearch(const TwoWayNeedle *needle, const char *text, unsigned long length,
+                         unsigned long from, unsigned long to, SearchMatches *matches)
+{
+    const char *chars = needle -> chars;
+    unsigned long critical = needle -> critical;
+    // the amount of the needle known to match after shifting by the period of a periodic needle
+    unsigned long memory = 0;
+    unsigned long position = from;
+    while (position < to)
+    {
+        unsigned long right = (critical > memory) ? critical : memory;
+        while (right < needle -> length &&
+               chars[right] == cyclicCharAt(text, length, position + right))
+        {
+            right++;
+        }
+        if (right < needle -> length)
+        {
+            position += right - critical + 1;
+            memory = 0;
+            continue;
+        }
+        unsigned long left = critical;
+        while (left > memory && chars[left - 1] == cyclicCharAt(text, length, position + left - 1))
+        {
+            left--;
+        }
+        if (left <= memory && !addSearchMatch(matches, position))
+        {
+            return true;
+        }
+        position += needle -> shift;
+        memory = needle -> periodic ? needle -> length - needle -> shift : 0;
+    }
+    return false;
+}
+
+/**
+ * @brief Checks if the work verifying candidates of a search got too large for the positions
+ *        it passed, so it should switch to Two-Way. Time complexity is O(1).
+ */
+static bool isSearchTooSlow(unsigned long work, unsigned long position)
+{
+    return work > SEARCH_WORK_FACTOR * position + SEARCH_WORK_SLACK;
+}
+
+/**
+ * @brief Finds the occurrences of needle in haystack that do not wrap around its end.
+ *        Candidates are the positions where both the first and the last char of needle match
+ *        (16 positions at a time with SSE2, memchr otherwise), and are verified with memcmp.
+ *        When needle and haystack make that slow (like "aaa...ab" in "aaaa..."), the rest of
+ *        haystack is searched with Two-Way.
+ *        Time complexity is O(n + m) where n is the length of haystack and m of needle.
+ * @param needle a view of at least 1 char, not longer than haystack.
+ * RETURN VALUE:
+ * @return true if the search stopped at an occurrence, false if it got to the end.
+ */
+static bool filterSearch(MyStringView haystack, MyStringView needle, SearchMatches *matches)
+{
+    const char *text = haystack.chars;
+    unsigned long last = needle.length - 1;
+    unsigned long to = haystack.length - last;
+    char firstChar = needle.chars[FIRST_INDEX];
+    char lastChar = needle.chars[last];
+    unsigned long position = 0;
+    unsigned long work = 0;
+#ifdef __SSE2__
+    __m128i firstChars = _mm_set1_epi8(firstChar);
+    __m128i lastChars = _mm_set1_epi8(lastChar);
+    for (; position + SEARCH_BLOCK_SIZE <= to && !isSearchTooSlow(work, position);
+         position += SEARCH_BLOCK_SIZE)
+    {
+        __m128i firstBlock = _mm_loadu_si128((const __m128i *) (text + position));
+        __m128i lastBlock = _mm_loadu_si128((const __m128i *) (text + position + last));
+        unsigned int candidates = (unsigned int) _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(firstBlock, firstChars),
+                          _mm_cmpeq_epi8(lastBlock, lastChars)));
+        while (candidates != 0)
+        {
+            unsigned long candidate = position + __builtin_ctz(candidates);
+            if (memcmp(text + candidate + 1, needle.chars + 1, last) == 0 &&
+                !addSearchMatch(matches, candidate))
+            {
+                return true;
+            }
+            work += needle.length;
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+    while (position < to && !isSearchTooSlow(work, position))
+    {
+        const char *candidate = memchr(text + position, firstChar, to - position);
+        if (candidate == NULL)
+        {
+            return false;
+        }
+        position = (unsigned long) (candidate - text);
+        if (candidate[last] == lastChar && memcmp(candidate + 1, needle.chars + 1, last) == 0 &&
+            !addSearchMatch(matches, position))
+        {
+            return true;
+        }
+        work += needle.length;
+        position++;
+    }
+    if (position >= to)
+    {
+        return false;
+    }
+    TwoWayNeedle factors = factorNeedle(needle);
+    return twoWaySearch(&factors, text, haystack.length, position, to, matches);
+}
+
+/**
+ * @brief Finds the occurrences of needle in haystack. A cyclic search also finds the
+ *        occurrences that wrap around the end of haystack back to its start (so a needle may be
+ *        longer than haystack), at most one for every index of haystack.
+ *        Occurrences may overlap, and are found in the order of their indices.
+ *        Time complexity is O(n + m) where n is the length of haystack and m of needle.
+ * @param needle a view of at least 1 char.
+ */
+static void searchView(MyStringView haystack, MyStringView needle, bool cyclic,
+                       SearchMatches *matches)
+{
+    if (haystack.length == EMPTY)
+    {
+        return;
+    }
+    if (needle.length <= haystack.length && filterSearch(haystack, needle, matches))
+    {
+        return;
+    }
+    if (cyclic)
+    {
+        unsigned long wrapStart = (needle.length <= haystack.length) ?
+                                  haystack.length - needle.length + 1 : 0;
+        if (wrapStart < haystack.length)
+        {
+            TwoWayNeedle factors = factorNeedle(needle);
+            twoWaySearch(&factors, haystack.chars, haystack.length, wrapStart, haystack.length,
+                         matches);
+        }
+    }
+}
+
+/**
+ * @brief Complexity is O(n + m) where n is the length of haystack and m of needle. Candidates
+ *        are filtered by the first and last chars of needle, and Two-Way keeps the worst case
+ *        linear.
+ */
+bool myStringViewFind(MyStringView haystack, MyStringView needle, unsigned long *index)
+{
+    unsigned long found = EMPTY;
+    if (needle.length != EMPTY)
+    {
+        SearchMatches matches = {&found, 1, 0, true};
+        searchView(haystack, needle, false, &matches);
+        if (matches.count == 0)
+        {
+            return false;
+        }
+    }
+    if (index != NULL)
+    {
+        *index = found;
+    }
+    return true;
+}
+
+/**
+ * @brief Complexity is O(n + m) where n is the length of haystack and m of needle.
+ */
+bool myStringFind(const MyString *haystack, const MyString *needle, unsigned long *index)
+{
+    if (haystack == NULL || needle == NULL)
+    {
+        return false;
+    }
+    return myStringViewFind(myStringViewOf(haystack), myStringViewOf(needle), index);
+}
+
+/**
+ * @brief Complexity is O(n + m) where n is the length of haystack and m of needle.
+ */
+unsigned long myStringFindAll(const MyString *haystack, const MyString *needle, bool cyclic,
+                              unsigned long *indices, unsigned long maxIndices)
+{
+    if (haystack == NULL || needle == NULL || myStringLen(needle) == EMPTY)
+    {
+        return EMPTY;
+    }
+    SearchMatches matches = {indices, (indices == NULL) ? 0 : maxIndices, 0, false};
+    searchView(myStringViewOf(haystack), myStringViewOf(needle), cyclic, &matches);
+    return matches.count;
+}
+
+/**
+ * @brief Complexity is O(n + m) where n is the length of haystack and m of needle.
+ */
+unsigned long myStringCount(const MyString *haystack, const MyString *needle, bool cyclic)
+{
+    return myStringFindAll(haystack, needle, cyclic, NULL, 0);
+}
+
+/**
+ * @brief Adds a pattern to the trie a matcher is built from, chaining it before the patterns
+ *        that already end at its node.
+ *        Time complexity is O(m * k) where m is the length of pattern and k the most children a
+ *        node on its path has.
+ * @param trie the trie, with room for every new node.
+ * @param trieSize the amount of nodes in trie, raised by the new nodes.
+ * @param nextPattern the chains of patterns ending at the same node.
+ */
+static void addTriePattern(TrieNode *trie, unsigned long *trieSize, uint32_t *nextPattern,
+                           MyStringView pattern, uint32_t index)
+{
+    uint32_t node = MATCHER_ROOT;
+    for (unsigned long i = 0; i < pattern.length; i++)
+    {
+        unsigned char c = (unsigned char) pattern.chars[i];
+        uint32_t *link = &trie[node].firstChild;
+        while (*link != NO_MATCHER_NODE && trie[*link].c < c)
+        {
+            link = &trie[*link].nextSibling;
+        }
+        if (*link == NO_MATCHER_NODE || trie[*link].c != c)
+        {
+            uint32_t child = (uint32_t) (*trieSize)++;
+            trie[child] = (TrieNode) {NO_MATCHER_NODE, *link, NO_MATCHER_NODE, c};
+            *link = child;
+        }
+        node = *link;
+    }
+    nextPattern[index] = trie[node].pattern;
+    trie[node].pattern = index;
+}
+
+/**
+ * @brief Copies a trie into the nodes and edges of a matcher, numbering the nodes in breadth
+ *        first order. The children of a node are queued together, so its edges point to
+ *        consecutive nodes.
+ *        Time complexity is O(k) where k is the amount of nodes.
+ * @param order room for the trie index of every node.
+ */
+static void layOutMatcher(MyStringMatcher *matcher, const TrieNode *trie, uint32_t *order)
+{
+    uint32_t queued = 1;
+    uint32_t edges = 0;
+    order[MATCHER_ROOT] = MATCHER_ROOT;
+    for (uint32_t i = 0; i < matcher -> nodeCount; i++)
+    {
+        const TrieNode *trieNode = &trie[order[i]];
+        matcher -> nodes[i] = (MatcherNode) {edges, 0, MATCHER_ROOT, NO_MATCHER_NODE,
+                                             trieNode -> pattern};
+        for (uint32_t child = trieNode -> firstChild; child != NO_MATCHER_NODE;
+             child = trie[child].nextSibling)
+        {
+            matcher -> edgeChars[edges] = trie[child].c;
+            matcher -> edgeTargets[edges] = queued;
+            order[queued++] = child;
+            edges++;
+            matcher -> nodes[i].edgeCount++;
+        }
+    }
+}
+
+/**
+ * @brief Finds the edge of a char among the sorted edge chars of a node: 16 edges at a time
+ *        with SSE2, otherwise one at a time for a few edges and with a binary search for more.
+ *        Time complexity is O(k) where k is count (O(log k) without SSE2).
+ * @param chars the edge chars, readable for MATCHER_EDGE_BLOCK chars past the last one.
+ * RETURN VALUE:
+ * @return the index of the edge, or NO_MATCHER_NODE if there is none.
+ */
+static uint32_t findMatcherEdge(const unsigned char *chars, uint32_t count, unsigned char c)
+{
+#ifdef __SSE2__
+    __m128i wanted = _mm_set1_epi8((char) c);
+    for (uint32_t i = 0; i < count; i += MATCHER_EDGE_BLOCK)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *) (chars + i));
+        unsigned int found = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(block, wanted));
+        if (count - i < MATCHER_EDGE_BLOCK)
+        {
+            // the chars past the last edge belong to other nodes
+            found &= (1u << (count - i)) - 1;
+        }
+        if (found != 0)
+        {
+            return i + __builtin_ctz(found);
+        }
+    }
+    return NO_MATCHER_NODE;
+#else
+    if (count <= MATCHER_LINEAR_EDGES)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (chars[i] == c)
+            {
+                return i;
+            }
+        }
+        return NO_MATCHER_NODE;
+    }
+    uint32_t low = 0;
+    uint32_t high = count;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        if (chars[middle] < c)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return (low < count && chars[low] == c) ? low : NO_MATCHER_NODE;
+#endif
+}
+
+/**
+ * @brief Moves a matcher from a node by a char, following failure nodes until one has an edge
+ *        for it (the root has one for every char).
+ *        Time complexity is O(d) where d is the depth of node, but O(1) amortized over a scan.
+ * RETURN VALUE:
+ * @return the node of the longest suffix of the chars scanned so far.
+ */
+static uint32_t stepMatcher(const MyStringMatcher *matcher, uint32_t node, unsigned char c)
+{
+    while (node != MATCHER_ROOT)
+    {
+        const MatcherNode *current = &matcher -> nodes[node];
+        uint32_t edge = findMatcherEdge(matcher -> edgeChars + current -> firstEdge,
+                                        current -> edgeCount, c);
+        if (edge != NO_MATCHER_NODE)
+        {
+            return matcher -> edgeTargets[current -> firstEdge + edge];
+        }
+        node = current -> fail;
+    }
+    return matcher -> rootEdges[c];
+}
+
+/**
+ * @brief Sets the root edges and the failure and output node of every node of a matcher.
+ *        Nodes are visited in breadth first order, so the failure chain of a node is done
+ *        before the node.
+ *        Time complexity is O(k) amortized where k is the total length of the patterns.
+ */
+static void linkMatcher(MyStringMatcher *matcher)
+{
+    MatcherNode *nodes = matcher -> nodes;
+    for (int c = 0; c <= UCHAR_MAX; c++)
+    {
+        matcher -> rootEdges[c] = MATCHER_ROOT;
+    }
+    for (uint32_t edge = 0; edge < nodes[MATCHER_ROOT].edgeCount; edge++)
+    {
+        matcher -> rootEdges[matcher -> edgeChars[edge]] = matcher -> edgeTargets[edge];
+    }
+    for (uint32_t node = 0; node < matcher -> nodeCount; node++)
+    {
+        for (uint32_t edge = nodes[node].firstEdge;
+             edge < nodes[node].firstEdge + nodes[node].edgeCount; edge++)
+        {
+            uint32_t child = matcher -> edgeTargets[edge];
+            nodes[child].fail = (node == MATCHER_ROOT) ? MATCHER_ROOT :
+                                stepMatcher(matcher, nodes[node].fail, matcher -> edgeChars[edge]);
+            nodes[child].output = (nodes[child].pattern != NO_MATCHER_NODE) ? child :
+                                  nodes[nodes[child].fail].output;
+        }
+    }
+}
+
+/**
+ * @brief Complexity is O(k) where k is the total length of the patterns (times the most
+ *        children a node has, while building the trie).
+ */
+MyStringMatcher * myStringMatcherCreate(const MyString * const *patterns, unsigned long n)
+{
+    if (patterns == NULL && n != EMPTY)
+    {
+        return NULL;
+    }
+    unsigned long maxNodes = 1;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        if (patterns[i] == NULL)
+        {
+            return NULL;
+        }
+        maxNodes += myStringLen(patterns[i]);
+    }
+    if (maxNodes >= NO_MATCHER_NODE || n >= NO_MATCHER_NODE)
+    {
+        return NULL;
+    }
+    MyStringMatcher *matcher = calloc(1, sizeof(MyStringMatcher));
+    TrieNode *trie = malloc(maxNodes * sizeof(TrieNode));
+    if (matcher == NULL || trie == NULL)
+    {
+        free(matcher);
+        free(trie);
+        return NULL;
+    }
+    matcher -> patternCount = n;
+    matcher -> nextPattern = malloc((n + 1) * sizeof(uint32_t));
+    matcher -> patternLengths = malloc((n + 1) * sizeof(unsigned long));
+    if (matcher -> nextPattern == NULL || matcher -> patternLengths == NULL)
+    {
+        free(trie);
+        myStringMatcherDestroy(matcher);
+        return NULL;
+    }
+    trie[MATCHER_ROOT] = (TrieNode) {NO_MATCHER_NODE, NO_MATCHER_NODE, NO_MATCHER_NODE, 0};
+    unsigned long trieSize = 1;
+    // patterns are added from the last, so the ones ending at the same node are chained in order
+    for (unsigned long i = n; i-- > 0;)
+    {
+        matcher -> patternLengths[i] = myStringLen(patterns[i]);
+        matcher -> nextPattern[i] = NO_MATCHER_NODE;
+        if (matcher -> patternLengths[i] != EMPTY)
+        {
+            addTriePattern(trie, &trieSize, matcher -> nextPattern, myStringViewOf(patterns[i]),
+                           (uint32_t) i);
+        }
+    }
+    matcher -> nodeCount = trieSize;
+    matcher -> nodes = malloc(trieSize * sizeof(MatcherNode));
+    matcher -> edgeChars = calloc(trieSize + MATCHER_EDGE_BLOCK, 1);
+    matcher -> edgeTargets = malloc(trieSize * sizeof(uint32_t));
+    uint32_t *order = malloc(trieSize * sizeof(uint32_t));
+    if (matcher -> nodes == NULL || matcher -> edgeChars == NULL ||
+        matcher -> edgeTargets == NULL || order == NULL)
+    {
+        free(trie);
+        free(order);
+        myStringMatcherDestroy(matcher);
+        return NULL;
+    }
+    layOutMatcher(matcher, trie, order);
+    linkMatcher(matcher);
+    free(trie);
+    free(order);
+    return matcher;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+void myStringMatcherDestroy(MyStringMatcher *matcher)
+{
+    if (matcher == NULL)
+    {
+        return;
+    }
+    free(matcher -> nodes);
+    free(matcher -> edgeChars);
+    free(matcher -> edgeTargets);
+    free(matcher -> nextPattern);
+    free(matcher -> patternLengths);
+    free(matcher);
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyStringMatchState myStringMatcherStart()
+{
+    MyStringMatchState state = {MATCHER_ROOT, 0};
+    return state;
+}
+
+/**
+ * @brief Complexity is O(n + k) where n is the length of chunk and k the amount of occurrences.
+ */
+unsigned long myStringMatcherScan(const MyStringMatcher *matcher, MyStringMatchState *state,
+                                  MyStringView chunk, MyStringMatch *matches,
+                                  unsigned long maxMatches)
+{
+    if (matcher == NULL || state == NULL || (chunk.chars == NULL && chunk.length != EMPTY))
+    {
+        return EMPTY;
+    }
+    if (matches == NULL)
+    {
+        maxMatches = 0;
+    }
+    const MatcherNode *nodes = matcher -> nodes;
+    const unsigned char *chars = (const unsigned char *) chunk.chars;
+    uint32_t node = state -> node;
+    unsigned long count = 0;
+    for (unsigned long i = 0; i < chunk.length; i++)
+    {
+        node = stepMatcher(matcher, node, chars[i]);
+        // every node on the output chain ends patterns that end here
+        for (uint32_t output = nodes[node].output; output != NO_MATCHER_NODE;
+             output = nodes[nodes[output].fail].output)
+        {
+            for (uint32_t pattern = nodes[output].pattern; pattern != NO_MATCHER_NODE;
+                 pattern = matcher -> nextPattern[pattern])
+            {
+                if (count < maxMatches)
+                {
+                    matches[count].pattern = pattern;
+                    matches[count].start = state -> offset + i + 1 -
+                                           matcher -> patternLengths[pattern];
+                }
+                count++;
+            }
+        }
+    }
+    state -> node = node;
+    state -> offset += chunk.length;
+    return count;
+}
+
+/**
+ * @brief Complexity is O(n + k) where n is the length of str and k the amount of occurrences.
+ */
+unsigned long myStringMatcherFind(const MyStringMatcher *matcher, const MyString *str,
+                                  MyStringMatch *matches, unsigned long maxMatches)
+{
+    if (str == NULL)
+    {
+        return EMPTY;
+    }
+    MyStringMatchState state = myStringMatcherStart();
+    return myStringMatcherScan(matcher, &state, myStringViewOf(str), matches, maxMatches);
+}
+
+/**
+ * @brief Gets a char of the text a suffix array is sorted for: a byte of the text itself, or an
+ *        int of the reduced text of a recursive call. Time complexity is O(1).
+ */
+static inline uint32_t suffixCharAt(const unsigned char *bytes, const uint32_t *ints, uint32_t i)
+{
+    return (bytes != NULL) ? bytes[i] : ints[i];
+}
+
+/**
+ * @brief The buckets of the chars of a text being sorted by SA-IS.
+ *        Holds the start of every bucket (and the end of the last one after them).
+ *        Holds the start of the S type suffixes of every bucket (after its L type suffixes).
+ *        Holds the next free slot of every bucket while suffixes are induced.
+ */
+typedef struct SuffixBuckets
+{
+    uint32_t *starts;
+    uint32_t *sStarts;
+    uint32_t *heads;
+    uint32_t count;
+} SuffixBuckets;
+
+/**
+ * @brief The induced sorting step of SA-IS: places the given LMS suffixes in their buckets, then
+ *        induces the order of the L type suffixes from them from left to right, and the order
+ *        of the S type suffixes from right to left.
+ *        Time complexity is O(n + s) where n is the length of the text and s the alphabet size.
+ * @param types whether every suffix is S type (smaller than the suffix after it).
+ * @param lms the LMS suffixes, in the order to place them in.
+ * @param suffixes the suffix array to fill.
+ */
+static void induceSuffixes(const unsigned char *bytes, const uint32_t *ints, uint32_t n,
+                           const bool *types, const uint32_t *lms, uint32_t lmsCount,
+                           SuffixBuckets *buckets, uint32_t *suffixes)
+{
+    uint32_t *heads = buckets -> heads;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        suffixes[i] = NO_SUFFIX;
+    }
+    memcpy(heads, buckets -> sStarts, buckets -> count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < lmsCount; i++)
+    {
+        suffixes[heads[suffixCharAt(bytes, ints, lms[i])]++] = lms[i];
+    }
+    // the last suffix is L type, and comes first in its bucket
+    memcpy(heads, buckets -> starts, buckets -> count * sizeof(uint32_t));
+    suffixes[heads[suffixCharAt(bytes, ints, n - 1)]++] = n - 1;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t suffix = suffixes[i];
+        if (suffix != NO_SUFFIX && suffix != 0 && !types[suffix - 1])
+        {
+            suffixes[heads[suffixCharAt(bytes, ints, suffix - 1)]++] = suffix - 1;
+        }
+    }
+    // S type suffixes are placed from the end of their buckets (the start of the next bucket)
+    memcpy(heads, buckets -> starts, buckets -> count * sizeof(uint32_t));
+    for (uint32_t i = n; i-- > 0;)
+    {
+        uint32_t suffix = suffixes[i];
+        if (suffix != NO_SUFFIX && suffix != 0 && types[suffix - 1])
+        {
+            suffixes[--heads[suffixCharAt(bytes, ints, suffix - 1) + 1]] = suffix - 1;
+        }
+    }
+}
+
+/**
+ * @brief Checks if two LMS substrings (from an LMS suffix to the next one, both included) are
+ *        equal. Time complexity is O(k) where k is their length.
+ * @param leftEnd, rightEnd the starts of the LMS suffixes after them (n for the last one, whose
+ *        substring ends at the end of the text and so equals no other).
+ */
+static bool isSameLmsSubstring(const unsigned char *bytes, const uint32_t *ints, uint32_t n,
+                               uint32_t left, uint32_t leftEnd, uint32_t right,
+                               uint32_t rightEnd)
+{
+    if (leftEnd - left != rightEnd - right || leftEnd == n || rightEnd == n)
+    {
+        return false;
+    }
+    for (; left <= leftEnd; left++, right++)
+    {
+        if (suffixCharAt(bytes, ints, left) != suffixCharAt(bytes, ints, right))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sorts the suffixes of a text with SA-IS (Nong, Zhang and Chan): the LMS substrings are
+ *        sorted by induced sorting, named by their order, and the text of their names is sorted
+ *        recursively (it is at most half as long), which gives the order of the LMS suffixes
+ *        that a last induced sort places every suffix by.
+ *        Time complexity is O(n + s) where n is the length of the text and s the alphabet size.
+ * @param bytes the text when it is made of bytes (NULL when it is made of ints).
+ * @param ints the text when it is made of ints (NULL when it is made of bytes).
+ * @param n the length of the text, at least 1 and less than NO_SUFFIX.
+ * @param upper the largest char of the text.
+ * @param suffixes the array of n suffixes to fill.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success, MYSTRING_ERROR if an allocation failed.
+ */
+static MyStringRetVal sortSuffixes(const unsigned char *bytes, const uint32_t *ints, uint32_t n,
+                                   uint32_t upper, uint32_t *suffixes)
+{
+    if (n <= 2)
+    {
+        bool ordered = n == 1 || suffixCharAt(bytes, ints, 0) < suffixCharAt(bytes, ints, 1);
+        suffixes[0] = ordered ? 0 : 1;
+        suffixes[n - 1] = ordered ? n - 1 : 0;
+        return MYSTRING_SUCCESS;
+    }
+    // every LMS suffix follows an L type one, so there are at most n / 2 of them
+    unsigned long half = n / 2 + 1;
+    SuffixBuckets buckets;
+    buckets.count = upper + 2;
+    uint32_t *work = malloc(((unsigned long) n + 4 * half + 3 * (unsigned long) buckets.count) *
+                            sizeof(uint32_t) + n * sizeof(bool));
+    if (work == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    uint32_t *lmsNames = work;
+    uint32_t *lms = lmsNames + n;
+    uint32_t *sortedLms = lms + half;
+    uint32_t *reduced = sortedLms + half;
+    uint32_t *reducedSuffixes = reduced + half;
+    buckets.starts = reducedSuffixes + half;
+    buckets.sStarts = buckets.starts + buckets.count;
+    buckets.heads = buckets.sStarts + buckets.count;
+    bool *types = (bool *) (buckets.heads + buckets.count);
+    types[n - 1] = false;
+    for (uint32_t i = n - 1; i-- > 0;)
+    {
+        uint32_t c = suffixCharAt(bytes, ints, i);
+        uint32_t next = suffixCharAt(bytes, ints, i + 1);
+        types[i] = (c == next) ? types[i + 1] : c < next;
+    }
+    memset(buckets.starts, 0, 2 * buckets.count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t c = suffixCharAt(bytes, ints, i);
+        if (types[i])
+        {
+            buckets.starts[c + 1]++;
+        }
+        else
+        {
+            buckets.sStarts[c]++;
+        }
+    }
+    for (uint32_t c = 0; c <= upper; c++)
+    {
+        buckets.sStarts[c] += buckets.starts[c];
+        buckets.starts[c + 1] += buckets.sStarts[c];
+    }
+    uint32_t lmsCount = 0;
+    lmsNames[0] = NO_SUFFIX;
+    for (uint32_t i = 1; i < n; i++)
+    {
+        lmsNames[i] = NO_SUFFIX;
+        if (!types[i - 1] && types[i])
+        {
+            lmsNames[i] = lmsCount;
+            lms[lmsCount++] = i;
+        }
+    }
+    induceSuffixes(bytes, ints, n, types, lms, lmsCount, &buckets, suffixes);
+    if (lmsCount != 0)
+    {
+        uint32_t sorted = 0;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (lmsNames[suffixes[i]] != NO_SUFFIX)
+            {
+                sortedLms[sorted++] = suffixes[i];
+            }
+        }
+        // names the LMS substrings by their order, equal substrings getting the same name
+        uint32_t name = 0;
+        reduced[lmsNames[sortedLms[0]]] = 0;
+        for (uint32_t i = 1; i < lmsCount; i++)
+        {
+            uint32_t left = sortedLms[i - 1];
+            uint32_t right = sortedLms[i];
+            uint32_t leftEnd = (lmsNames[left] + 1 < lmsCount) ? lms[lmsNames[left] + 1] : n;
+            uint32_t rightEnd = (lmsNames[right] + 1 < lmsCount) ? lms[lmsNames[right] + 1] : n;
+            if (!isSameLmsSubstring(bytes, ints, n, left, leftEnd, right, rightEnd))
+            {
+                name++;
+            }
+            reduced[lmsNames[right]] = name;
+        }
+        if (name + 1 == lmsCount)
+        {
+            // every name is unique, so the names already order the LMS suffixes
+            for (uint32_t i = 0; i < lmsCount; i++)
+            {
+                reducedSuffixes[reduced[i]] = i;
+            }
+        }
+        else if (sortSuffixes(NULL, reduced, lmsCount, name, reducedSuffixes) == MYSTRING_ERROR)
+        {
+            free(work);
+            return MYSTRING_ERROR;
+        }
+        for (uint32_t i = 0; i < lmsCount; i++)
+        {
+            sortedLms[i] = lms[reducedSuffixes[i]];
+        }
+        induceSuffixes(bytes, ints, n, types, sortedLms, lmsCount, &buckets, suffixes);
+    }
+    free(work);
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Fills an LCP array from a suffix array (Kasai et al.): the common prefix of a suffix
+ *        and the one before it is at most one shorter than that of the suffix starting one
+ *        char before it. Only holds when every suffix of the text is in the array.
+ *        Time complexity is O(n) where n is the length of the text.
+ * @param rank room for n ranks.
+ */
+static void buildSuffixLcp(const char *text, const uint32_t *suffixes, unsigned long n,
+                           uint32_t *rank, uint32_t *lcp)
+{
+    for (unsigned long i = 0; i < n; i++)
+    {
+        rank[suffixes[i]] = (uint32_t) i;
+    }
+    unsigned long common = 0;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        if (rank[i] == 0)
+        {
+            lcp[0] = 0;
+            common = 0;
+            continue;
+        }
+        unsigned long previous = suffixes[rank[i] - 1];
+        while (i + common < n && previous + common < n &&
+               text[i + common] == text[previous + common])
+        {
+            common++;
+        }
+        lcp[rank[i]] = (uint32_t) common;
+        if (common > 0)
+        {
+            common--;
+        }
+    }
+}
+
+/**
+ * @brief Keeps only the suffixes of a cyclic index that start in the first copy of the text
+ *        (which are ordered like the rotations of it), and fills its LCP array from that of
+ *        the doubled text. The common prefix of two kept suffixes is the smallest one between
+ *        them, as far as n chars. Time complexity is O(n) where n is the length of the text.
+ * @param lcp the LCP array of the suffix array of the doubled text.
+ */
+static void keepRotations(MyStringIndex *index, const uint32_t *lcp)
+{
+    unsigned long n = index -> length;
+    unsigned long kept = 0;
+    uint32_t common = (uint32_t) n;
+    for (unsigned long i = 0; i < 2 * n; i++)
+    {
+        if (lcp[i] < common)
+        {
+            common = lcp[i];
+        }
+        if (index -> suffixes[i] < n)
+        {
+            index -> lcp[kept] = (kept == 0) ? 0 : common;
+            index -> suffixes[kept++] = index -> suffixes[i];
+            common = (uint32_t) n;
+        }
+    }
+}
+
+/**
+ * @brief Allocates an index of a text of a given length, with room for a doubled text and
+ *        suffix array when cyclic. Time complexity is O(1).
+ * RETURN VALUE:
+ * @return the new index, or NULL if the text is too long or the allocation failed.
+ */
+static MyStringIndex * allocIndex(unsigned long length, bool cyclic)
+{
+    unsigned long textLength = cyclic ? 2 * length : length;
+    if (textLength >= NO_SUFFIX)
+    {
+        return NULL;
+    }
+    MyStringIndex *index = calloc(1, sizeof(MyStringIndex));
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    index -> length = length;
+    index -> cyclic = cyclic;
+    index -> text = malloc(textLength + 1);
+    index -> suffixes = malloc((textLength + 1) * sizeof(uint32_t));
+    index -> lcp = malloc((length + 1) * sizeof(uint32_t));
+    if (index -> text == NULL || index -> suffixes == NULL || index -> lcp == NULL)
+    {
+        myStringIndexDestroy(index);
+        return NULL;
+    }
+    return index;
+}
+
+/**
+ * @brief Builds the index of str, doubling it when cyclic and then keeping only the suffixes
+ *        that start in its first copy (which are ordered like the rotations of str).
+ *        Time complexity is O(n) where n is the length of str.
+ * RETURN VALUE:
+ * @return the new index, or NULL if str is NULL, too long or the allocation failed.
+ */
+static MyStringIndex * buildIndex(const MyString *str, bool cyclic)
+{
+    if (str == NULL)
+    {
+        return NULL;
+    }
+    unsigned long n = myStringLen(str);
+    MyStringIndex *index = allocIndex(n, cyclic);
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    memcpy(index -> text, str -> stringArray, n);
+    unsigned long textLength = n;
+    if (cyclic)
+    {
+        memcpy(index -> text + n, str -> stringArray, n);
+        textLength = 2 * n;
+    }
+    // the ranks, followed when cyclic by the LCP array of the doubled text. They are allocated
+    // after the suffixes are sorted, so they are not held together with the work of SA-IS
+    uint32_t *rank = NULL;
+    if ((textLength != EMPTY && sortSuffixes((const unsigned char *) index -> text, NULL,
+                                             (uint32_t) textLength, UCHAR_MAX,
+                                             index -> suffixes) == MYSTRING_ERROR) ||
+        (rank = malloc((cyclic ? 2 : 1) * (textLength + 1) * sizeof(uint32_t))) == NULL)
+    {
+        myStringIndexDestroy(index);
+        return NULL;
+    }
+    if (cyclic)
+    {
+        uint32_t *lcp = rank + textLength + 1;
+        buildSuffixLcp(index -> text, index -> suffixes, textLength, rank, lcp);
+        keepRotations(index, lcp);
+        // only the rotations are kept, so the second half of the suffix array is given back
+        uint32_t *suffixes = realloc(index -> suffixes, (n + 1) * sizeof(uint32_t));
+        if (suffixes != NULL)
+        {
+            index -> suffixes = suffixes;
+        }
+    }
+    else
+    {
+        buildSuffixLcp(index -> text, index -> suffixes, textLength, rank, index -> lcp);
+    }
+    free(rank);
+    return index;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of str.
+ */
+MyStringIndex * myStringIndexBuild(const MyString *str)
+{
+    return buildIndex(str, false);
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of str.
+ */
+MyStringIndex * myStringIndexBuildCyclic(const MyString *str)
+{
+    return buildIndex(str, true);
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+void myStringIndexDestroy(MyStringIndex *index)
+{
+    if (index == NULL)
+    {
+        return;
+    }
+    free(index -> text);
+    free(index -> suffixes);
+    free(index -> lcp);
+    free(index);
+}
+
+/**
+ * @brief Turns a needle into the view an index is searched for. In a cyclic index, a needle
+ *        longer than the text occurs where its first n chars do if it repeats every n chars.
+ *        Time complexity is O(m) where m is the length of needle.
+ * RETURN VALUE:
+ * @return the view to search for, or an empty view if needle never occurs.
+ */
+static MyStringView indexNeedle(const MyStringIndex *index, const MyString *needle)
+{
+    MyStringView view = {NULL, 0};
+    if (index == NULL || needle == NULL)
+    {
+        return view;
+    }
+    view = myStringViewOf(needle);
+    if (index -> cyclic && view.length > index -> length)
+    {
+        if (memcmp(view.chars + index -> length, view.chars,
+                   view.length - index -> length) != 0)
+        {
+            view.length = 0;
+        }
+        else
+        {
+            view.length = index -> length;
+        }
+    }
+    return view;
+}
+
+/**
+ * @brief Compares a suffix of an index with needle, only as far as the length of needle.
+ *        Time complexity is O(m) where m is the length of needle.
+ * RETURN VALUE:
+ * @return less than, equal to or greater than 0 if the suffix is before needle, starts with it
+ *         or is after it.
+ */
+static int compareSuffix(const MyStringIndex *index, uint32_t suffix, MyStringView needle)
+{
+    unsigned long available = (index -> cyclic ? 2 * index -> length : index -> length) - suffix;
+    unsigned long length = (available < needle.length) ? available : needle.length;
+    int result = memcmp(index -> text + suffix, needle.chars, length);
+    if (result != 0)
+    {
+        return result;
+    }
+    return (length < needle.length) ? -1 : 0;
+}
+
+/**
+ * @brief Finds the first suffix of an index that is not before needle, or that is after it.
+ *        Time complexity is O(m log n) where m is the length of needle and n of the text.
+ * @param after whether to find the first suffix after needle.
+ */
+static unsigned long findSuffixBound(const MyStringIndex *index, MyStringView needle,
+                                     bool after)
+{
+    unsigned long low = 0;
+    unsigned long high = index -> length;
+    while (low < high)
+    {
+        unsigned long middle = low + (high - low) / 2;
+        int result = compareSuffix(index, index -> suffixes[middle], needle);
+        if (result < 0 || (after && result == 0))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Complexity is O(m log n) where m is the length of needle and n of the text.
+ */
+unsigned long myStringIndexCount(const MyStringIndex *index, const MyString *needle)
+{
+    MyStringView view = indexNeedle(index, needle);
+    if (view.length == EMPTY)
+    {
+        return EMPTY;
+    }
+    return findSuffixBound(index, view, true) - findSuffixBound(index, view, false);
+}
+
+/**
+ * @brief Complexity is O(m log n + k) where m is the length of needle, n of the text and k the
+ *        amount of occurrences.
+ */
+unsigned long myStringIndexLocate(const MyStringIndex *index, const MyString *needle,
+                                  unsigned long *indices, unsigned long maxIndices)
+{
+    MyStringView view = indexNeedle(index, needle);
+    if (view.length == EMPTY)
+    {
+        return EMPTY;
+    }
+    unsigned long first = findSuffixBound(index, view, false);
+    unsigned long last = findSuffixBound(index, view, true);
+    if (indices == NULL)
+    {
+        maxIndices = 0;
+    }
+    unsigned long count = 0;
+    for (unsigned long i = first; i < last; i++)
+    {
+        if (count < maxIndices)
+        {
+            indices[count] = index -> suffixes[i];
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of the text.
+ */
+MyStringRetVal myStringIndexLongestRepeat(const MyStringIndex *index, unsigned long *start,
+                                          unsigned long *length)
+{
+    if (index == NULL || start == NULL || length == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    *start = 0;
+    *length = 0;
+    for (unsigned long i = 1; i < index -> length; i++)
+    {
+        if (index -> lcp[i] > *length)
+        {
+            *start = index -> suffixes[i];
+            *length = index -> lcp[i];
+        }
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of the text.
+ *        The file holds INDEX_MAGIC, INDEX_BYTE_ORDER, whether the index is cyclic, the length
+ *        of the text, the text (once), the suffix array and the LCP array.
+ */
+MyStringRetVal myStringIndexSave(const MyStringIndex *index, FILE *stream)
+{
+    if (index == NULL || stream == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    uint32_t byteOrder = INDEX_BYTE_ORDER;
+    uint8_t cyclic = index -> cyclic;
+    uint64_t length = index -> length;
+    if (fwrite(INDEX_MAGIC, 1, INDEX_MAGIC_SIZE, stream) != INDEX_MAGIC_SIZE ||
+        fwrite(&byteOrder, sizeof(byteOrder), 1, stream) != 1 ||
+        fwrite(&cyclic, sizeof(cyclic), 1, stream) != 1 ||
+        fwrite(&length, sizeof(length), 1, stream) != 1 ||
+        fwrite(index -> text, 1, index -> length, stream) != index -> length ||
+        fwrite(index -> suffixes, sizeof(uint32_t), index -> length, stream) != index -> length ||
+        fwrite(index -> lcp, sizeof(uint32_t), index -> length, stream) != index -> length)
+    {
+        return MYSTRING_ERROR;
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Checks that the suffix array of a loaded index holds every suffix once and that its
+ *        LCP array is in range, so queries never read outside of the text.
+ *        Time complexity is O(n) where n is the length of the text.
+ * RETURN VALUE:
+ * @return true if the arrays are valid, false if they are not or the allocation failed.
+ */
+static bool isValidIndex(const MyStringIndex *index)
+{
+    uint64_t *seen = calloc(index -> length / CHAR_SET_WORD_BITS + 1, sizeof(uint64_t));
+    if (seen == NULL)
+    {
+        return false;
+    }
+    bool valid = true;
+    for (unsigned long i = 0; i < index -> length && valid; i++)
+    {
+        uint32_t suffix = index -> suffixes[i];
+        uint64_t bit = (uint64_t) 1 << (suffix % CHAR_SET_WORD_BITS);
+        valid = suffix < index -> length && index -> lcp[i] <= index -> length &&
+                (seen[suffix / CHAR_SET_WORD_BITS] & bit) == 0;
+        if (valid)
+        {
+            seen[suffix / CHAR_SET_WORD_BITS] |= bit;
+        }
+    }
+    free(seen);
+    return valid;
+}
+
+/**
+ * @brief Reads an array from stream into a buffer that grows as the bytes arrive, so a broken
+ *        size read from the file is never allocated before the file is seen to hold it.
+ *        Time complexity is O(n) where n is size.
+ * @param room bytes the buffer must have after the array.
+ * RETURN VALUE:
+ * @return the buffer, or NULL if the stream ended too soon or the allocation failed.
+ */
+static void * readGrowing(FILE *stream, unsigned long size, unsigned long room)
+{
+    unsigned long capacity = MIN(size, INDEX_LOAD_CHUNK);
+    char *buffer = malloc(capacity + room);
+    unsigned long filled = 0;
+    while (buffer != NULL)
+    {
+        filled += fread(buffer + filled, 1, capacity - filled, stream);
+        if (filled < capacity || filled == size)
+        {
+            break;
+        }
+        capacity = MIN(size, 2 * capacity);
+        char *grown = realloc(buffer, capacity + room);
+        if (grown == NULL)
+        {
+            free(buffer);
+        }
+        buffer = grown;
+    }
+    if (buffer != NULL && filled < size)
+    {
+        free(buffer);
+        return NULL;
+    }
+    return buffer;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of the text.
+ */
+MyStringIndex * myStringIndexLoad(FILE *stream)
+{
+    if (stream == NULL)
+    {
+        return NULL;
+    }
+    char magic[INDEX_MAGIC_SIZE];
+    uint32_t byteOrder;
+    uint8_t cyclic;
+    uint64_t length;
+    if (fread(magic, 1, INDEX_MAGIC_SIZE, stream) != INDEX_MAGIC_SIZE ||
+        memcmp(magic, INDEX_MAGIC, INDEX_MAGIC_SIZE) != 0 ||
+        fread(&byteOrder, sizeof(byteOrder), 1, stream) != 1 || byteOrder != INDEX_BYTE_ORDER ||
+        fread(&cyclic, sizeof(cyclic), 1, stream) != 1 || cyclic > 1 ||
+        fread(&length, sizeof(length), 1, stream) != 1 || length >= NO_SUFFIX ||
+        (cyclic && 2 * length >= NO_SUFFIX))
+    {
+        return NULL;
+    }
+    MyStringIndex *index = calloc(1, sizeof(MyStringIndex));
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    unsigned long n = (unsigned long) length;
+    index -> length = n;
+    index -> cyclic = cyclic;
+    // the arrays get a slot more, like those of a built index
+    if ((index -> text = readGrowing(stream, n, cyclic ? n + 1 : 1)) == NULL ||
+        (index -> suffixes = readGrowing(stream, n * sizeof(uint32_t), sizeof(uint32_t))) == NULL ||
+        (index -> lcp = readGrowing(stream, n * sizeof(uint32_t), sizeof(uint32_t))) == NULL ||
+        !isValidIndex(index))
+    {
+        myStringIndexDestroy(index);
+        return NULL;
+    }
+    if (index -> cyclic)
+    {
+        memcpy(index -> text + n, index -> text, n);
+    }
+    return index;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of view.
+ */
+MyStringRetVal myStringSetFromView(MyString *str, MyStringView view)
+{
+    if (str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    const char *chars = str -> stringArray;
+    if (view.length != EMPTY && view.chars >= chars && view.chars < chars + myStringLen(str))
+    {
+        // a view of str itself: make the array ours without shrinking it, and move the chars to
+        // its start before resizing, since resizing may free the chars the view points to
+        unsigned long offset = (unsigned long) (view.chars - chars);
+        if (reSizeStringArray(str, myStringLen(str)) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+        memmove(str -> stringArray, str -> stringArray + offset, view.length);
+        str -> stringSize = view.length;
+        return reSizeStringArray(str, view.length);
+    }
+    if (reSizeStringArray(str, view.length) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    if (view.length == EMPTY)
+    {
+        // an empty string keeps a null byte in its first index (like myStringAlloc)
+        str -> stringArray[FIRST_INDEX] = NULL_BYTE;
+    }
+    else
+    {
+        memcpy(str -> stringArray, view.chars, view.length);
+    }
+    str -> stringSize = view.length;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Starts a splitter over view.
+ *        Time complexity is O(1).
+ */
+static MyStringSplitter startSplitter(MyStringView view, bool tokenize)
+{
+    MyStringSplitter splitter;
+    memset(&splitter, 0, sizeof(splitter));
+    splitter.next = view.chars;
+    splitter.end = view.chars + view.length;
+    splitter.tokenize = tokenize;
+    splitter.done = false;
+    return splitter;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyStringSplitter myStringSplit(MyStringView view, char delim)
+{
+    MyStringSplitter splitter = startSplitter(view, false);
+    splitter.delim = delim;
+    return splitter;
+}
+
+/**
+ * @brief Complexity is O(m) where m is the length of delims.
+ */
+MyStringSplitter myStringTokenize(MyStringView view, MyStringView delims)
+{
+    MyStringSplitter splitter = startSplitter(view, true);
+    for (unsigned long i = 0; i < delims.length; i++)
+    {
+        myCharSetAdd(&splitter.delims, delims.chars[i]);
+    }
+    return splitter;
+}
+
+/**
+ * @brief Complexity is O(k) where k is the length of the field and the delims before it.
+ *        A split looks for its delim with memchr.
+ */
+bool myStringSplitNext(MyStringSplitter *splitter, MyStringView *field)
+{
+    if (splitter == NULL || field == NULL || splitter -> done)
+    {
+        return false;
+    }
+    const char *start = splitter -> next;
+    const char *end = splitter -> end;
+    if (!splitter -> tokenize)
+    {
+        const char *delim = (start == end) ? NULL :
+                            memchr(start, splitter -> delim, (unsigned long) (end - start));
+        if (delim == NULL)
+        {
+            // the last field ends with the view
+            splitter -> done = true;
+            delim = end;
+        }
+        *field = myStringViewOfBuffer(start, (unsigned long) (delim - start));
+        splitter -> next = delim + (splitter -> done ? 0 : 1);
+        return true;
+    }
+    while (start < end && myCharSetHas(&splitter -> delims, *start))
+    {
+        start++;
+    }
+    if (start == end)
+    {
+        splitter -> done = true;
+        return false;
+    }
+    const char *tokenEnd = start + 1;
+    while (tokenEnd < end && !myCharSetHas(&splitter -> delims, *tokenEnd))
+    {
+        tokenEnd++;
+    }
+    *field = myStringViewOfBuffer(start, (unsigned long) (tokenEnd - start));
+    splitter -> next = tokenEnd;
+    return true;
+}
+
+/**
+ * @brief Takes a reference to a rope node.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return node.
+ */
+static RopeNode * retainRopeNode(RopeNode *node)
+{
+    if (node != NULL)
+    {
+        atomic_fetch_add_explicit(&node -> referenceCount, 1, memory_order_relaxed);
+    }
+    return node;
+}
+
+/**
+ * @brief Drops a reference to a rope node, freeing it and dropping its references to its children
+ *        if it was the last one.
+ *        Time complexity is O(1) while the node is still used, O(k) for k nodes freed.
+ */
+static void releaseRopeNode(RopeNode *node)
+{
+    while (node != NULL &&
+           atomic_fetch_sub_explicit(&node -> referenceCount, 1, memory_order_acq_rel) == 1)
+    {
+        // the tree is balanced, so recursing on one side and looping on the other is shallow
+        RopeNode *right = node -> right;
+        releaseRopeNode(node -> left);
+        myStringFree(node -> str);
+        free(node);
+        node = right;
+    }
+}
+
+/**
+ * @brief Gets the height of a rope node, -1 for an empty rope.
+ *        Time complexity is O(1).
+ */
+static int ropeHeight(const RopeNode *node)
+{
+    return (node == NULL) ? -1 : node -> height;
+}
+
+/**
+ * @brief Gets the chars of a rope leaf.
+ *        Time complexity is O(1).
+ */
+static MyStringView ropeLeafView(const RopeNode *leaf)
+{
+    return myStringViewOfBuffer(leaf -> str -> stringArray + leaf -> offset, leaf -> length);
+}
+
+/**
+ * @brief Builds a rope leaf holding length chars of str starting at offset.
+ *        The leaf takes str, which is freed if the leaf can not be built.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return the new leaf, or NULL on failure.
+ */
+static RopeNode * buildRopeLeaf(MyString *str, unsigned long offset, unsigned long length)
+{
+    RopeNode *leaf = (str == NULL) ? NULL : malloc(sizeof(RopeNode));
+    if (leaf == NULL)
+    {
+        myStringFree(str);
+        return NULL;
+    }
+    atomic_init(&leaf -> referenceCount, 1);
+    leaf -> length = length;
+    leaf -> height = 0;
+    leaf -> left = NULL;
+    leaf -> right = NULL;
+    leaf -> str = str;
+    leaf -> offset = offset;
+    return leaf;
+}
+
+/**
+ * @brief Builds a rope leaf holding some of the chars of another leaf, sharing its array.
+ *        Time complexity is that of myStringClone.
+ * RETURN VALUE:
+ * @return the new leaf, or NULL on failure.
+ */
+static RopeNode * sliceRopeLeaf(const RopeNode *leaf, unsigned long start, unsigned long length)
+{
+    return buildRopeLeaf(myStringClone(leaf -> str), leaf -> offset + start, length);
+}
+
+/**
+ * @brief Builds a rope leaf holding the chars of two leaves.
+ *        Time complexity is O(n) where n is the length of both leaves.
+ * RETURN VALUE:
+ * @return the new leaf, or NULL on failure.
+ */
+static RopeNode * mergeRopeLeaves(const RopeNode *left, const RopeNode *right)
+{
+    unsigned long length = left -> length + right -> length;
+    MyString *str = myStringAlloc();
+    if (str == NULL || reSizeStringArray(str, length) == MYSTRING_ERROR)
+    {
+        myStringFree(str);
+        return NULL;
+    }
+    memcpy(str -> stringArray, ropeLeafView(left).chars, left -> length);
+    memcpy(str -> stringArray + left -> length, ropeLeafView(right).chars, right -> length);
+    str -> stringSize = length;
+    return buildRopeLeaf(str, EMPTY, length);
+}
+
+/**
+ * @brief Builds an inner rope node with two children, taking a reference to each of them.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return the new node, or NULL on failure (or if a child is NULL, which is how the failures
+ *         of building the children get here).
+ */
+static RopeNode * buildRopeNode(RopeNode *left, RopeNode *right)
+{
+    RopeNode *node = (left == NULL || right == NULL) ? NULL : malloc(sizeof(RopeNode));
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    atomic_init(&node -> referenceCount, 1);
+    node -> length = left -> length + right -> length;
+    node -> height = MAX(left -> height, right -> height) + 1;
+    node -> left = retainRopeNode(left);
+    node -> right = retainRopeNode(right);
+    node -> str = NULL;
+    node -> offset = EMPTY;
+    return node;
+}
+
+static RopeNode * joinRope(RopeNode *left, RopeNode *right);
+
+/**
+ * @brief Builds an inner rope node with two children whose heights differ by at most 2,
+ *        rotating them (like in an AVL tree) so the new node is balanced.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return the new node, or NULL on failure.
+ */
+static RopeNode * balanceRope(RopeNode *left, RopeNode *right)
+{
+    if (left == NULL || right == NULL)
+    {
+        return NULL;
+    }
+    int difference = left -> height - right -> height;
+    if (difference > 2 || difference < -2)
+    {
+        // merged leaves can make a side shorter than expected, joining handles any heights
+        return joinRope(left, right);
+    }
+    RopeNode *first = NULL;
+    RopeNode *second = NULL;
+    if (difference == 2 && ropeHeight(left -> left) >= ropeHeight(left -> right))
+    {
+        first = retainRopeNode(left -> left);
+        second = buildRopeNode(left -> right, right);
+    }
+    else if (difference == 2)
+    {
+        RopeNode *pivot = left -> right;
+        first = buildRopeNode(left -> left, pivot -> left);
+        second = buildRopeNode(pivot -> right, right);
+    }
+    else if (difference == -2 && ropeHeight(right -> right) >= ropeHeight(right -> left))
+    {
+        first = buildRopeNode(left, right -> left);
+        second = retainRopeNode(right -> right);
+    }
+    else if (difference == -2)
+    {
+        RopeNode *pivot = right -> left;
+        first = buildRopeNode(left, pivot -> left);
+        second = buildRopeNode(pivot -> right, right -> right);
+    }
+    else
+    {
+        return buildRopeNode(left, right);
+    }
+    RopeNode *node = buildRopeNode(first, second);
+    releaseRopeNode(first);
+    releaseRopeNode(second);
+    return node;
+}
+
+/**
+ * @brief Concatenates two ropes. Neither is changed: the result shares their nodes, going down
+ *        the side of the taller one until the heights match (AVL join).
+ *        Time complexity is O(|h1 - h2| + 1) where h1 and h2 are the heights of the ropes,
+ *        which is O(log n) for ropes with n leaves.
+ * RETURN VALUE:
+ * @return a reference to the concatenation (NULL if both are empty), or NULL on failure.
+ */
+static RopeNode * joinRope(RopeNode *left, RopeNode *right)
+{
+    if (left == NULL || right == NULL)
+    {
+        return retainRopeNode((left == NULL) ? right : left);
+    }
+    // keep the leaves of ropes built from many small fragments from being tiny
+    if (left -> str != NULL && right -> str != NULL &&
+        left -> length + right -> length <= ROPE_MERGE_SIZE)
+    {
+        return mergeRopeLeaves(left, right);
+    }
+    RopeNode *joined;
+    RopeNode *node;
+    if (left -> height > right -> height + 1)
+    {
+        joined = joinRope(left -> right, right);
+        node = balanceRope(left -> left, joined);
+    }
+    else if (right -> height > left -> height + 1)
+    {
+        joined = joinRope(left, right -> left);
+        node = balanceRope(joined, right -> right);
+    }
+    else
+    {
+        return buildRopeNode(left, right);
+    }
+    releaseRopeNode(joined);
+    return node;
+}
+
+/**
+ * @brief Splits a rope into its first index chars and the rest, without changing it.
+ *        Time complexity is O(log n) where n is the amount of leaves.
+ * @param node the rope to split.
+ * @param index the amount of chars to put on the left.
+ * @param left set to a reference to the first index chars (NULL if there are none).
+ * @param right set to a reference to the rest (NULL if there is none).
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure (both are then NULL).
+ */
+static MyStringRetVal splitRope(RopeNode *node, unsigned long index, RopeNode **left,
+                                RopeNode **right)
+{
+    *left = NULL;
+    *right = NULL;
+    if (node == NULL)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    if (index == EMPTY || index >= node -> length)
+    {
+        *((index == EMPTY) ? right : left) = retainRopeNode(node);
+        return MYSTRING_SUCCESS;
+    }
+    RopeNode *rest = NULL;
+    if (node -> str != NULL)
+    {
+        *left = sliceRopeLeaf(node, EMPTY, index);
+        *right = sliceRopeLeaf(node, index, node -> length - index);
+    }
+    else if (index <= node -> left -> length)
+    {
+        if (splitRope(node -> left, index, left, &rest) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+        *right = joinRope(rest, node -> right);
+    }
+    else
+    {
+        if (splitRope(node -> right, index - node -> left -> length, &rest, right) ==
+            MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+        *left = joinRope(node -> left, rest);
+    }
+    releaseRopeNode(rest);
+    if (*left == NULL || *right == NULL)
+    {
+        releaseRopeNode(*left);
+        releaseRopeNode(*right);
+        *left = NULL;
+        *right = NULL;
+        return MYSTRING_ERROR;
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Calls visit with every chunk of a rope in order, until one of the calls fails.
+ *        Time complexity is O(k) calls to visit where k is the amount of leaves.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS if all the calls succeeded, MYSTRING_ERROR otherwise.
+ */
+static MyStringRetVal visitRopeChunks(const RopeNode *node,
+                                      MyStringRetVal (*visit)(MyStringView chunk, void *context),
+                                      void *context)
+{
+    while (node != NULL && node -> str == NULL)
+    {
+        if (visitRopeChunks(node -> left, visit, context) == MYSTRING_ERROR)
+        {
+            return MYSTRING_ERROR;
+        }
+        node = node -> right;
+    }
+    return (node == NULL) ? MYSTRING_SUCCESS : visit(ropeLeafView(node), context);
+}
+
+/**
+ * @brief Builds a rope holding a node, taking the reference to it.
+ *        Time complexity is O(1).
+ * RETURN VALUE:
+ * @return the new rope, or NULL on failure (the node is then released).
+ */
+static MyRope * buildRope(RopeNode *root)
+{
+    MyRope *rope = malloc(sizeof(MyRope));
+    if (rope == NULL)
+    {
+        releaseRopeNode(root);
+        return NULL;
+    }
+    rope -> root = root;
+    return rope;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyRope * myRopeAlloc()
+{
+    return buildRope(NULL);
+}
+
+/**
+ * @brief Complexity is that of myStringClone, which is O(1) for strings on the heap.
+ */
+MyRope * myRopeFromMyString(const MyString *str)
+{
+    if (str == NULL)
+    {
+        return NULL;
+    }
+    if (myStringLen(str) == EMPTY)
+    {
+        return myRopeAlloc();
+    }
+    RopeNode *leaf = buildRopeLeaf(myStringClone(str), EMPTY, myStringLen(str));
+    return (leaf == NULL) ? NULL : buildRope(leaf);
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyRope * myRopeClone(const MyRope *rope)
+{
+    if (rope == NULL)
+    {
+        return NULL;
+    }
+    return buildRope(retainRopeNode(rope -> root));
+}
+
+/**
+ * @brief Complexity is O(k) for the k nodes that are not shared with other ropes.
+ */
+void myRopeFree(MyRope *rope)
+{
+    if (rope != NULL)
+    {
+        releaseRopeNode(rope -> root);
+        free(rope);
+    }
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+unsigned long myRopeLen(const MyRope *rope)
+{
+    return (rope == NULL || rope -> root == NULL) ? EMPTY : rope -> root -> length;
+}
+
+/**
+ * @brief Checks if joining two ropes failed, since joining two empty ropes gives NULL too.
+ *        Time complexity is O(1).
+ */
+static bool joinRopeFailed(const RopeNode *joined, const RopeNode *left, const RopeNode *right)
+{
+    return joined == NULL && (left != NULL || right != NULL);
+}
+
+/**
+ * @brief Replaces the tree of a rope with a new one, unless building the new one failed.
+ *        Time complexity is O(1) + the release of the old tree.
+ * RETURN VALUE:
+ * @return MYSTRING_SUCCESS if root was built, MYSTRING_ERROR otherwise.
+ */
+static MyStringRetVal setRopeRoot(MyRope *rope, RopeNode *root, bool built)
+{
+    if (!built)
+    {
+        return MYSTRING_ERROR;
+    }
+    releaseRopeNode(rope -> root);
+    rope -> root = root;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(log n) where n is the amount of leaves in both ropes.
+ */
+MyStringRetVal myRopeCat(MyRope *rope, const MyRope *other)
+{
+    if (rope == NULL || other == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    RopeNode *root = joinRope(rope -> root, other -> root);
+    return setRopeRoot(rope, root, !joinRopeFailed(root, rope -> root, other -> root));
+}
+
+/**
+ * @brief Complexity is that of myStringClone + O(log n) where n is the amount of leaves.
+ */
+MyStringRetVal myRopeCatMyString(MyRope *rope, const MyString *str)
+{
+    if (rope == NULL || str == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    if (myStringLen(str) == EMPTY)
+    {
+        return MYSTRING_SUCCESS;
+    }
+    RopeNode *leaf = buildRopeLeaf(myStringClone(str), EMPTY, myStringLen(str));
+    if (leaf == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    RopeNode *root = joinRope(rope -> root, leaf);
+    releaseRopeNode(leaf);
+    return setRopeRoot(rope, root, root != NULL);
+}
+
+/**
+ * @brief Complexity is O(log n) where n is the amount of leaves in both ropes.
+ */
+MyStringRetVal myRopeInsert(MyRope *rope, unsigned long index, const MyRope *other)
+{
+    if (rope == NULL || other == NULL || index > myRopeLen(rope))
+    {
+        return MYSTRING_ERROR;
+    }
+    RopeNode *left;
+    RopeNode *right;
+    if (splitRope(rope -> root, index, &left, &right) == MYSTRING_ERROR)
+    {
+        return MYSTRING_ERROR;
+    }
+    RopeNode *start = joinRope(left, other -> root);
+    bool built = !joinRopeFailed(start, left, other -> root);
+    RopeNode *root = built ? joinRope(start, right) : NULL;
+    built = built && !joinRopeFailed(root, start, right);
+    releaseRopeNode(left);
+    releaseRopeNode(right);
+    releaseRopeNode(start);
+    return setRopeRoot(rope, root, built);
+}
+
+/**
+ * @brief Complexity is O(log n) where n is the amount of leaves.
+ */
+MyRope * myRopeSplit(MyRope *rope, unsigned long index)
+{
+    if (rope == NULL || index > myRopeLen(rope))
+    {
+        return NULL;
+    }
+    RopeNode *left;
+    RopeNode *right;
+    if (splitRope(rope -> root, index, &left, &right) == MYSTRING_ERROR)
+    {
+        return NULL;
+    }
+    MyRope *rest = malloc(sizeof(MyRope));
+    if (rest == NULL)
+    {
+        releaseRopeNode(left);
+        releaseRopeNode(right);
+        return NULL;
+    }
+    rest -> root = right;
+    setRopeRoot(rope, left, true);
+    return rest;
+}
+
+/**
+ * @brief Complexity is O(log n) where n is the amount of leaves.
+ */
+MyStringRetVal myRopeCharAt(const MyRope *rope, unsigned long index, char *c)
+{
+    if (rope == NULL || c == NULL || index >= myRopeLen(rope))
+    {
+        return MYSTRING_ERROR;
+    }
+    const RopeNode *node = rope -> root;
+    while (node -> str == NULL)
+    {
+        if (index < node -> left -> length)
+        {
+            node = node -> left;
+        }
+        else
+        {
+            index -= node -> left -> length;
+            node = node -> right;
+        }
+    }
+    *c = ropeLeafView(node).chars[index];
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(log n) where n is the amount of leaves.
+ */
+bool myRopeNextChunk(const MyRope *rope, unsigned long *offset, MyStringView *chunk)
+{
+    if (rope == NULL || offset == NULL || chunk == NULL || *offset >= myRopeLen(rope))
+    {
+        return false;
+    }
+    const RopeNode *node = rope -> root;
+    unsigned long index = *offset;
+    while (node -> str == NULL)
+    {
+        if (index < node -> left -> length)
+        {
+            node = node -> left;
+        }
+        else
+        {
+            index -= node -> left -> length;
+            node = node -> right;
+        }
+    }
+    // the chunk is the rest of the leaf holding offset
+    *chunk = myStringViewSlice(ropeLeafView(node), index, node -> length - index);
+    *offset += chunk -> length;
+    return true;
+}
+
+/**
+ * @brief Copies a chunk of a rope to the end of a MyString with enough room.
+ *        Time complexity is O(n) where n is the length of chunk.
+ */
+static MyStringRetVal copyRopeChunk(MyStringView chunk, void *context)
+{
+    MyString *str = context;
+    memcpy(str -> stringArray + str -> stringSize, chunk.chars, chunk.length);
+    str -> stringSize += chunk.length;
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(1) + that of myStringClone for a rope that is already flat,
+ *        O(n) otherwise where n is the length of rope.
+ */
+MyString * myRopeToMyString(MyRope *rope)
+{
+    if (rope == NULL)
+    {
+        return NULL;
+    }
+    RopeNode *root = rope -> root;
+    if (root == NULL)
+    {
+        return myStringAlloc();
+    }
+    if (root -> str != NULL && root -> offset == EMPTY &&
+        root -> length == myStringLen(root -> str))
+    {
+        return myStringClone(root -> str);
+    }
+    MyString *str = myStringAlloc();
+    if (str == NULL || reSizeStringArray(str, root -> length) == MYSTRING_ERROR)
+    {
+        myStringFree(str);
+        return NULL;
+    }
+    str -> stringSize = EMPTY;
+    visitRopeChunks(root, copyRopeChunk, str);
+    // keep the flat copy, so flattening again (or indexing) does not go over the tree
+    RopeNode *leaf = buildRopeLeaf(myStringClone(str), EMPTY, root -> length);
+    if (leaf != NULL)
+    {
+        setRopeRoot(rope, leaf, true);
+    }
+    return str;
+}
+
+/**
+ * @brief Writes a chunk of a rope to a stream.
+ *        Time complexity is O(n) where n is the length of chunk.
+ */
+static MyStringRetVal writeRopeChunk(MyStringView chunk, void *context)
+{
+    return myStringViewWrite(chunk, context);
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of rope.
+ */
+MyStringRetVal myRopeWrite(const MyRope *rope, FILE *stream)
+{
+    if (rope == NULL || stream == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    // lock the stream once instead of in every fwrite (and keep other threads from cutting in)
+    flockfile(stream);
+    MyStringRetVal result = visitRopeChunks(rope -> root, writeRopeChunk, stream);
+    funlockfile(stream);
+    return result;
+}
+
+/**
+ * @brief Chunks of a rope waiting to be written to a file descriptor with a single writev.
+ */
+typedef struct RopeWriteBatch
+{
+    int fd;
+    int count;
+    struct iovec buffers[WRITE_BATCH_SIZE];
+} RopeWriteBatch;
+
+/**
+ * @brief Adds a chunk of a rope to a batch, writing the batch when it is full.
+ *        Time complexity is O(1) + the write of a full batch.
+ */
+static MyStringRetVal batchRopeChunk(MyStringView chunk, void *context)
+{
+    RopeWriteBatch *batch = context;
+    batch -> buffers[batch -> count++] = (struct iovec) {(void *) chunk.chars, chunk.length};
+    if (batch -> count == WRITE_BATCH_SIZE)
+    {
+        batch -> count = 0;
+        return writeBuffers(batch -> fd, batch -> buffers, WRITE_BATCH_SIZE);
+    }
+    return MYSTRING_SUCCESS;
+}
+
+/**
+ * @brief Complexity is O(n) where n is the length of rope, with a system call for every
+ *        WRITE_BATCH_SIZE chunks.
+ */
+MyStringRetVal myRopeWriteFd(const MyRope *rope, int fd)
+{
+    if (rope == NULL || fd < 0)
+    {
+        return MYSTRING_ERROR;
+    }
+    RopeWriteBatch *batch = malloc(sizeof(RopeWriteBatch));
+    if (batch == NULL)
+    {
+        return MYSTRING_ERROR;
+    }
+    batch -> fd = fd;
+    batch -> count = 0;
+    MyStringRetVal result = visitRopeChunks(rope -> root, batchRopeChunk, batch);
+    if (result == MYSTRING_SUCCESS && batch -> count > 0)
+    {
+        result = writeBuffers(fd, batch -> buffers, batch -> count);
+    }
+    free(batch);
+    return result;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+MyStringStats myStringStatsSnapshot()
+{
+    MyStringStats stats = {0};
+#ifdef MYSTRING_STATS
+    stats.enabled = true;
+    stats.allocs = atomic_load_explicit(&statsAllocs, memory_order_relaxed);
+    stats.frees = atomic_load_explicit(&statsFrees, memory_order_relaxed);
+    stats.reallocs = atomic_load_explicit(&statsReallocs, memory_order_relaxed);
+    stats.bytesCopied = atomic_load_explicit(&statsBytesCopied, memory_order_relaxed);
+    stats.liveBytes = atomic_load_explicit(&statsLiveBytes, memory_order_relaxed);
+    stats.freedSlack = atomic_load_explicit(&statsFreedSlack, memory_order_relaxed);
+    for (int i = 0; i < MYSTRING_STATS_BUCKETS; i++)
+    {
+        stats.freedLengths[i] = atomic_load_explicit(&statsFreedLengths[i], memory_order_relaxed);
+    }
+#endif
+    return stats;
+}
+
+/**
+ * @brief Complexity is O(1).
+ */
+void myStringStatsReset()
+{
+#ifdef MYSTRING_STATS
+    atomic_store_explicit(&statsAllocs, 0, memory_order_relaxed);
+    atomic_store_explicit(&statsFrees, 0, memory_order_relaxed);
+    atomic_store_explicit(&statsReallocs, 0, memory_order_relaxed);
+    atomic_store_explicit(&statsBytesCopied, 0, memory_order_relaxed);
+    atomic_store_explicit(&statsLiveBytes, 0, memory_order_relaxed);
+    atomic_store_explicit(&statsFreedSlack, 0, memory_order_relaxed);
+    for (int i = 0; i < MYSTRING_STATS_BUCKETS; i++)
+    {
+        atomic_store_explicit(&statsFreedLengths[i], 0, memory_order_relaxed);
+    }
+#endif
+}
+
+
+#ifndef NDEBUG
+static void printImproperError(const char *func, const int line)
+{
+    printf("Error returned improperly in %s at line %d.\n", func, line);
+    printf("Expected: MYSTRING_SUCCESS");
+    printf("Actual: MYSTRING_ERROR");
+}
+static void printComparisonHelper(const char *str, const char* func,
+                                  const int expected, const int actual)
+{
+    printf("Wrong value for %s between two equal MyStrings in %s.\n", str, func );
+    printf("Expected: %d\n", expected);
+    printf("Actual: %d\n", actual);
+}
+
+static void printCalculatorHelper(const char* str, const char* func,
+                                  const unsigned long expected, const unsigned long actual)
+{
+    printf("%s was not calculated properly in %s.\n", str, func);
+    printf("Expected: %lu\n", expected);
+    printf("Actual: %lu\n", actual);
+}
+/**
+ * @brief Tester for myStringAlloc()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringAlloc()
+{
+    printf("Start test for myStringAlloc\n");
+    MyString *testString = myStringAlloc();
+    // tests the length of an "empty" struct
+    if(testString -> stringSize != EMPTY)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, testString -> stringSize);
+    }
+    // tests the size of an empty "struct"
+    if(testString -> realSize != SHORT_SIZE)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, SHORT_SIZE, testString -> realSize);
+    }
+    // tests that the empty string is kept in the inline buffer
+    if(!isShortString(testString))
+    {
+        printf("Empty MyString was not kept in the inline buffer in myStringAlloc.\n");
+    }
+    char testChar = testString -> stringArray[0];
+    // tests for NULL_BYTE in first index of empty struct
+    if (testChar != NULL_BYTE)
+    {
+        printf("Null byte not added to empty MyString in myStringAlloc.");
+        printf("Expected: %c\n", NULL_BYTE);
+        printf("Actual: %c\n", testChar);
+    }
+    myStringFree(testString);
+    printf("End test for myStringAlloc\n");
+}
+
+/**
+ * @brief Tester for myStringLen()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringLen()
+{
+    printf("Start test for myStringLen\n");
+    MyString *testStruct = myStringAlloc();
+    // checks that length is returned properly for empty struct
+    if(myStringLen(testStruct) != 0)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, testStruct -> stringSize);
+    }
+    myStringFree(testStruct);
+    printf("End test for myStringLen\n");
+}
+
+/**
+ * @brief Tester for myStringCapacity()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCapacity()
+{
+    printf("Start test for myStringCapacity\n");
+    MyString *testStruct = myStringAlloc();
+    MyString *oneChar = myStringAlloc();
+    myStringSetFromCString(oneChar, "x");
+    // checks the capacity of an empty struct
+    if(myStringCapacity(testStruct) != SHORT_SIZE)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, SHORT_SIZE, myStringCapacity(testStruct));
+    }
+    // checks that appending one char at a time reallocates a logarithmic amount of times
+    unsigned long capacity = myStringCapacity(testStruct);
+    int reallocCount = 0;
+    for (int i = 0; i < 4096; i++)
+    {
+        myStringCat(testStruct, oneChar);
+        if(myStringCapacity(testStruct) != capacity)
+        {
+            capacity = myStringCapacity(testStruct);
+            reallocCount++;
+        }
+    }
+    if(myStringLen(testStruct) != 4096 || reallocCount > 12)
+    {
+        printCalculatorHelper("Realloc count", __func__, 12, reallocCount);
+    }
+    // checks that a small change in length does not shrink the string
+    myStringSetFromCString(testStruct, "x");
+    myStringReserve(testStruct, 400);
+    myStringSetFromCString(testStruct, "A string that is long, but not long enough to shrink 400 bytes "
+                                       "back down to size, since it is over a quarter of them...");
+    if(myStringCapacity(testStruct) != 400)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, 400, myStringCapacity(testStruct));
+    }
+    if(myStringCapacity(NULL) != (unsigned long) MYSTR_ERROR_CODE)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    myStringFree(testStruct);
+    myStringFree(oneChar);
+    printf("End test for myStringCapacity\n");
+}
+
+/**
+ * @brief Tester for myStringReserve()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringReserve()
+{
+    printf("Start test for myStringReserve\n");
+    MyString *testStruct = myStringAlloc();
+    myStringSetFromCString(testStruct, "Reserved");
+    // checks that reserving keeps the string and gives the exact capacity
+    if(myStringReserve(testStruct, 1000) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    if(myStringCapacity(testStruct) != 1000)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, 1000, myStringCapacity(testStruct));
+    }
+    if(myStringLen(testStruct) != 8 || testStruct -> stringArray[7] != 'd')
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 8, myStringLen(testStruct));
+    }
+    // checks that reserving less than the capacity does nothing
+    myStringReserve(testStruct, 10);
+    if(myStringCapacity(testStruct) != 1000)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, 1000, myStringCapacity(testStruct));
+    }
+    myStringFree(testStruct);
+    printf("End test for myStringReserve\n");
+}
+
+/**
+ * @brief Tester for myStringShrinkToFit()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringShrinkToFit()
+{
+    printf("Start test for myStringShrinkToFit\n");
+    char *longString = "A string that is too long for the inline buffer";
+    MyString *testStruct = myStringAlloc();
+    myStringSetFromCString(testStruct, longString);
+    myStringReserve(testStruct, 1000);
+    // checks that a heap string shrinks to its length
+    if(myStringShrinkToFit(testStruct) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    if(myStringCapacity(testStruct) != 47 || testStruct -> stringArray[46] != 'r')
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, 47, myStringCapacity(testStruct));
+    }
+    // checks that a short string goes back to the inline buffer
+    myStringReserve(testStruct, 1000);
+    myStringSetFromCString(testStruct, "Short string");
+    myStringShrinkToFit(testStruct);
+    if(!isShortString(testStruct) || testStruct -> stringArray[11] != 'g')
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, SHORT_SIZE, myStringCapacity(testStruct));
+    }
+    myStringFree(testStruct);
+    printf("End test for myStringShrinkToFit\n");
+}
+
+/**
+ * @brief Tester for myStringAllocPacked(), myStringReserveEx() and myStringCatEx()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringPacked()
+{
+    printf("Start test for myStringAllocPacked\n");
+    MyString *packed = myStringAllocPacked(64);
+    MyString *piece = myStringAlloc();
+    myStringSetFromCString(piece, "0123456789");
+    // checks that a packed string holds its capacity in the inline buffer
+    if(packed == NULL || myStringCapacity(packed) != 64 || myStringLen(packed) != EMPTY ||
+       myStringMemUsage(packed) != sizeof(MyString) + 64)
+    {
+        printf("Packed MyString was not allocated properly in myStringAllocPacked.\n");
+    }
+    // checks that myStringCatEx keeps growing the string as a single block
+    for (int i = 0; i < 20; i++)
+    {
+        if(myStringCatEx(&packed, piece) == MYSTRING_ERROR)
+        {
+            printImproperError(__func__, __LINE__);
+        }
+    }
+    myStringCatEx(&packed, packed);
+    if(!isShortString(packed) || myStringLen(packed) != 400 || packed -> stringArray[399] != '9')
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 400, myStringLen(packed));
+    }
+    if(myStringMemUsage(packed) != sizeof(MyString) + myStringCapacity(packed))
+    {
+        printf("Packed MyString was split by myStringCatEx.\n");
+    }
+    // checks that myStringReserveEx grows a packed string as a single block
+    myStringReserveEx(&packed, 5000);
+    if(!isShortString(packed) || myStringCapacity(packed) != 5000)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, 5000, myStringCapacity(packed));
+    }
+    // checks that the regular functions still work by leaving the inline buffer
+    myStringReserve(piece, 100);
+    myStringCatEx(&piece, packed);
+    if(isShortString(piece) || myStringLen(piece) != 410)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 410, myStringLen(piece));
+    }
+    myStringFree(packed);
+    myStringFree(piece);
+    printf("End test for myStringAllocPacked\n");
+}
+
+/**
+ * @brief Tester for the MyStringArena functions
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringArena()
+{
+    printf("Start test for MyStringArena\n");
+    MyStringArena *arena = myStringArenaCreate(1024);
+    MyString *heapString = myStringAlloc();
+    MyString *str1 = myStringAllocIn(arena);
+    MyString *str2 = myStringAllocIn(arena);
+    // checks that arena strings start empty like heap strings
+    if(str1 == NULL || myStringLen(str1) != EMPTY ||
+       myStringMemUsage(str1) != sizeof(MyString) + SHORT_SIZE)
+    {
+        printf("Arena string was not allocated properly in myStringAllocIn.\n");
+    }
+    // checks that arena strings grow (and relocate inside the arena) like heap strings
+    myStringSetFromCString(heapString, "0123456789");
+    myStringSetFromCString(str1, "0123456789");
+    for (int i = 0; i < 200; i++)
+    {
+        myStringCat(str1, heapString);
+        myStringCat(str2, heapString);
+    }
+    myStringCat(heapString, str1);
+    if(myStringLen(str1) != 2010 || myStringLen(str2) != 2000 || myStringLen(heapString) != 2020
+       || str1 -> stringArray[2009] != '9' || myStringCompare(str1, str2) <= SAME)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 2010, myStringLen(str1));
+    }
+    unsigned long expectedUsage = sizeof(MyString) + SHORT_SIZE + myStringCapacity(str1);
+    if(myStringMemUsage(str1) != expectedUsage)
+    {
+        printCalculatorHelper("Memory usage", __func__, expectedUsage, myStringMemUsage(str1));
+    }
+    // freeing an arena string does nothing, the arena releases it
+    myStringFree(str2);
+    myStringArenaReset(arena);
+    str1 = myStringAllocIn(arena);
+    myStringSetFromCString(str1, "after reset");
+    if(myStringLen(str1) != 11)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 11, myStringLen(str1));
+    }
+    // the slabs released by a reset are allocated from again
+    myStringArenaReset(arena);
+    ArenaSlab *reused = arena -> freeSlabs;
+    str1 = myStringAllocIn(arena);
+    if (reused == NULL || (char *) str1 != reused -> data)
+    {
+        printf("Arena slabs were not reused after myStringArenaReset.\n");
+    }
+    myStringFree(heapString);
+    myStringArenaDestroy(arena);
+    printf("End test for MyStringArena\n");
+}
+
+/**
+ * @brief Tester for myStringClone()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringClone()
+{
+    printf("Start test for myStringClone\n");
+    MyString *testString1 = myStringAlloc();
+    MyString *testString2 = myStringClone(testString1);
+    // checks length of cloned struct
+    if(myStringLen(testString2) != EMPTY)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, myStringLen(testString2));
+
+    }
+    // checks length of cloned struct
+    if(myStringLen(testString2) != myStringLen(testString1))
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__,
+                              myStringLen(testString1), myStringLen(testString2));
+    }
+    char testChar = testString2 -> stringArray[0];
+    // checks struct was cloned properly
+    if (testChar != NULL_BYTE)
+    {
+        printf("Null byte not added to empty MyString in myStringClone.\n");
+        printf("Expected: %c\n", NULL_BYTE);
+        printf("Actual: %c\n", testChar);
+    }
+    myStringFree(testString1);
+    myStringFree(testString2);
+    printf("End test for myStringClone\n");
+}
+
+/**
+ * @brief Tester for myStringSetFromMyString()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSetFromMyString()
+{
+    printf("Start test for myStringSetFromMyString\n");
+    MyString *startStruct = myStringAlloc();
+    char *startString = "Testing this nown";
+    myStringSetFromCString(startStruct, startString);
+    MyString *destStruct = myStringAlloc();
+    // checks setting struct from other struct doesn't return an error
+    if(myStringSetFromMyString(destStruct, startStruct) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    // checks length of copied struct
+    if(myStringLen(destStruct) != 17)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 17, myStringLen(destStruct));
+    }
+    // checks size of copied struct
+    if(destStruct -> realSize != SHORT_SIZE)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, SHORT_SIZE, myStringRealSize(destStruct));
+
+    }
+    char testChar = destStruct-> stringArray[START_SIZE];
+    // checks struct was copied properly
+    if (testChar != 'n')
+    {
+        printf("Improper character in destStruct in myStringSetFromMyString.\n");
+        printf("Expected: %c\n", 'n');
+        printf("Actual: %c\n", testChar);
+    }
+    myStringFree(startStruct);
+    myStringFree(destStruct);
+    printf("End test for myStringSetFromMyString\n");
+}
+
+/**
+ * @brief Tester for myStringSetFromCString()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSetFromCString()
+{
+    printf("Start test for MyStringSetFromCString\n");
+    char *testCString = "Testing this now";
+    MyString *testStruct = myStringAlloc();
+    // checks that setting a MyString from c string doesn't return an error
+    if(myStringSetFromCString(testStruct, testCString) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    // checks that length of setting a MyString from c string is correct
+    if(myStringLen(testStruct) != START_SIZE)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, START_SIZE, myStringLen(testStruct));
+    }
+    // checks that size of setting a MyString from c string is correct
+    if(testStruct -> realSize != SHORT_SIZE)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, SHORT_SIZE, myStringRealSize(testStruct));
+    }
+    char testChar = testStruct-> stringArray[FIRST_INDEX];
+    // check that MyString was set properly
+    if (testChar != 'T')
+    {
+        printf("Improper character in test_struct in myStringSetFromCString.\n");
+        printf("Expected: %c\n", 'T');
+        printf("Actual: %c\n", testChar);
+    }
+    char *testEmptyCString = "";
+    // check edge case of copying empty string
+    if(myStringSetFromCString(testStruct, testEmptyCString) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    if(myStringLen(testStruct) != EMPTY)
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, EMPTY, myStringLen(testStruct));
+    }
+    if(testStruct -> realSize != SHORT_SIZE)
+    {
+        printCalculatorHelper(STRING_SIZE, __func__, SHORT_SIZE, myStringRealSize(testStruct));
+    }
+    char testChar2 = testStruct-> stringArray[FIRST_INDEX];
+    if (testChar2 != NULL_BYTE)
+    {
+        printf("Improper null byte for empty string in myStringSetFromCString.\n");
+        printf("Expected: %c\n", NULL_BYTE);
+        printf("Actual: %c\n", testChar);
+    }
+    char *testLongCString = "A string that is too long for the inline buffer";
+    // check that a long string is moved to the heap and back to the inline buffer
+    myStringSetFromCString(testStruct, testLongCString);
+    if(isShortString(testStruct) || myStringLen(testStruct) != 47 ||
+       testStruct -> stringArray[46] != 'r')
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 47, myStringLen(testStruct));
+    }
+    myStringSetFromCString(testStruct, "Tiny");
+    if(!isShortString(testStruct) || testStruct -> stringArray[FIRST_INDEX] != 'T')
+    {
+        printf("Short string was not moved back to the inline buffer in myStringSetFromCString.\n");
+    }
+    myStringFree(testStruct);
+    printf("End test for MyStringSetFromCString\n");
+}
+
+/**
+ * @brief Tester for myStringStatsSnapshot() and myStringStatsReset()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringStats()
+{
+    printf("Start test for myStringStatsSnapshot\n");
+    myStringStatsReset();
+    MyStringStats stats = myStringStatsSnapshot();
+#ifdef MYSTRING_STATS
+    if(!stats.enabled || stats.allocs != EMPTY || stats.liveBytes != EMPTY)
+    {
+        printf("Statistics were not reset in %s.\n", __func__);
+    }
+    // a string longer than its inline buffer allocates its struct and then its array
+    char longCString[100 + 1] = {0};
+    memset(longCString, 'a', 100);
+    MyString *str1 = myStringAlloc();
+    myStringSetFromCString(str1, longCString);
+    stats = myStringStatsSnapshot();
+    if(stats.allocs != 2)
+    {
+        printCalculatorHelper("allocs", __func__, 2, stats.allocs);
+    }
+    if(stats.liveBytes != myStringMemUsage(str1))
+    {
+        printCalculatorHelper("liveBytes", __func__, myStringMemUsage(str1), stats.liveBytes);
+    }
+    // changing a clone copies the shared array first
+    MyString *str2 = myStringClone(str1);
+    myStringSetFromCString(str2, "b");
+    myStringSetFromCString(str2, longCString);
+    stats = myStringStatsSnapshot();
+    if(stats.bytesCopied == EMPTY)
+    {
+        printf("Copy of a shared array was not counted in %s.\n", __func__);
+    }
+    // growing the array of a string only it uses reallocs it
+    for (int i = 0; i < 4; i++)
+    {
+        myStringCat(str1, str1);
+    }
+    if(myStringStatsSnapshot().reallocs == EMPTY)
+    {
+        printf("Growth of an array was not counted in %s.\n", __func__);
+    }
+    // lengths 1600 and 100 fall in the buckets [1024, 2048) and [64, 128)
+    myStringFree(str1);
+    myStringFree(str2);
+    myStringFree(myStringAlloc());
+    stats = myStringStatsSnapshot();
+    if(stats.frees != stats.allocs)
+    {
+        printCalculatorHelper("frees", __func__, stats.allocs, stats.frees);
+    }
+    if(stats.liveBytes != EMPTY)
+    {
+        printCalculatorHelper("liveBytes", __func__, EMPTY, stats.liveBytes);
+    }
+    if(stats.freedLengths[0] != 1 || stats.freedLengths[7] != 1 || stats.freedLengths[11] != 1)
+    {
+        printf("Lengths of freed strings were not counted properly in %s.\n", __func__);
+    }
+    myStringStatsReset();
+#else
+    if(stats.enabled || stats.allocs != EMPTY || stats.freedLengths[0] != EMPTY)
+    {
+        printf("Statistics were counted without MYSTRING_STATS in %s.\n", __func__);
+    }
+#endif
+    printf("End test for myStringStatsSnapshot\n");
+}
+
+/**
+ * @brief Tester for myStringFree()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringFree()
+{
+    printf("Start test for myStringFree\n");
+    /*
+     There is no reliable way to tell if a pointer has been freed. The freed memory could be 
+     occupied by other irrelevant data and you'll get wrong result.
+     And indeed there is no standard way to check if a pointer is freed. 
+     That said, glibc does have functions (mcheck, mprobe) to find the malloc status of a pointer 
+     for heap consistency checking, and one of them is to see if a pointer is freed.
+     However, these functions are mainly used for debugging only, and they are not thread-safe. 
+     So I just made sure I have paired malloc/free and used valgrind to double check.
+     */
+    printf("End test for myStringFree\n");
+}
+
+/**
+ * @brief Tester for myStringToCString()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringToCString()
+{
+    printf("Start test for myStringToCString\n");
+    char *testCString = "Testing this now";
+    MyString *testStruct = myStringAlloc();
+    myStringSetFromCString(testStruct, testCString);
+    char *newCString = myStringToCString(testStruct);
+    char testChar = newCString[START_SIZE];
+    // check that string was copied with a null byte at end to make it a cstring
+    if(testChar != NULL_BYTE)
+    {
+        printf("Improper null byte at end of c string in myStringToCString.\n");
+        printf("Expected: %c\n", NULL_BYTE);
+        printf("Actual: %c\n", testChar);
+    }
+    MyString *testStruct2 = NULL;
+    char *newCString2 = myStringToCString(testStruct2);
+    // check that c string was copied properly
+    if(newCString2 != NULL)
+    {
+        printf("No null in cString2 in myStringToCString.\n");
+        printf("Expected: NULL");
+        printf("Actual: %s\n", newCString2);
+    }
+    myStringFree(testStruct);
+    free(newCString);
+    free(newCString2);
+    printf("End test for MyStringToCString\n");
+}
+
+/**
+ * @brief Tester for myStringToInt()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringToInt()
+{
+    printf("Start test for myStringToInt\n");
+    char *correctInt = "1234";
+    char *incorrectInt = "12a4";
+    char *negativeInt = "-1234";
+    char *emptyString = "";
+    char *complexInt = "1234567";
+    char *complexNegative = "-1234567";
+    char *badNegative = "12-34";
+    MyString *testStruct = myStringAlloc();
+    myStringSetFromCString(testStruct, correctInt);
+    int testInt = myStringToInt(testStruct);
+    // test that correct int was copied properly
+    if(testInt != 1234)
+    {
+        printf("Wrong value for int for correctInt test in myStringToInt.\n");
+        printf("Expected: %d\n", 1234);
+        printf("Actual: %d\n", testInt);
+    }
+    myStringSetFromCString(testStruct, incorrectInt);
+    testInt = myStringToInt(testStruct);
+    // check that error code is returned for improper int
+    if(testInt != MYSTR_ERROR_CODE)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    myStringSetFromCString(testStruct, negativeInt);
+    testInt = myStringToInt(testStruct);
+    // test that negative int was copied properly
+    if(testInt != -1234)
+    {
+        printf("Wrong value for int for negativeInt test in myStringToInt.\n");
+        printf("Expected: %d\n", -1234);
+        printf("Actual: %d\n", testInt);
+    }
+    myStringSetFromCString(testStruct, emptyString);
+    testInt = myStringToInt(testStruct);
+    // check that error code is returned for improper int
+    if(testInt != MYSTR_ERROR_CODE)
+    {
+        printImproperError(__func__, __LINE__);
+
+    }
+    myStringSetFromCString(testStruct, complexInt);
+    testInt = myStringToInt(testStruct);
+    // test that complex int was copied properly
+    if(testInt != 1234567)
+    {
+        printf("Wrong value for int for complexInt test in myStringToInt.\n");
+        printf("Expected: %d\n", 1234567);
+        printf("Actual: %d\n", testInt);
+    }
+    myStringSetFromCString(testStruct, complexNegative);
+    testInt = myStringToInt(testStruct);
+    // test that complex negative int was copied properly
+    if(testInt != -1234567)
+    {
+        printf("Wrong value for int for complexNegative test in myStringToInt.\n");
+        printf("Expected: %d\n", -1234567);
+        printf("Actual: %d\n", testInt);
+    }
+    myStringSetFromCString(testStruct, badNegative);
+    testInt = myStringToInt(testStruct);
+    // check that error code is returned for improper int
+    if(testInt != MYSTR_ERROR_CODE)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    myStringFree(testStruct);
+    printf("End test for myStringToInt\n");
+}
+
+/**
+ * @brief Tester for myStringToInt64() and myStringToInt64Many()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringToInt64()
+{
+    printf("Start test for myStringToInt64\n");
+    const char *valid[] = {"0", "-0", "7", "-1234", "12345678", "123456789012345678",
+                           "00000000000000000000000000000042", "9223372036854775807",
+                           "-9223372036854775808", "-999"};
+    const int64_t values[] = {0, 0, 7, -1234, 12345678, 123456789012345678LL, 42, INT64_MAX,
+                              INT64_MIN, -999};
+    MyString *strs[10];
+    for (int i = 0; i < 10; i++)
+    {
+        strs[i] = myStringAlloc();
+        myStringSetFromCString(strs[i], valid[i]);
+        int64_t value = 1;
+        if(myStringToInt64(strs[i], &value) != MYSTRING_SUCCESS || value != values[i])
+        {
+            printf("Wrong value for %s in myStringToInt64.\n", valid[i]);
+        }
+    }
+    // checks that errors are found, including overflows by a single unit and a bad char in a chunk
+    const char *invalid[] = {"", "-", "+1", "1-", "12a4", "1234567x9", "123456789012345678x",
+                             "9223372036854775808", "-9223372036854775809",
+                             "18446744073709551616", "99999999999999999999999"};
+    int64_t value = 1;
+    for (int i = 0; i < 11; i++)
+    {
+        if(myStringViewToInt64(myStringViewOfCString(invalid[i]), &value) != MYSTRING_ERROR ||
+           value != 1)
+        {
+            printf("No error for %s in myStringToInt64.\n", invalid[i]);
+        }
+    }
+    // checks random numbers of every length against the C library
+    unsigned int seed = 3;
+    char buffer[INT64_STRING_SIZE + 1];
+    for (int i = 0; i < 1000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int64_t expected = (int64_t) (((uint64_t) seed << 32 | (seed * 7919u)) >> (seed % 63));
+        expected = (i % 2 == 0) ? expected : -expected;
+        snprintf(buffer, sizeof(buffer), "%lld", (long long) expected);
+        if(myStringViewToInt64(myStringViewOfCString(buffer), &value) != MYSTRING_SUCCESS ||
+           value != expected)
+        {
+            printf("Wrong value for %s in myStringToInt64.\n", buffer);
+        }
+    }
+    // checks that myStringToInt finds values that do not fit in an int
+    myStringSetFromCString(strs[0], "2147483648");
+    myStringSetFromCString(strs[1], "-2147483648");
+    if(myStringToInt(strs[0]) != MYSTR_ERROR_CODE || myStringToInt(strs[1]) != INT_MIN)
+    {
+        printf("Wrong value for the ends of int in myStringToInt.\n");
+    }
+    // checks the batch, with one string that can not be parsed
+    myStringSetFromCString(strs[4], "x");
+    int64_t column[10];
+    bool parsed[10];
+    if(myStringToInt64Many((const MyString * const *) strs, 10, column, parsed) != MYSTRING_ERROR ||
+       parsed[4] || column[4] != 0 || !parsed[9] || column[9] != -999 || column[1] != INT_MIN)
+    {
+        printf("Wrong values in myStringToInt64Many.\n");
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        myStringFree(strs[i]);
+    }
+    printf("End test for myStringToInt64\n");
+}
+
+/**
+ * @brief Sets LC_NUMERIC to a locale whose decimal point is a ',', if this machine has one.
+ * RETURN VALUE:
+ * @return true if it was set (LC_NUMERIC must be set back to "C" afterwards), false otherwise.
+ */
+static bool testCommaLocaleHelper()
+{
+    const char *locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "de_DE"};
+    for (int i = 0; i < 5; i++)
+    {
+        if (setlocale(LC_NUMERIC, locales[i]) != NULL)
+        {
+            if (*localeconv() -> decimal_point == ',')
+            {
+                return true;
+            }
+            setlocale(LC_NUMERIC, "C");
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Tester for myStringToDouble() and myStringToDoubleMany()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringToDouble()
+{
+    printf("Start test for myStringToDouble\n");
+    // checks numbers of every form (exactly, against the C library)
+    const char *valid[] = {"0", "-0", "1", "+2.5", "-.5", "3.", "1e10", "1E-5", "123.456e+2",
+                           "0.30000000000000004", "9007199254740993", "1e23", "5e-324",
+                           "1e-400", "1.7976931348623157e308", "12345678901234567890123",
+                           "0.000000000000000000000000000001", "INF", "-Infinity"};
+    double value = 1;
+    for (int i = 0; i < 19; i++)
+    {
+        double expected = strtod(valid[i], NULL);
+        if(myStringViewToDouble(myStringViewOfCString(valid[i]), &value) != MYSTRING_SUCCESS ||
+           memcmp(&value, &expected, sizeof(double)) != 0)
+        {
+            printf("Wrong value for %s in myStringToDouble.\n", valid[i]);
+        }
+    }
+    if(myStringViewToDouble(myStringViewOfCString("nan"), &value) != MYSTRING_SUCCESS ||
+       value == value)
+    {
+        printf("Wrong value for nan in myStringToDouble.\n");
+    }
+    const char *invalid[] = {"", ".", "-", "e5", "1e", "1e+", "1.2.3", "--1", "0x10", "1 ",
+                             "in", "1e400", "-1e400"};
+    value = 1;
+    for (int i = 0; i < 13; i++)
+    {
+        if(myStringViewToDouble(myStringViewOfCString(invalid[i]), &value) != MYSTRING_ERROR ||
+           value != 1)
+        {
+            printf("No error for %s in myStringToDouble.\n", invalid[i]);
+        }
+    }
+    // checks random numbers of many lengths and exponents against the C library
+    unsigned int seed = 5;
+    char buffer[64];
+    for (int i = 0; i < 10000; i++)
+    {
+        int length = 0;
+        seed = seed * 1103515245 + 12345;
+        int digits = (int) (seed >> 16) % 20 + 1;
+        int point = (int) (seed >> 8) % (digits + 1);
+        for (int j = 0; j < digits; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            buffer[length++] = (j == point) ? '.' : (char) ('0' + (seed >> 16) % 10);
+        }
+        seed = seed * 1103515245 + 12345;
+        length += snprintf(buffer + length, sizeof(buffer) - length, "e%d",
+                           (int) ((seed >> 16) % 80) - 40);
+        double expected = strtod(buffer, NULL);
+        if(strcmp(buffer, ".") != 0 && strncmp(buffer, ".e", 2) != 0 &&
+           (myStringViewToDouble(myStringViewOfBuffer(buffer, length), &value) != MYSTRING_SUCCESS
+            || value != expected))
+        {
+            printf("Wrong value for %s in myStringToDouble.\n", buffer);
+        }
+    }
+    // checks the batch
+    MyString *strs[3] = {myStringAlloc(), myStringAlloc(), myStringAlloc()};
+    myStringSetFromCString(strs[0], "0.25");
+    myStringSetFromCString(strs[1], "-1e3");
+    myStringSetFromCString(strs[2], "1,5");
+    double column[3];
+    bool parsed[3];
+    if(myStringToDoubleMany((const MyString * const *) strs, 3, column, parsed) != MYSTRING_ERROR ||
+       column[0] != 0.25 || column[1] != -1000 || parsed[2] || column[2] != 0 ||
+       myStringToDouble(NULL, &value) != MYSTRING_ERROR)
+    {
+        printf("Wrong values in myStringToDoubleMany.\n");
+    }
+    // numbers read by strtod still have a '.' in a locale whose decimal point is a ','
+    if (testCommaLocaleHelper())
+    {
+        if(myStringViewToDouble(myStringViewOfCString("1.2345678901234567"), &value) !=
+           MYSTRING_SUCCESS || value != 1.2345678901234567)
+        {
+            printf("Wrong decimal point in myStringToDouble.\n");
+        }
+        setlocale(LC_NUMERIC, "C");
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        myStringFree(strs[i]);
+    }
+    printf("End test for myStringToDouble\n");
+}
+
+/**
+ * @brief Tester for myStringCustomEqual()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCustomEqual()
+{
+    printf("Start test for myStringCustomEqual\n");
+    char *string1 = "Testing";
+    char *string2 = "TestingWrong";
+    MyString *struct1 = myStringAlloc();
+    MyString *struct2 = myStringAlloc();
+    MyString *struct3 = myStringAlloc();
+    myStringSetFromCString(struct1, string1);
+    myStringSetFromCString(struct2, string1);
+    myStringSetFromCString(struct3, string2);
+    // check that equal recognizes that MyStrings are equal
+    if (myStringCustomEqual(struct1, struct2, logicalEqual) == UNEQUAL)
+    {
+        printComparisonHelper("equality test", __func__, EQUAL,
+                              UNEQUAL);
+    }
+    // check that equal recognizes that MyStrings are unequal
+    if (myStringCustomEqual(struct1, struct3, logicalEqual) == EQUAL)
+    {
+        printComparisonHelper("equality test", __func__, UNEQUAL ,
+                              EQUAL);
+    }
+    myStringFree(struct1);
+    myStringFree(struct2);
+    myStringFree(struct3);
+    printf("End test for myStringCustomEqual\n");
 }
 
 /**
@@ -1359,496 +9064,2557 @@ static void testMyStringCustomEqual()
  *
  * RETURN VALUE: none
  */
-static void testMyStringEqual()
+static void testMyStringEqual()
+{
+    printf("Start test for myStringEqual\n");
+    char *equalString = "equal string";
+    char *unequalString = "unequal string";
+    MyString *struct1 = myStringAlloc();
+    MyString *struct2 = myStringAlloc();
+    myStringSetFromCString(struct1, equalString);
+    myStringSetFromCString(struct2, equalString);
+    // check that equal recognizes that MyStrings are equal
+    if (myStringEqual(struct1, struct2) == UNEQUAL)
+    {
+        printComparisonHelper("equality test", __func__, EQUAL,
+                              UNEQUAL);
+    }
+    myStringSetFromCString(struct2, unequalString);
+    // check that equal recognizes that MyStrings are unequal
+    if (myStringEqual(struct1, struct2) == EQUAL)
+    {
+        printComparisonHelper("equality test", __func__, UNEQUAL,
+                              EQUAL);
+    }
+    myStringFree(struct1);
+    myStringFree(struct2);
+    printf("End test for myStringCustomEqual\n");
+}
+
+
+/**
+ * @brief Tester for myStringSetFromInt()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSetFromInt()
+{
+    printf("Start test for myStringSetFromInt\n");
+
+    char *correctIntString = "1234";
+    char *negativeIntString = "-1234";
+    char *complexIntString = "1234567";
+    char *complexNegativeString = "-1234567";
+    int correctInt = 1234;
+    int negativeInt = -1234;
+    int complexInt = 1234567;
+    int complexNegative = -1234567;
+    MyString *testStructInt = myStringAlloc();
+    MyString *testStructString = myStringAlloc();
+    myStringSetFromInt(testStructInt, correctInt);
+    myStringSetFromCString(testStructString, correctIntString);
+    // test that int was copied properly into MyString
+    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    {
+        printComparisonHelper("int", __func__, EQUAL, UNEQUAL);
+    }
+    myStringSetFromInt(testStructInt, negativeInt);
+    myStringSetFromCString(testStructString, negativeIntString);
+    // test that negative int was copied properly into MyString
+    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    {
+        printComparisonHelper("negative int", __func__, EQUAL, UNEQUAL);
+
+    }
+    myStringSetFromInt(testStructInt, complexInt);
+    myStringSetFromCString(testStructString, complexIntString);
+    // test that complex int was copied properly into MyString
+    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    {
+        printComparisonHelper("complex int", __func__, EQUAL, UNEQUAL);
+
+    }
+    myStringSetFromInt(testStructInt, complexNegative);
+    myStringSetFromCString(testStructString, complexNegativeString);
+    // test that complex negative int was copied properly into MyString
+    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    {
+        printComparisonHelper("complex negative int", __func__, EQUAL, UNEQUAL);
+
+    }
+    myStringFree(testStructInt);
+    myStringFree(testStructString);
+    printf("End test for myStringSetFromInt\n");
+}
+
+/**
+ * @brief Helper for testMyStringFilter()
+ *        Simple filter for test purposes
+ * @param char we wish to check
+ * RETURN VALUE:
+ * @return true if char is equal to a, false otherwise
+ */
+static bool testMyStringFilterHelper(const char *char1)
+{
+    if(*char1 == 'a')
+    {
+        return true;
+    }
+    return false;
+}
+/**
+ * @brief Tester for myStringSetFromInt64() and myStringSetFromUInt64()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSetFromInt64()
+{
+    printf("Start test for myStringSetFromInt64\n");
+    MyString *str = myStringAlloc();
+    char expected[INT64_STRING_SIZE + 1];
+    // checks the ends of the ranges (which can not be negated) against printf
+    myStringSetFromInt(str, INT32_MIN);
+    if(!myStringViewEqual(myStringViewOf(str), myStringViewOfCString("-2147483648")))
+    {
+        printf("Wrong value for INT_MIN in myStringSetFromInt.\n");
+    }
+    myStringSetFromInt64(str, INT64_MIN);
+    if(!myStringViewEqual(myStringViewOf(str), myStringViewOfCString("-9223372036854775808")))
+    {
+        printf("Wrong value for INT64_MIN in myStringSetFromInt64.\n");
+    }
+    myStringSetFromUInt64(str, UINT64_MAX);
+    if(!myStringViewEqual(myStringViewOf(str), myStringViewOfCString("18446744073709551615")))
+    {
+        printf("Wrong value for UINT64_MAX in myStringSetFromUInt64.\n");
+    }
+    // checks every amount of digits, where the digit count changes
+    for (int i = 0; i < 20; i++)
+    {
+        uint64_t values[] = {POWERS_OF_10[i] - 1, POWERS_OF_10[i], POWERS_OF_10[i] + 1};
+        for (int j = 0; j < 3; j++)
+        {
+            snprintf(expected, sizeof(expected), "%llu", (unsigned long long) values[j]);
+            myStringSetFromUInt64(str, values[j]);
+            if(!myStringViewEqual(myStringViewOf(str), myStringViewOfCString(expected)))
+            {
+                printf("Wrong value for %s in myStringSetFromUInt64.\n", expected);
+            }
+            snprintf(expected, sizeof(expected), "%lld", -(long long) (values[j] / 2));
+            myStringSetFromInt64(str, -(int64_t) (values[j] / 2));
+            if(!myStringViewEqual(myStringViewOf(str), myStringViewOfCString(expected)))
+            {
+                printf("Wrong value for %s in myStringSetFromInt64.\n", expected);
+            }
+        }
+    }
+    if(myStringSetFromInt64(NULL, 1) != MYSTRING_ERROR)
+    {
+        printf("NULL was set in myStringSetFromInt64.\n");
+    }
+    myStringFree(str);
+    printf("End test for myStringSetFromInt64\n");
+}
+
+/**
+ * @brief Tester for myStringSetFromDouble()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSetFromDouble()
+{
+    printf("Start test for myStringSetFromDouble\n");
+    MyString *str = myStringAlloc();
+    const double values[] = {0.1, 1.0 / 3, 1e300, -0.0, 123.0, 2.5e-10, 0.1 + 0.2, -1e308 * 10};
+    const char *expected[] = {"0.1", "0.3333333333333333", "1e+300", "-0", "123", "2.5e-10",
+                              "0.30000000000000004", "-inf"};
+    for (int i = 0; i < 8; i++)
+    {
+        if(myStringSetFromDouble(str, values[i]) != MYSTRING_SUCCESS ||
+           !myStringViewEqual(myStringViewOf(str), myStringViewOfCString(expected[i])))
+        {
+            printf("Wrong value for %s in myStringSetFromDouble.\n", expected[i]);
+        }
+    }
+    // checks that doubles from all over the range are read back as themselves
+    uint64_t bits = 0x123456789ABCDEFULL;
+    for (int i = 0; i < 1000; i++)
+    {
+        bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+        double value;
+        uint64_t finiteBits = bits & 0x7FEFFFFFFFFFFFFFULL;
+        memcpy(&value, &finiteBits, sizeof(value));
+        char *cString;
+        if(myStringSetFromDouble(str, value) != MYSTRING_SUCCESS ||
+           (cString = myStringToCString(str)) == NULL)
+        {
+            printf("Failed to set in myStringSetFromDouble.\n");
+            continue;
+        }
+        if(strtod(cString, NULL) != value)
+        {
+            printf("%s is not read back in myStringSetFromDouble.\n", cString);
+        }
+        free(cString);
+    }
+    // the decimal point is a '.' in a locale whose decimal point is a ','
+    if (testCommaLocaleHelper())
+    {
+        if(myStringSetFromDouble(str, 0.1) != MYSTRING_SUCCESS ||
+           !myStringViewEqual(myStringViewOf(str), myStringViewOfCString("0.1")))
+        {
+            printf("Wrong decimal point in myStringSetFromDouble.\n");
+        }
+        setlocale(LC_NUMERIC, "C");
+    }
+    myStringFree(str);
+    printf("End test for myStringSetFromDouble\n");
+}
+
+/**
+ * @brief Tester for myStringFilter()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringFilter()
+{
+    printf("Start test for myStringSetFilter\n");
+    char *testString = "abacadae";
+    char *testString2 = "bcde";
+    MyString *testStruct = myStringAlloc();
+    MyString *testStruct2 = myStringAlloc();
+    myStringSetFromCString(testStruct, testString);
+    myStringSetFromCString(testStruct2, testString2);
+    // test that filter does not return error
+    if (myStringFilter(testStruct, testMyStringFilterHelper) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    // test that two strings are equal after filter
+    if(myStringEqual(testStruct2, testStruct) == UNEQUAL)
+    {
+        printComparisonHelper("equality test", __func__, EQUAL, UNEQUAL);
+    }
+    char *testString3 = "";
+    myStringSetFromCString(testStruct, testString3);
+    // test that filter does not return error
+    if (myStringFilter(testStruct, testMyStringFilterHelper) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    myStringFree(testStruct);
+    myStringFree(testStruct2);
+    printf("End test for myStringSetFilter\n");
+}
+
+/**
+ * @brief Tester for myStringFilterSet(), MyCharSet and the filter kernels
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringFilterSet()
+{
+    printf("Start test for myStringFilterSet\n");
+    MyCharSet set;
+    myCharSetClear(&set);
+    myCharSetAddChars(&set, " \t,.");
+    myCharSetAddRange(&set, '0', '9');
+    myCharSetAdd(&set, '\xff');
+    if (!myCharSetHas(&set, ' ') || !myCharSetHas(&set, '5') || !myCharSetHas(&set, '\xff') ||
+        myCharSetHas(&set, 'a') || myCharSetHas(&set, '\xfe') || myCharSetHas(&set, NULL_BYTE) ||
+        myCharSetHas(NULL, ' '))
+    {
+        printf("MyCharSet has the wrong chars.\n");
+    }
+    MyString *str = myStringAlloc();
+    MyString *expected = myStringAlloc();
+    myStringSetFromCString(str, "Hello, world. 42 times\tover\xff and over, and over again.");
+    myStringSetFromCString(expected, "Helloworldtimesoverandoverandoveragain");
+    MyString *clone = myStringClone(str);
+    if (myStringFilterSet(str, &set) == MYSTRING_ERROR || myStringEqual(str, expected) == UNEQUAL)
+    {
+        printf("myStringFilterSet did not remove the chars of the set.\n");
+    }
+    // checks that the filtered array was not shared with the clone
+    if (myStringLen(clone) != 54)
+    {
+        printf("Shared array was changed by myStringFilterSet.\n");
+    }
+    if (myStringFilterSet(NULL, &set) != MYSTRING_ERROR ||
+        myStringFilterSet(str, NULL) != MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    // checks every kernel against myCharSetHas on random chars and sets, at every length (so
+    // every tail) and with blocks where all, none or some of the chars are kept
+    FilterKernel kernels[2];
+    int kernelCount = listFilterKernels(kernels);
+    getFilterKernel();
+    char input[100];
+    char chars[100];
+    char want[100];
+    unsigned int seed = 1;
+    for (int round = 0; round < 40; round++)
+    {
+        myCharSetClear(&set);
+        for (int c = 0; c < 256; c++)
+        {
+            seed = seed * 1103515245 + 12345;
+            if ((int) ((seed >> 16) % 40) < round)
+            {
+                myCharSetAdd(&set, (char) c);
+            }
+        }
+        for (int length = 0; length < 100; length++)
+        {
+            unsigned long wantLength = 0;
+            for (int i = 0; i < length; i++)
+            {
+                seed = seed * 1103515245 + 12345;
+                input[i] = (char) (seed >> 16);
+                if (!myCharSetHas(&set, input[i]))
+                {
+                    want[wantLength++] = input[i];
+                }
+            }
+            for (int k = 0; k < kernelCount; k++)
+            {
+                memcpy(chars, input, length);
+                if (kernels[k](chars, length, &set) != wantLength ||
+                    memcmp(chars, want, wantLength) != 0)
+                {
+                    printf("Filter kernel %d was wrong at length %d.\n", k, length);
+                }
+            }
+        }
+    }
+    // checks the splitter that tokenizes with a MyCharSet
+    MyStringSplitter splitter = myStringTokenize(myStringViewOfCString("\xff" "a\xfe" "b\xff"),
+                                                 myStringViewOfCString("\xff\xfe"));
+    MyStringView field;
+    if (!myStringSplitNext(&splitter, &field) || !myStringViewEqual(field,
+                                                                  myStringViewOfCString("a")) ||
+        !myStringSplitNext(&splitter, &field) || !myStringViewEqual(field,
+                                                                  myStringViewOfCString("b")) ||
+        myStringSplitNext(&splitter, &field))
+    {
+        printf("Tokenizing by chars above 127 gave the wrong tokens.\n");
+    }
+    myStringFree(clone);
+    myStringFree(str);
+    myStringFree(expected);
+    printf("End test for myStringFilterSet\n");
+}
+
+/**
+ * @brief Tester for sharing arrays between clones (copy on write)
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCloneSharing()
+{
+    printf("Start test for myStringClone sharing\n");
+    char *longString = "A string that is too long for the inline buffer";
+    MyString *original = myStringAlloc();
+    MyString *piece = myStringAlloc();
+    myStringSetFromCString(original, longString);
+    myStringSetFromCString(piece, "!");
+    MyString *clone1 = myStringClone(original);
+    MyString *clone2 = myStringClone(clone1);
+    // checks that the clones share the array of the original
+    if(clone1 -> stringArray != original -> stringArray ||
+       clone2 -> stringArray != original -> stringArray || !isSharedString(original))
+    {
+        printf("Heap array was not shared by myStringClone.\n");
+    }
+    if(myStringMemUsage(clone1) != myStringMemUsage(original))
+    {
+        printCalculatorHelper("Memory usage", __func__, myStringMemUsage(original),
+                              myStringMemUsage(clone1));
+    }
+    // checks that changing a clone copies the array and leaves the others as they were
+    myStringCat(clone1, piece);
+    myStringSetFromCString(piece, longString);
+    if(clone1 -> stringArray == original -> stringArray || myStringLen(clone1) != 48 ||
+       clone1 -> stringArray[47] != '!' || myStringEqual(original, piece) == UNEQUAL ||
+       myStringEqual(clone2, piece) == UNEQUAL)
+    {
+        printf("Shared array was changed by myStringCat.\n");
+    }
+    // checks that filtering and setting also copy the array
+    myStringFilter(clone2, testMyStringFilterHelper);
+    if(myStringEqual(original, piece) == UNEQUAL || myStringLen(clone2) != 46)
+    {
+        printf("Shared array was changed by myStringFilter.\n");
+    }
+    MyString *clone3 = myStringClone(original);
+    myStringSetFromInt(original, 7);
+    if(myStringEqual(clone3, piece) == UNEQUAL || myStringToInt(original) != 7)
+    {
+        printf("Shared array was changed by myStringSetFromInt.\n");
+    }
+    // checks that the last clone keeps the array alive
+    MyString *clone4 = myStringClone(clone3);
+    myStringFree(clone3);
+    if(isSharedString(clone4) || myStringEqual(clone4, piece) == UNEQUAL)
+    {
+        printf("Shared array was not kept alive by its last clone.\n");
+    }
+    myStringFree(original);
+    myStringFree(piece);
+    myStringFree(clone1);
+    myStringFree(clone2);
+    myStringFree(clone4);
+    printf("End test for myStringClone sharing\n");
+}
+
+/**
+ * @brief Tester for myStringCompare()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCompare()
+{
+    
+    printf("Start test for myStringCompare\n");
+    char *string1 = "bcfd";
+    char *string2 = "bcde";
+    char *string3 = "bcd";
+    char *string4 = "cd";
+    MyString *equalStruct1 = myStringAlloc();
+    myStringSetFromCString(equalStruct1, string1);
+    MyString *equalStruct2 = myStringClone(equalStruct1);
+    MyString *unequalStruct = myStringAlloc();
+    myStringSetFromCString(unequalStruct, string2);
+    MyString *shorterStruct = myStringAlloc();
+    myStringSetFromCString(shorterStruct, string3);
+    MyString *shortestStruct = myStringAlloc();
+    myStringSetFromCString(shortestStruct, string4);
+    // Checks that two equal structs are compared properly
+    if(myStringCompare(equalStruct1, equalStruct2) == BIGGER ||
+       myStringCompare(equalStruct1, equalStruct2) == SMALLER )
+    {
+        printComparisonHelper("comparison test", __func__, SAME,
+                              myStringCompare(equalStruct1, equalStruct2) == BIGGER);
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCompare(equalStruct1, unequalStruct) <= SAME)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: -1\n");
+        printf("Actual: %d\n", myStringCompare(equalStruct1, unequalStruct));
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCompare(unequalStruct, equalStruct1) >= 0)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: 1\n");
+        printf("Actual: %d\n", myStringCompare(unequalStruct, equalStruct1));
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCompare(equalStruct1, shorterStruct) <= 0)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: 1\n");
+        printf("Actual: %d\n", myStringCompare(equalStruct1, shorterStruct));
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCompare(shorterStruct, shortestStruct) >= 0)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: -1\n");
+        printf("Actual: %d\n", myStringCompare(shorterStruct, shortestStruct));
+    }
+    
+    myStringFree(equalStruct1);
+    myStringFree(equalStruct2);
+    myStringFree(unequalStruct);
+    myStringFree(shorterStruct);
+    myStringFree(shortestStruct);
+    printf("End test for myStringCompare\n");
+}
+
+/**
+ * @brief Tester for myStringCustomCompare()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCustomCompare()
+{
+    printf("Start test for myStringCustomCompare\n");
+    char *string1 = "abcd";
+    char *string2 = "abce";
+    char *string3 = "abc";
+    char *string4 = "ad";
+    MyString *equalStruct1 = myStringAlloc();
+    myStringSetFromCString(equalStruct1, string1);
+    MyString *equalStruct2 = myStringClone(equalStruct1);
+    MyString *unequalStruct = myStringAlloc();
+    myStringSetFromCString(unequalStruct, string2);
+    MyString *shorterStruct = myStringAlloc();
+    myStringSetFromCString(shorterStruct, string3);
+    MyString *shortestStruct = myStringAlloc();
+    myStringSetFromCString(shortestStruct, string4);
+    // Checks that two equal structs are compared properly
+    if(myStringCustomCompare(equalStruct1, equalStruct2, defCompare) !=0)
+    {
+        printf("Wrong value returned after comparison of 2 equal MyStrings.\n");
+        printf("Expected: 0\n");
+        printf("Actual: %d\n", myStringCustomCompare(equalStruct1, equalStruct2, defCompare));
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCustomCompare(equalStruct1, unequalStruct, defCompare) >= 0)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: -1\n");
+        printf("Actual: %d\n", myStringCustomCompare(equalStruct1, unequalStruct, defCompare));
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCustomCompare(unequalStruct, equalStruct1, defCompare) <= 0)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: 1\n");
+        printf("Actual: %d\n", myStringCustomCompare(unequalStruct, equalStruct1, defCompare));
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCustomCompare(equalStruct1, shorterStruct, defCompare) <= 0)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: 1\n");
+        printf("Actual: %d\n", myStringCustomCompare(equalStruct1, shorterStruct, defCompare));
+    }
+    // Checks that two unequal structs are compared properly
+    if(myStringCustomCompare(shorterStruct, shortestStruct, defCompare) >= 0)
+    {
+        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
+        printf("Expected: -1\n");
+        printf("Actual: %d\n", myStringCustomCompare(shorterStruct, shortestStruct, defCompare));
+    }
+    
+    myStringFree(equalStruct1);
+    myStringFree(equalStruct2);
+    myStringFree(unequalStruct);
+    myStringFree(shorterStruct);
+    myStringFree(shortestStruct);
+    printf("End test for myStringCustomCompare\n");
+}
+
+/**
+ * @brief Tester for myStringCatTo()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCatTo()
+{
+    printf("Start test for myStringCatTo\n");
+    char *string1 = "first";
+    char *string2 = "morecharacters";
+    char *string3 = "firstmorecharacters";
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    MyString *str3 = myStringAlloc();
+    myStringSetFromCString(str1, string1);
+    myStringSetFromCString(str2, string2);
+    myStringCatTo(str1, str2, str3);
+    // checks that the length matches after catTo
+    if(myStringLen(str3) != myStringLen(str1) + myStringLen(str2))
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 19, myStringLen(str3));
+    }
+    myStringSetFromCString(str1, string3);
+    // Checks that two equal structs are compared properly
+    if(myStringEqual(str3, str1) == 0)
+    {
+        printf("String does not match expected after myStringCatTo\n");
+        printf("Expected: firstmorecharacters\n");
+        printf("Actual: %s\n", str3 -> stringArray);
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    myStringFree(str3);
+    printf("End test for myStringCatTo\n");
+}
+
+/**
+ * @brief Tester for myStringCat()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCat()
+{
+    printf("Start test for myStringCat\n");
+    char *string1 = "first";
+    char *string2 = "morecharacters";
+    char *string3 = "firstmorecharacters";
+    char *string4 = "firstmorecharactersfirstmorecharacters";
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    myStringSetFromCString(str1, string1);
+    myStringSetFromCString(str2, string2);
+    myStringCat(str1, str2);
+    myStringSetFromCString(str2, string3);
+    char *cString = myStringToCString(str1);
+    // Checks that length of structs is the same
+    if(myStringLen(str1) != myStringLen(str2))
+    {
+        printCalculatorHelper(STRING_LENGTH, __func__, 19, myStringLen(str1));
+    }
+    // Checks that two equal structs are compared properly
+    if(myStringEqual(str1, str2) == 0)
+    {
+        printf("String does not match expected after myStringCat\n");
+        printf("Expected: firstmorecharacters\n");
+        printf("Actual: %s\n", cString);
+    }
+    myStringCat(str1, str1);
+    myStringSetFromCString(str2, string4);
+    free(cString);
+    char *cString2 = myStringToCString(str1);
+    // Checks that two equal structs are compared properly
+    if(myStringEqual(str1, str2) == 0)
+    {
+        printf("String does not match expected after myStringCat with itself\n");
+        printf("Expected: firstmorecharactersfirstmorecharacters\n");
+        printf("Actual: %s\n", cString2);
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    free(cString2);
+    printf("End test for myStringCat\n");
+}
+
+
+/**
+ * @brief Tester for myStringCatMany()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCatMany()
+{
+    printf("Start test for myStringCatMany\n");
+    MyString *dest = myStringAlloc();
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    MyString *expected = myStringAlloc();
+    myStringSetFromCString(dest, "dest-");
+    myStringSetFromCString(str1, "first-");
+    myStringSetFromCString(str2, "second-");
+    myStringSetFromCString(expected, "dest-first-dest-second-dest-");
+    const MyString *sources[] = {str1, dest, str2, dest};
+    // checks that sources (including dest itself) are appended in order
+    if(myStringCatMany(dest, sources, 4) == MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    if(myStringEqual(dest, expected) == UNEQUAL)
+    {
+        char *cString = myStringToCString(dest);
+        printf("String does not match expected after myStringCatMany\n");
+        printf("Expected: dest-first-dest-second-dest-\n");
+        printf("Actual: %s\n", cString);
+        free(cString);
+    }
+    // checks that a NULL source fails without changing dest
+    const MyString *badSources[] = {str1, NULL};
+    if(myStringCatMany(dest, badSources, 2) != MYSTRING_ERROR ||
+       myStringEqual(dest, expected) == UNEQUAL)
+    {
+        printf("NULL source was not rejected in myStringCatMany\n");
+    }
+    myStringFree(dest);
+    myStringFree(str1);
+    myStringFree(str2);
+    myStringFree(expected);
+    printf("End test for myStringCatMany\n");
+}
+
+/**
+ * @brief Tester for myStringMemUsage()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringMemUsage()
+{
+    printf("Start test for myStringMemUsage\n");
+    MyString *str1 = myStringAlloc();
+    unsigned long memory = myStringMemUsage(str1);
+    unsigned long expectedSize = (sizeof(unsigned long) * 3) + sizeof(char *) +
+                                 sizeof(MyStringArena *) + sizeof(uint64_t) +
+                                 sizeof(char) * SHORT_SIZE;
+    if(memory != expectedSize)
+    {
+        printf("Memory does not match that expected for empty struct in myStringMemUsage\n");
+        printf("Expected: %lu\n", expectedSize);
+        printf("Actual: %lu\n", memory);
+    }
+    myStringSetFromCString(str1, "A string that is too long for the inline buffer");
+    memory = myStringMemUsage(str1);
+    expectedSize += sizeof(SharedArray) + myStringRealSize(str1);
+    if(memory != expectedSize)
+    {
+        printf("Memory does not match that expected for heap struct in myStringMemUsage\n");
+        printf("Expected: %lu\n", expectedSize);
+        printf("Actual: %lu\n", memory);
+    }
+    
+    myStringFree(str1);
+    printf("End test for myStringMemUsage\n");
+}
+
+/**
+ * @brief Tester for myStringSort()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSort()
+{
+    printf("Start test for myStringSort\n");
+    char *string1 = "Monkey";
+    char *string2 = "Bear";
+    char *string3 = "Giraffe";
+    char *string4 = "Mongoose";
+    char *string5 = "Sloth";
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    MyString *str3 = myStringAlloc();
+    MyString *str4 = myStringAlloc();
+    MyString *str5 = myStringAlloc();
+    myStringSetFromCString(str1, string1);
+    myStringSetFromCString(str2, string2);
+    myStringSetFromCString(str3, string3);
+    myStringSetFromCString(str4, string4);
+    myStringSetFromCString(str5, string5);
+    MyString* array[] = {str1, str2, str3, str4, str5};
+    myStringSort(array, 5);
+    // check that the array is properly sorted
+    for(int i = 0; i < 4; i++)
+    {
+        if(myStringCompare(array[i], array[i + 1]) != -1)
+        {
+            printf("Array was not sorted properly in testMyStringSort\n");
+            printf("Expected: -1\n");
+            printf("Actual: %d\n", myStringCompare(array[i], array[i + 1]));
+        }
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    myStringFree(str3);
+    myStringFree(str4);
+    myStringFree(str5);
+    printf("End test for myStringSort\n");
+}
+
+/**
+ * @brief Fills a buffer with a random string for the sort tests. The strings share long
+ *        prefixes, have many duplicates and use chars from all of the signed char range.
+ * @param buffer buffer of at least 40 chars.
+ * @param seed state of the random generator.
+ * RETURN VALUE:
+ * @return the length of the string.
+ */
+static int testSortHelper(char *buffer, unsigned int *seed)
+{
+    const char alphabet[] = {'a', 'b', 'A', (char) 0xE9, (char) 0x80, 0x7F, 1};
+    *seed = *seed * 1103515245 + 12345;
+    int length = (*seed >> 16) % 40;
+    for (int i = 0; i < length; i++)
+    {
+        *seed = *seed * 1103515245 + 12345;
+        // the first chars are mostly the same
+        buffer[i] = (i < 20 && (*seed >> 16) % 8 != 0) ? 'x' : alphabet[(*seed >> 16) % 7];
+    }
+    return length;
+}
+
+/**
+ * @brief Tester for the prefix sort behind myStringSort() and myStringCustomSort() with the
+ *        default comparator
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSortPrefix()
+{
+    printf("Start test for the prefix sort\n");
+    // every string of up to 10 chars made of 'a' and the smallest char (which is 0 in a prefix,
+    // like a missing char), 3 times
+    int count = 3 * 2047;
+    MyString **sorted = malloc(count * sizeof(MyString *));
+    MyString **expected = malloc(count * sizeof(MyString *));
+    char buffer[11];
+    unsigned int seed = 3;
+    for (int i = 0; i < count; i++)
+    {
+        int bits = i % 2047 + 1;
+        int length = 0;
+        for (; bits > 1; bits >>= 1)
+        {
+            buffer[length++] = (bits & 1) ? 'a' : (char) 0x80;
+        }
+        buffer[length] = NULL_BYTE;
+        expected[i] = myStringAlloc();
+        myStringSetFromCString(expected[i], buffer);
+    }
+    for (int i = count - 1; i > 0; i--)
+    {
+        seed = seed * 1103515245 + 12345;
+        MyString *temp = expected[i];
+        int j = (int) ((seed >> 8) % (i + 1));
+        expected[i] = expected[j];
+        expected[j] = temp;
+    }
+    memcpy(sorted, expected, count * sizeof(MyString *));
+    qsort(expected, count, sizeof(MyString *), myStringDefaultCompare);
+    for (int round = 0; round < 2; round++)
+    {
+        if (round == 0)
+        {
+            myStringSort(sorted, count);
+        }
+        else
+        {
+            myStringCustomSort(sorted, count, myStringDefaultCompare);
+        }
+        for (int i = 0; i < count; i++)
+        {
+            if (myStringCompare(sorted[i], expected[i]) != SAME)
+            {
+                printf("Array was not sorted properly by the prefix sort at %d\n", i);
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < count; i++)
+    {
+        myStringFree(expected[i]);
+    }
+    free(sorted);
+    free(expected);
+    printf("End test for the prefix sort\n");
+}
+
+/**
+ * @brief Orders pointers to MyString pointers by the address they point to.
+ */
+static int testSortAddressHelper(const void *str1, const void *str2)
+{
+    uintptr_t address1 = (uintptr_t) *(MyString * const *) str1;
+    uintptr_t address2 = (uintptr_t) *(MyString * const *) str2;
+    return (address1 > address2) - (address1 < address2);
+}
+
+/**
+ * @brief Tester for myStringSortStable() and the radix sort behind myStringSort()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSortStable()
+{
+    printf("Start test for myStringSortStable\n");
+    int count = 20000;
+    MyString **strings = malloc(count * sizeof(MyString *));
+    MyString **unstable = malloc(count * sizeof(MyString *));
+    MyString **stable = malloc(count * sizeof(MyString *));
+    char buffer[40];
+    unsigned int seed = 7;
+    for (int i = 0; i < count; i++)
+    {
+        strings[i] = myStringAlloc();
+        int length = testSortHelper(buffer, &seed);
+        myStringSetFromCString(strings[i], "");
+        for (int j = 0; j < length; j++)
+        {
+            MyString *single = myStringAlloc();
+            myStringSetFromCString(single, (char[]) {buffer[j], NULL_BYTE});
+            myStringCat(strings[i], single);
+            myStringFree(single);
+        }
+    }
+    memcpy(unstable, strings, count * sizeof(MyString *));
+    memcpy(stable, strings, count * sizeof(MyString *));
+    // the strings sorted by address, with their index in strings
+    MyString **byAddress = malloc(count * sizeof(MyString *));
+    int *indexes = malloc(count * sizeof(int));
+    memcpy(byAddress, strings, count * sizeof(MyString *));
+    qsort(byAddress, count, sizeof(MyString *), testSortAddressHelper);
+    for (int i = 0; i < count; i++)
+    {
+        MyString **found = bsearch(&strings[i], byAddress, count, sizeof(MyString *),
+                                   testSortAddressHelper);
+        indexes[found - byAddress] = i;
+    }
+    myStringSort(unstable, count);
+    myStringSortStable(stable, count);
+    // checks that both are sorted, and that equal strings kept their order in the stable sort
+    // (strings was allocated in order, so the order of equal strings shows in their indexes)
+    for (int i = 0; i + 1 < count; i++)
+    {
+        if (myStringCompare(unstable[i], unstable[i + 1]) > SAME)
+        {
+            printf("Array was not sorted properly in myStringSort at %d\n", i);
+            break;
+        }
+        int compare = myStringCompare(stable[i], stable[i + 1]);
+        if (compare > SAME)
+        {
+            printf("Array was not sorted properly in myStringSortStable at %d\n", i);
+            break;
+        }
+        if (compare == SAME)
+        {
+            MyString **found1 = bsearch(&stable[i], byAddress, count, sizeof(MyString *),
+                                        testSortAddressHelper);
+            MyString **found2 = bsearch(&stable[i + 1], byAddress, count, sizeof(MyString *),
+                                        testSortAddressHelper);
+            if (indexes[found1 - byAddress] > indexes[found2 - byAddress])
+            {
+                printf("Equal strings were swapped in myStringSortStable at %d\n", i);
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < count; i++)
+    {
+        myStringFree(strings[i]);
+    }
+    free(strings);
+    free(unstable);
+    free(stable);
+    free(byAddress);
+    free(indexes);
+    printf("End test for myStringSortStable\n");
+}
+
+/**
+ * @brief Comparator of MyString pointers ordering them from the biggest to the smallest.
+ */
+static int testReverseCompareHelper(const void *str1, const void *str2)
+{
+    return myStringDefaultCompare(str2, str1);
+}
+
+/**
+ * @brief Tester for myStringSortParallel() and myStringCustomSortParallel()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringSortParallel()
+{
+    printf("Start test for myStringSortParallel\n");
+    // enough strings for 5 chunks, so the merges have a run without a pair
+    int count = PARALLEL_SORT_CHUNK * 5 + 7;
+    MyString **serial = malloc(count * sizeof(MyString *));
+    MyString **parallel = malloc(count * sizeof(MyString *));
+    char buffer[41];
+    unsigned int seed = 11;
+    for (int i = 0; i < count; i++)
+    {
+        buffer[testSortHelper(buffer, &seed)] = NULL_BYTE;
+        serial[i] = myStringAlloc();
+        myStringSetFromCString(serial[i], buffer);
+    }
+    // checks that the order is the same as that of qsort for several thread counts
+    for (int threads = 1; threads <= 8; threads++)
+    {
+        memcpy(parallel, serial, count * sizeof(MyString *));
+        if (threads % 4 == 0)
+        {
+            // the public default comparator takes the path of myStringSortParallel
+            myStringCustomSortParallel(parallel, count, myStringDefaultCompare, threads);
+        }
+        else if (threads % 2 == 0)
+        {
+            myStringSortParallel(parallel, count, threads);
+        }
+        else
+        {
+            myStringCustomSortParallel(parallel, count, testReverseCompareHelper, threads);
+        }
+        MyString **expected = malloc(count * sizeof(MyString *));
+        memcpy(expected, serial, count * sizeof(MyString *));
+        // qsort with myStringCompare, so the chars from 0x80 up are ordered like it orders them
+        // and not as the other sorts happen to
+        qsort(expected, count, sizeof(MyString *),
+              (threads % 2 == 0) ? myStringDefaultCompare : testReverseCompareHelper);
+        for (int i = 0; i < count; i++)
+        {
+            if (myStringCompare(expected[i], parallel[i]) != SAME)
+            {
+                printf("Array was not sorted properly in myStringSortParallel with %d threads\n",
+                       threads);
+                break;
+            }
+        }
+        free(expected);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        myStringFree(serial[i]);
+    }
+    free(serial);
+    free(parallel);
+    printf("End test for myStringSortParallel\n");
+}
+
+/**
+ * @brief Tester for myStringCustomSort()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCustomSort()
+{
+    printf("Start test for myStringCustomSort\n");
+    
+    char *string1 = "bird";
+    char *string2 = "mouse";
+    char *string3 = "cat";
+    char *string4 = "Dog";
+    char *string5 = "elephant";
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    MyString *str3 = myStringAlloc();
+    MyString *str4 = myStringAlloc();
+    MyString *str5 = myStringAlloc();
+    myStringSetFromCString(str1, string1);
+    myStringSetFromCString(str2, string2);
+    myStringSetFromCString(str3, string3);
+    myStringSetFromCString(str4, string4);
+    myStringSetFromCString(str5, string5);
+    MyString* array[] = {str1, str2, str3, str4, str5};
+    myStringCustomSort(array, 5, myStringDefaultCompare);
+    // checks that the array is properly sorted
+    for(int i = 0; i < 4; i++)
+    {
+        if(myStringCompare(array[i], array[i + 1]) != -1)
+        {
+            printf("Array was not sorted properly in testMyStringCustomSort\n");
+            printf("Expected: -1\n");
+            printf("Actual: %d\n", myStringCompare(array[i], array[i + 1]));
+        }
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    myStringFree(str3);
+    myStringFree(str4);
+    myStringFree(str5);
+
+    
+    printf("End test for myStringCustomSort\n");
+}
+
+/**
+ * @brief Helper for testMyStringPool()
+ *        Interns the numbers 0 to 999 in a pool 10 times, from a different thread.
+ * @param pool the pool to intern in
+ * RETURN VALUE:
+ * @return the array of the 1000 canonical strings (the caller frees it)
+ */
+static void *testMyStringPoolHelper(void *pool)
+{
+    const MyString **canonical = malloc(1000 * sizeof(MyString *));
+    MyString *str = myStringAlloc();
+    for (int round = 0; round < 10; round++)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            myStringSetFromInt(str, i);
+            canonical[i] = myStringIntern(pool, str);
+        }
+    }
+    myStringFree(str);
+    return canonical;
+}
+
+/**
+ * @brief Tester for the MyStringPool functions
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringPool()
+{
+    printf("Start test for MyStringPool\n");
+    MyStringPool *pool = myStringPoolCreate();
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    myStringSetFromCString(str1, "identifier");
+    myStringSetFromCString(str2, "identifier");
+    // checks that equal strings are interned to the same pointer and unequal ones are not
+    const MyString *canonical1 = myStringIntern(pool, str1);
+    const MyString *canonical2 = myStringIntern(pool, str2);
+    myStringSetFromCString(str2, "another identifier");
+    const MyString *canonical3 = myStringIntern(pool, str2);
+    if(canonical1 == NULL || canonical1 != canonical2 || canonical1 == canonical3 ||
+       myStringEqual(canonical1, str1) == UNEQUAL || myStringEqual(canonical3, str2) == UNEQUAL)
+    {
+        printf("Strings were not interned properly in myStringIntern.\n");
+    }
+    // checks that many threads interning the same strings get the same pointers
+    pthread_t threads[4];
+    const MyString **results[4];
+    for (int i = 0; i < 4; i++)
+    {
+        pthread_create(&threads[i], NULL, testMyStringPoolHelper, pool);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        pthread_join(threads[i], (void **) &results[i]);
+    }
+    for (int i = 0; i < 1000; i++)
+    {
+        if(results[1][i] != results[0][i] || results[2][i] != results[0][i] ||
+           results[3][i] != results[0][i] || myStringToInt(results[0][i]) != i)
+        {
+            printf("Threads got different canonical strings in myStringIntern.\n");
+            break;
+        }
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        free(results[i]);
+    }
+    // checks the statistics
+    MyStringPoolStats stats;
+    myStringPoolGetStats(pool, &stats);
+    if(stats.lookups != 40003 || stats.hits != 39001 || stats.uniqueStrings != 1002 ||
+       stats.bytesSaved < 39001 * (sizeof(MyString) + SHORT_SIZE))
+    {
+        printCalculatorHelper("Pool hits", __func__, 39001, stats.hits);
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    myStringPoolDestroy(pool);
+    printf("End test for MyStringPool\n");
+}
+
+/**
+ * @brief Tester for myStringHash()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringHash()
 {
-    printf("Start test for myStringEqual\n");
-    char *equalString = "equal string";
-    char *unequalString = "unequal string";
-    MyString *struct1 = myStringAlloc();
-    MyString *struct2 = myStringAlloc();
-    myStringSetFromCString(struct1, equalString);
-    myStringSetFromCString(struct2, equalString);
-    // check that equal recognizes that MyStrings are equal
-    if (myStringEqual(struct1, struct2) == UNEQUAL)
+    printf("Start test for myStringHash\n");
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    myStringSetFromCString(str1, "A string that is too long for the inline buffer");
+    myStringSetFromCString(str2, "A string that is too long for the inline buffer");
+    uint64_t hash = myStringHash(str1);
+    // checks that equal strings hash the same and that the hash is cached
+    if(hash != myStringHash(str2) || atomic_load(&str1 -> hash) != hash)
+    {
+        printf("Equal strings hashed differently in myStringHash.\n");
+    }
+    // checks that changing the string drops the cached hash
+    myStringCat(str1, str2);
+    if(atomic_load(&str1 -> hash) != NO_HASH || myStringHash(str1) == hash)
+    {
+        printf("Cached hash was not dropped by myStringCat in myStringHash.\n");
+    }
+    // checks that every length hashes differently
+    myStringSetFromCString(str1, "");
+    for (int i = 0; i < 100; i++)
+    {
+        hash = myStringHash(str1);
+        myStringCat(str1, str2);
+        myStringSetFromCString(str2, "x");
+        if(myStringHash(str1) == hash)
+        {
+            printf("Strings of different lengths hashed the same in myStringHash.\n");
+        }
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    printf("End test for myStringHash\n");
+}
+
+/**
+ * @brief Tester for the MyStringMap functions
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringMap()
+{
+    printf("Start test for MyStringMap\n");
+    MyStringMap *map = myStringMapCreate();
+    MyString *key = myStringAlloc();
+    static int values[10000];
+    // checks that inserted keys are found with their values
+    for (int i = 0; i < 10000; i++)
+    {
+        myStringSetFromInt(key, i);
+        values[i] = i;
+        if(myStringMapInsert(map, key, &values[i]) == MYSTRING_ERROR)
+        {
+            printImproperError(__func__, __LINE__);
+        }
+    }
+    for (int i = 0; i < 10000; i++)
+    {
+        void *value = NULL;
+        myStringSetFromInt(key, i);
+        if(!myStringMapFind(map, key, &value) || value != &values[i])
+        {
+            printf("Key %d was not found in MyStringMap.\n", i);
+            break;
+        }
+    }
+    // checks that erasing and inserting over and over reuses the tombstones in place
+    unsigned long capacity = map -> capacity;
+    for (int round = 0; round < 20; round++)
+    {
+        for (int i = 0; i < 5000; i++)
+        {
+            myStringSetFromInt(key, round * 5000 + i);
+            myStringMapErase(map, key);
+            myStringSetFromInt(key, (round + 1) * 5000 + i + 5000);
+            myStringMapInsert(map, key, NULL);
+        }
+    }
+    if(myStringMapSize(map) != 10000 || map -> capacity != capacity)
+    {
+        printCalculatorHelper("Map size", __func__, 10000, myStringMapSize(map));
+    }
+    for (int i = 0; i < 110000; i++)
+    {
+        myStringSetFromInt(key, i);
+        if(myStringMapFind(map, key, NULL) != (i >= 100000))
+        {
+            printf("Key %d was found wrongly in MyStringMap after erasing.\n", i);
+            break;
+        }
+    }
+    // checks that inserting an existing key replaces its value
+    myStringMapInsert(map, key, &values[0]);
+    void *value = NULL;
+    if(!myStringMapFind(map, key, &value) || value != &values[0] || myStringMapSize(map) != 10000)
+    {
+        printf("Value was not replaced in myStringMapInsert.\n");
+    }
+    myStringFree(key);
+    myStringMapDestroy(map);
+    printf("End test for MyStringMap\n");
+}
+
+/**
+ * @brief Char comparator equal to defCompare, which the compare functions do not recognize, so
+ *        the tests can get the result of calling a comparator on every char.
+ */
+static int testCompareHelper(const char *char1, const char *char2)
+{
+    return defCompare(char1, char2);
+}
+
+/**
+ * @brief Char comparator equal to myStringCharCaseCompare, which the compare functions do not
+ *        recognize.
+ */
+static int testCaseCompareHelper(const char *char1, const char *char2)
+{
+    return myStringCharCaseCompare(char1, char2);
+}
+
+/**
+ * @brief Tester for the compare kernels used by myStringCompare() and myStringEqual()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringCompareKernels()
+{
+    printf("Start test for the compare kernels\n");
+    CompareKernels kernels[3];
+    int kernelCount = listCompareKernels(kernels);
+    char chars1[100];
+    char chars2[100];
+    unsigned int seed = 1;
+    // checks every kernel against comparing char by char, with mismatches at every index and
+    // chars from all of the signed char range
+    for (int length = 0; length < 100; length++)
+    {
+        for (int i = 0; i < length; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            chars1[i] = (char) (seed >> 16);
+            chars2[i] = (seed & 0x100) ? chars1[i] : (char) (chars1[i] ^ CASE_DIFFERENCE);
+        }
+        for (int i = 0; i < length; i++)
+        {
+            chars2[i] = (char) (chars2[i] ^ 1);
+            unsigned long expected = 0;
+            while (chars1[expected] == chars2[expected])
+            {
+                expected++;
+            }
+            unsigned long expectedCase = 0;
+            while (expectedCase < (unsigned long) length &&
+                   foldCase(chars1[expectedCase]) == foldCase(chars2[expectedCase]))
+            {
+                expectedCase++;
+            }
+            for (int k = 0; k < kernelCount; k++)
+            {
+                if (kernels[k].mismatch(chars1, chars2, length) != expected ||
+                    kernels[k].caseMismatch(chars1, chars2, length) != expectedCase)
+                {
+                    printf("Compare kernel %d found a wrong mismatch at length %d.\n", k, length);
+                }
+            }
+            chars2[i] = (char) (chars2[i] ^ 1);
+        }
+    }
+    // checks that the recognized comparators give what calling them on every char gives
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    const char *words[] = {"", "a", "A", "abc", "aBc", "ab", "abcd", "\xe9t\xe9", "et\xe9",
+                           "A string that is too long for the inline buffer",
+                           "A string that is too long for the inline bufFer",
+                           "a STRING that is too long for the inline buffer!"};
+    int wordCount = sizeof(words) / sizeof(words[0]);
+    for (int i = 0; i < wordCount; i++)
+    {
+        for (int j = 0; j < wordCount; j++)
+        {
+            myStringSetFromCString(str1, words[i]);
+            myStringSetFromCString(str2, words[j]);
+            if (myStringCompare(str1, str2) !=
+                myStringCustomCompare(str1, str2, testCompareHelper) ||
+                myStringEqual(str1, str2) != myStringCustomEqual(str1, str2, testCompareHelper) ||
+                myStringCustomCompare(str1, str2, myStringCharCaseCompare) !=
+                myStringCustomCompare(str1, str2, testCaseCompareHelper) ||
+                myStringCustomEqual(str1, str2, myStringCharCaseCompare) !=
+                myStringCustomEqual(str1, str2, testCaseCompareHelper))
+            {
+                printf("Compare kernel changed the result for \"%s\" and \"%s\".\n",
+                       words[i], words[j]);
+            }
+        }
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    printf("End test for the compare kernels\n");
+}
+
+/**
+ * @brief Tester for myStringNaturalCompare()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringNaturalCompare()
+{
+    printf("Start test for myStringNaturalCompare\n");
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    // every word is smaller than the next one
+    const char *words[] = {"", "01", "1", "2", "10", "a", "a0", "a1", "a9", "a9b", "a10", "a10b",
+                           "a11", "b", "file2 part 9", "file2 part 10", "file10 part 1",
+                           "file0000000000000000000000000000000000000000011",
+                           "file123456789012345678901234567890"};
+    int wordCount = sizeof(words) / sizeof(words[0]);
+    for (int i = 0; i < wordCount; i++)
+    {
+        for (int j = 0; j < wordCount; j++)
+        {
+            myStringSetFromCString(str1, words[i]);
+            myStringSetFromCString(str2, words[j]);
+            int expected = (i > j) - (i < j);
+            if (myStringNaturalCompare(str1, str2) != expected)
+            {
+                printf("myStringNaturalCompare ordered \"%s\" and \"%s\" wrongly.\n",
+                       words[i], words[j]);
+            }
+        }
+    }
+    if (myStringNaturalCompare(str1, NULL) != MYSTR_ERROR_CODE)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    myStringFree(str1);
+    myStringFree(str2);
+    printf("End test for myStringNaturalCompare\n");
+}
+
+/**
+ * @brief Tester for myStringWrite()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringWrite()
+{
+    printf("Start test for myStringWrite\n");
+    FILE* newFile = fopen("newFile", "w");
+    char *stringWrite = "Write this to file";
+    MyString *str1 = myStringAlloc();
+    myStringSetFromCString(str1, stringWrite);
+    myStringWrite(str1, newFile);
+    char buffer[19];
+    fclose(newFile);
+    newFile = fopen("newFile", "r");
+    fgets(buffer, (int) myStringLen(str1) + 1, newFile);
+    MyString *str2 = myStringAlloc();
+    myStringSetFromCString(str2, buffer);
+    if(myStringEqual(str1, str2) == 0)
+    {
+        printf("Array was not sorted properly in testMyStringWrite\n");
+        printf("Expected: 1\n");
+        printf("Actual: 0\n");
+    }
+    fclose(newFile);
+    // checks that null bytes are written too
+    myStringSetFromCString(str1, "null byte");
+    str1 -> stringArray[4] = NULL_BYTE;
+    newFile = tmpfile();
+    myStringWrite(str1, newFile);
+    rewind(newFile);
+    if(fread(buffer, sizeof(char), sizeof(buffer), newFile) != 9 ||
+       memcmp(buffer, "null\0byte", 9) != 0)
+    {
+        printf("Null byte was not written in testMyStringWrite\n");
+    }
+    fclose(newFile);
+    myStringFree(str1);
+    myStringFree(str2);
+    printf("End test for myStringWrite\n");
+}
+
+/**
+ * @brief Reads a whole file for the writer tests.
+ * @param file the file.
+ * @param buffer buffer of at least 100 chars, filled with the file and a null byte.
+ * RETURN VALUE:
+ * @return the length of the file.
+ */
+static unsigned long testWriterHelper(FILE *file, char *buffer)
+{
+    rewind(file);
+    unsigned long length = fread(buffer, sizeof(char), 99, file);
+    buffer[length] = NULL_BYTE;
+    return length;
+}
+
+/**
+ * @brief Tester for the MyStringWriter functions
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringWriter()
+{
+    printf("Start test for MyStringWriter\n");
+    char buffer[100];
+    MyString *str = myStringAlloc();
+    myStringSetFromCString(str, "word");
+    MyStringWriterStats stats = {0};
+    // checks that a small buffer is flushed when it is full, and that ints and separators are
+    // written properly
+    FILE *file = tmpfile();
+    MyStringWriter *writer = myStringWriterCreate(file, 16, MYSTRING_FLUSH_SIZE, 0);
+    for (int i = 0; i < 3; i++)
+    {
+        myStringWriterWrite(writer, str);
+        myStringWriterWriteChar(writer, ' ');
+        myStringWriterWriteInt(writer, -123456789 + i);
+        myStringWriterWriteCString(writer, ", ");
+    }
+    myStringWriterGetStats(writer, &stats);
+    if (stats.flushes == 0 || stats.bytesWritten >= 51 ||
+        stats.bytesWritten != testWriterHelper(file, buffer))
+    {
+        printf("Buffer was not flushed when full in testMyStringWriter\n");
+    }
+    myStringWriterDestroy(writer);
+    testWriterHelper(file, buffer);
+    if (strcmp(buffer, "word -123456789, word -123456788, word -123456787, ") != 0)
+    {
+        printf("Wrong output in testMyStringWriter: %s\n", buffer);
+    }
+    fclose(file);
+    // checks that the lines policy flushes after every 2 lines, and that ints are like
+    // myStringSetFromInt
+    file = tmpfile();
+    writer = myStringWriterCreateFd(fileno(file), 0, MYSTRING_FLUSH_LINES, 2);
+    myStringWriterWriteInt(writer, 0);
+    myStringWriterWriteCString(writer, "\n1\n2");
+    myStringWriterGetStats(writer, &stats);
+    if (stats.flushes != 1 || testWriterHelper(file, buffer) != 5)
+    {
+        printf("Buffer was not flushed after 2 lines in testMyStringWriter\n");
+    }
+    myStringWriterWriteChar(writer, NEW_LINE);
+    myStringWriterGetStats(writer, &stats);
+    if (stats.flushes != 1 || testWriterHelper(file, buffer) != 5)
+    {
+        printf("Buffer was flushed after 1 line in testMyStringWriter\n");
+    }
+    myStringWriterDestroy(writer);
+    if (testWriterHelper(file, buffer) != 6 || strcmp(buffer, "0\n1\n2\n") != 0)
+    {
+        printf("Wrong output in testMyStringWriter: %s\n", buffer);
+    }
+    fclose(file);
+    // checks that the explicit policy grows the buffer instead of flushing
+    file = tmpfile();
+    writer = myStringWriterCreate(file, 4, MYSTRING_FLUSH_EXPLICIT, 0);
+    for (int i = 0; i < 10; i++)
+    {
+        myStringWriterWrite(writer, str);
+    }
+    myStringWriterGetStats(writer, &stats);
+    if (stats.flushes != 0 || testWriterHelper(file, buffer) != 0)
+    {
+        printf("Buffer was flushed without a call in testMyStringWriter\n");
+    }
+    myStringWriterFlush(writer);
+    myStringWriterGetStats(writer, &stats);
+    if (stats.flushes != 1 || stats.bytesWritten != 40 || testWriterHelper(file, buffer) != 40)
+    {
+        printf("Buffer was not flushed by myStringWriterFlush in testMyStringWriter\n");
+    }
+    myStringWriterDestroy(writer);
+    fclose(file);
+    if (myStringWriterCreate(NULL, 0, MYSTRING_FLUSH_SIZE, 0) != NULL ||
+        myStringWriterCreateFd(0, 0, MYSTRING_FLUSH_LINES, 0) != NULL)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    myStringFree(str);
+    printf("End test for MyStringWriter\n");
+}
+
+/**
+ * @brief Tester for myStringReadLine(), myStringReadUntil() and the MyStringLineReader functions
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringReadLine()
+{
+    printf("Start test for myStringReadLine\n");
+    // a long line, an empty line, a line with a null byte and a last line without a new line
+    char longLine[3000];
+    memset(longLine, 'x', sizeof(longLine) - 1);
+    longLine[sizeof(longLine) - 1] = NULL_BYTE;
+    const char *lines[] = {"first,line", longLine, "", "null\0byte", "last"};
+    unsigned long lengths[] = {10, sizeof(longLine) - 1, 0, 9, 4};
+    FILE *file = tmpfile();
+    for (int i = 0; i < 5; i++)
+    {
+        fwrite(lines[i], sizeof(char), lengths[i], file);
+        if (i < 4)
+        {
+            fputc(NEW_LINE, file);
+        }
+    }
+    fflush(file);
+    rewind(file);
+    MyString *str = myStringAlloc();
+    for (int i = 0; i < 5; i++)
+    {
+        if (myStringReadLine(str, file) != MYSTRING_SUCCESS || myStringLen(str) != lengths[i] ||
+            memcmp(str -> stringArray, lines[i], lengths[i]) != 0)
+        {
+            printf("Line %d was not read properly in myStringReadLine\n", i);
+        }
+    }
+    if (myStringReadLine(str, file) != MYSTRING_EOF || myStringLen(str) != 0)
+    {
+        printf("End of file was not found in myStringReadLine\n");
+    }
+    // checks reading up to another delim
+    rewind(file);
+    if (myStringReadUntil(str, file, ',') != MYSTRING_SUCCESS || myStringLen(str) != 5 ||
+        myStringReadUntil(str, file, NEW_LINE) != MYSTRING_SUCCESS || myStringLen(str) != 4)
+    {
+        printf("Line was not split at the delim in myStringReadUntil\n");
+    }
+    // checks the line reader, with a buffer smaller than the long line (the stream may not
+    // have moved the file descriptor back when rewinding within its own buffer)
+    lseek(fileno(file), 0, SEEK_SET);
+    MyStringLineReader *reader = myStringLineReaderCreate(fileno(file), NEW_LINE, 64);
+    const char *line = NULL;
+    unsigned long length = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        if (myStringLineReaderNext(reader, &line, &length) != MYSTRING_SUCCESS ||
+            length != lengths[i] || memcmp(line, lines[i], lengths[i]) != 0)
+        {
+            printf("Line %d was not read properly in myStringLineReaderNext\n", i);
+        }
+    }
+    if (myStringLineReaderNext(reader, &line, &length) != MYSTRING_EOF)
+    {
+        printf("End of file was not found in myStringLineReaderNext\n");
+    }
+    myStringLineReaderDestroy(reader);
+    fclose(file);
+    myStringFree(str);
+    printf("End test for myStringReadLine\n");
+}
+
+/**
+ * @brief Tester for myStringWriteMany() and myStringWriteManyFd()
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringWriteMany()
+{
+    printf("Start test for myStringWriteMany\n");
+    // more strings than a single writev takes
+    unsigned long count = WRITE_BATCH_SIZE * 2 + 1;
+    MyString **strs = malloc(count * sizeof(MyString *));
+    unsigned long expectedLength = 0;
+    for (unsigned long i = 0; i < count; i++)
+    {
+        strs[i] = myStringAlloc();
+        myStringSetFromInt(strs[i], (int) i);
+        expectedLength += myStringLen(strs[i]) + 1;
+    }
+    MyString *sep = myStringAlloc();
+    myStringSetFromCString(sep, "\n");
+    char *buffer = malloc(expectedLength + 1);
+    for (int round = 0; round < 2; round++)
+    {
+        FILE *newFile = tmpfile();
+        MyStringRetVal result;
+        if (round == 0)
+        {
+            result = myStringWriteMany((const MyString * const *) strs, count, sep, newFile);
+            fflush(newFile);
+        }
+        else
+        {
+            result = myStringWriteManyFd((const MyString * const *) strs, count, sep,
+                                         fileno(newFile));
+        }
+        rewind(newFile);
+        unsigned long length = fread(buffer, sizeof(char), expectedLength + 1, newFile);
+        buffer[length] = NULL_BYTE;
+        // checks the file holds every number on its own line
+        char *line = buffer;
+        for (unsigned long i = 0; i < count && result == MYSTRING_SUCCESS; i++)
+        {
+            if (strtol(line, &line, 10) != (long) i || *line++ != '\n')
+            {
+                result = MYSTRING_ERROR;
+            }
+        }
+        if (result == MYSTRING_ERROR || length != expectedLength)
+        {
+            printf("Strings were not written properly in round %d of testMyStringWriteMany\n",
+                   round);
+        }
+        fclose(newFile);
+    }
+    // empty strings and an empty separator are skipped, not written again and again
+    MyString *empty = myStringAlloc();
+    const MyString *empties[] = {empty, empty, empty};
+    FILE *newFile = tmpfile();
+    if (newFile != NULL)
+    {
+        if (myStringWriteManyFd(empties, 3, empty, fileno(newFile)) == MYSTRING_ERROR ||
+            myStringWriteMany(empties, 3, empty, newFile) == MYSTRING_ERROR ||
+            ftell(newFile) != 0)
+        {
+            printf("Empty strings were not written properly in testMyStringWriteMany\n");
+        }
+        fclose(newFile);
+    }
+    myStringFree(empty);
+    for (unsigned long i = 0; i < count; i++)
+    {
+        myStringFree(strs[i]);
+    }
+    free(strs);
+    free(buffer);
+    myStringFree(sep);
+    printf("End test for myStringWriteMany\n");
+}
+
+/**
+ * @brief Tester for MyStringView and its functions
+ *
+ * RETURN VALUE: none
+ */
+static void testMyStringView()
+{
+    printf("Start test for MyStringView\n");
+    MyString *str = myStringAlloc();
+    myStringSetFromCString(str, "-1234 is a number that is too long for the inline buffer");
+    MyStringView view = myStringViewOf(str);
+    MyStringView number = myStringViewSlice(view, 0, 5);
+    // checks that the views of a MyString, a C string and a buffer agree with the MyString
+    if(view.length != myStringLen(str) || !myStringViewEqual(view,
+       myStringViewOfCString("-1234 is a number that is too long for the inline buffer")) ||
+       myStringViewHash(view) != myStringHash(str) || myStringViewToInt(number) != -1234 ||
+       myStringViewToInt(view) != MYSTR_ERROR_CODE)
     {
-        printComparisonHelper("equality test", __func__, EQUAL,
-                              UNEQUAL);
+        printf("View differs from its MyString in MyStringView.\n");
     }
-    myStringSetFromCString(struct2, unequalString);
-    // check that equal recognizes that MyStrings are unequal
-    if (myStringEqual(struct1, struct2) == EQUAL)
+    // checks compare against myStringCompare, including a prefix and a null byte
+    const char *strings[] = {"", "a", "ab", "abc", "abd", "b"};
+    MyString *other = myStringAlloc();
+    for (int i = 0; i < 6; i++)
     {
-        printComparisonHelper("equality test", __func__, UNEQUAL,
-                              EQUAL);
+        for (int j = 0; j < 6; j++)
+        {
+            myStringSetFromCString(str, strings[i]);
+            myStringSetFromCString(other, strings[j]);
+            int expected = myStringCompare(str, other);
+            int result = myStringViewCompare(myStringViewOfCString(strings[i]),
+                                             myStringViewOfCString(strings[j]));
+            if((expected > 0) != (result > 0) || (expected < 0) != (result < 0))
+            {
+                printf("Wrong result for \"%s\" and \"%s\" in myStringViewCompare.\n",
+                       strings[i], strings[j]);
+            }
+        }
     }
-    myStringFree(struct1);
-    myStringFree(struct2);
-    printf("End test for myStringCustomEqual\n");
+    if(myStringViewCompare(myStringViewOfBuffer("a\0b", 3), myStringViewOfBuffer("a\0c", 3)) >= 0 ||
+       myStringViewEqual(myStringViewOfBuffer("a\0b", 3), myStringViewOfCString("a")))
+    {
+        printf("Null byte ended the view in myStringViewCompare.\n");
+    }
+    // checks find, including a repeated first char, a match at the end and no match
+    unsigned long index = 1;
+    view = myStringViewOfCString("aaab,aab,ab");
+    if(!myStringViewFind(view, myStringViewOfCString("aab"), &index) || index != 1 ||
+       !myStringViewFind(view, myStringViewOfCString(",ab"), &index) || index != 8 ||
+       myStringViewFind(view, myStringViewOfCString("abb"), &index) ||
+       myStringViewFind(myStringViewOfCString("ab"), myStringViewOfCString("abc"), NULL) ||
+       !myStringViewFind(view, myStringViewOfCString(""), &index) || index != 0)
+    {
+        printf("Wrong occurrence in myStringViewFind.\n");
+    }
+    // checks setting a MyString from a view of itself and from a view of another string
+    myStringSetFromCString(str, "A string that is too long for the inline buffer, twice over");
+    myStringSetFromView(str, myStringViewSlice(myStringViewOf(str), 2, 6));
+    myStringSetFromView(other, myStringViewOf(str));
+    if(!myStringViewEqual(myStringViewOf(other), myStringViewOfCString("string")) ||
+       myStringHash(str) != myStringViewHash(myStringViewOfCString("string")))
+    {
+        printf("Wrong value after myStringSetFromView.\n");
+    }
+    myStringSetFromView(other, myStringViewOfCString(NULL));
+    if(myStringLen(other) != 0 || myStringSetFromView(NULL, view) != MYSTRING_ERROR)
+    {
+        printf("Wrong value for an empty view in myStringSetFromView.\n");
+    }
+    myStringFree(str);
+    myStringFree(other);
+    printf("End test for MyStringView\n");
 }
 
-
 /**
- * @brief Tester for myStringSetFromInt()
+ * @brief Tester for myStringSplit(), myStringTokenize() and myStringSplitNext()
  *
  * RETURN VALUE: none
  */
-static void testMyStringSetFromInt()
+static void testMyStringSplit()
 {
-    printf("Start test for myStringSetFromInt\n");
-
-    char *correctIntString = "1234";
-    char *negativeIntString = "-1234";
-    char *complexIntString = "1234567";
-    char *complexNegativeString = "-1234567";
-    int correctInt = 1234;
-    int negativeInt = -1234;
-    int complexInt = 1234567;
-    int complexNegative = -1234567;
-    MyString *testStructInt = myStringAlloc();
-    MyString *testStructString = myStringAlloc();
-    myStringSetFromInt(testStructInt, correctInt);
-    myStringSetFromCString(testStructString, correctIntString);
-    // test that int was copied properly into MyString
-    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    printf("Start test for myStringSplit\n");
+    // checks that every delim ends a field, including empty fields at the edges
+    const char *fields[] = {"", "name", "", "42", "x y", ""};
+    MyStringSplitter splitter = myStringSplit(myStringViewOfCString(",name,,42,x y,"), ',');
+    MyStringView field;
+    int count = 0;
+    while (myStringSplitNext(&splitter, &field))
     {
-        printComparisonHelper("int", __func__, EQUAL, UNEQUAL);
+        if(count >= 6 || !myStringViewEqual(field, myStringViewOfCString(fields[count])))
+        {
+            printf("Wrong field %d in myStringSplit.\n", count);
+        }
+        count++;
     }
-    myStringSetFromInt(testStructInt, negativeInt);
-    myStringSetFromCString(testStructString, negativeIntString);
-    // test that negative int was copied properly into MyString
-    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    if(count != 6 || myStringSplitNext(&splitter, &field))
     {
-        printComparisonHelper("negative int", __func__, EQUAL, UNEQUAL);
-
+        printf("Wrong amount of fields in myStringSplit.\n");
     }
-    myStringSetFromInt(testStructInt, complexInt);
-    myStringSetFromCString(testStructString, complexIntString);
-    // test that complex int was copied properly into MyString
-    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    // checks that an empty view has a single empty field
+    splitter = myStringSplit(myStringViewOfCString(""), ',');
+    count = 0;
+    while (myStringSplitNext(&splitter, &field))
     {
-        printComparisonHelper("complex int", __func__, EQUAL, UNEQUAL);
-
+        count += (field.length == 0) ? 1 : 2;
     }
-    myStringSetFromInt(testStructInt, complexNegative);
-    myStringSetFromCString(testStructString, complexNegativeString);
-    // test that complex negative int was copied properly into MyString
-    if(myStringEqual(testStructInt, testStructString) == UNEQUAL)
+    if(count != 1)
     {
-        printComparisonHelper("complex negative int", __func__, EQUAL, UNEQUAL);
-
+        printf("Wrong fields for an empty view in myStringSplit.\n");
     }
-    myStringFree(testStructInt);
-    myStringFree(testStructString);
-    printf("End test for myStringSetFromInt\n");
+    // checks that tokenize skips runs of delims and has no empty tokens
+    const char *tokens[] = {"int", "x", "=", "-7;"};
+    splitter = myStringTokenize(myStringViewOfCString(" \tint  x\t= -7;\n"),
+                                myStringViewOfCString(" \t\n"));
+    count = 0;
+    while (myStringSplitNext(&splitter, &field))
+    {
+        if(count >= 4 || !myStringViewEqual(field, myStringViewOfCString(tokens[count])))
+        {
+            printf("Wrong token %d in myStringTokenize.\n", count);
+        }
+        count++;
+    }
+    splitter = myStringTokenize(myStringViewOfCString(" \t "), myStringViewOfCString(" \t"));
+    if(count != 4 || myStringSplitNext(&splitter, &field))
+    {
+        printf("Wrong amount of tokens in myStringTokenize.\n");
+    }
+    printf("End test for myStringSplit\n");
 }
 
 /**
- * @brief Helper for testMyStringFilter()
- *        Simple filter for test purposes
- * @param char we wish to check
+ * @brief Helper for testMyStringFind()
+ *        Counts the occurrences of needle in haystack by comparing at every index.
  * RETURN VALUE:
- * @return true if char is equal to a, false otherwise
+ * @return the amount of occurrences, whose indices are stored in indices.
  */
-static bool testMyStringFilterHelper(const char *char1)
+static unsigned long testMyStringFindHelper(const char *haystack, unsigned long length,
+                                            const char *needle, unsigned long needleLength,
+                                            bool cyclic, unsigned long *indices)
 {
-    if(*char1 == 'a')
+    unsigned long count = 0;
+    unsigned long starts = cyclic ? length : (needleLength <= length) ?
+                           length - needleLength + 1 : 0;
+    for (unsigned long i = 0; i < starts; i++)
     {
-        return true;
+        unsigned long k = 0;
+        while (k < needleLength && needle[k] == haystack[(i + k) % length])
+        {
+            k++;
+        }
+        if (k == needleLength)
+        {
+            indices[count++] = i;
+        }
     }
-    return false;
+    return count;
 }
+
 /**
- * @brief Tester for myStringFilter()
+ * @brief Tester for myStringFind(), myStringFindAll() and myStringCount()
  *
  * RETURN VALUE: none
  */
-static void testMyStringFilter()
+static void testMyStringFind()
 {
-    printf("Start test for myStringSetFilter\n");
-    char *testString = "abacadae";
-    char *testString2 = "bcde";
-    MyString *testStruct = myStringAlloc();
-    MyString *testStruct2 = myStringAlloc();
-    myStringSetFromCString(testStruct, testString);
-    myStringSetFromCString(testStruct2, testString2);
-    // test that filter does not return error
-    if (myStringFilter(testStruct, testMyStringFilterHelper) == MYSTRING_ERROR)
+    printf("Start test for myStringFind\n");
+    MyString *haystack = myStringAlloc();
+    MyString *needle = myStringAlloc();
+    // the examples of the cyclic search
+    const char *cases[][2] = {{"abcabc", "bca"}, {"aaa", "aa"}, {"ab", "aba"}, {"a", "aaa"},
+                              {"abcabc", "abcabca"}, {"", "a"}, {"abc", ""}};
+    unsigned long counts[][2] = {{1, 2}, {2, 3}, {0, 1}, {0, 1}, {0, 2}, {0, 0}, {0, 0}};
+    for (unsigned long i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
     {
-        printImproperError(__func__, __LINE__);
+        myStringSetFromCString(haystack, cases[i][0]);
+        myStringSetFromCString(needle, cases[i][1]);
+        if (myStringCount(haystack, needle, false) != counts[i][0] ||
+            myStringCount(haystack, needle, true) != counts[i][1])
+        {
+            printf("Wrong count of \"%s\" in \"%s\".\n", cases[i][1], cases[i][0]);
+        }
     }
-    // test that two strings are equal after filter
-    if(myStringEqual(testStruct2, testStruct) == UNEQUAL)
+    unsigned long index = 0;
+    myStringSetFromCString(haystack, "xabcabc");
+    myStringSetFromCString(needle, "cab");
+    if (!myStringFind(haystack, needle, &index) || index != 3 ||
+        myStringFind(needle, haystack, NULL) || myStringFind(NULL, needle, NULL) ||
+        myStringCount(haystack, NULL, true) != 0)
     {
-        printComparisonHelper("equality test", __func__, EQUAL, UNEQUAL);
+        printf("Wrong occurrence in myStringFind.\n");
     }
-    char *testString3 = "";
-    myStringSetFromCString(testStruct, testString3);
-    // test that filter does not return error
-    if (myStringFilter(testStruct, testMyStringFilterHelper) == MYSTRING_ERROR)
+    // checks that only maxIndices indices are stored, but every occurrence is counted
+    unsigned long indices[200];
+    myStringSetFromCString(haystack, "aaaaaa");
+    myStringSetFromCString(needle, "aa");
+    indices[2] = 7;
+    if (myStringFindAll(haystack, needle, true, indices, 2) != 6 || indices[0] != 0 ||
+        indices[1] != 1 || indices[2] != 7)
     {
-        printImproperError(__func__, __LINE__);
+        printf("Wrong indices in myStringFindAll.\n");
     }
-    myStringFree(testStruct);
-    myStringFree(testStruct2);
-    printf("End test for myStringSetFilter\n");
+    // checks the search and Two-Way against comparing at every index, on random strings of few
+    // letters (so there are many occurrences and many periodic needles)
+    char chars[64];
+    char needleChars[24];
+    unsigned long expected[64];
+    unsigned int seed = 1;
+    for (int round = 0; round < 20000; round++)
+    {
+        seed = seed * 1103515245 + 12345;
+        unsigned long length = (seed >> 16) % 64;
+        unsigned long needleLength = 1 + (seed >> 8) % 24;
+        int letters = 1 + (int) (seed % 3);
+        for (unsigned long i = 0; i < length; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            chars[i] = (char) ('a' + (seed >> 16) % letters);
+        }
+        for (unsigned long i = 0; i < needleLength; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            needleChars[i] = (length != 0 && (seed & 1)) ? chars[(seed >> 16) % length] :
+                             (char) ('a' + (seed >> 16) % letters);
+        }
+        myStringSetFromView(haystack, myStringViewOfBuffer(chars, length));
+        myStringSetFromView(needle, myStringViewOfBuffer(needleChars, needleLength));
+        TwoWayNeedle factors = factorNeedle(myStringViewOf(needle));
+        for (int cyclic = 0; cyclic < 2; cyclic++)
+        {
+            unsigned long count = testMyStringFindHelper(chars, length, needleChars,
+                                                         needleLength, cyclic, expected);
+            unsigned long found = myStringFindAll(haystack, needle, cyclic, indices, 200);
+            if (found != count || memcmp(indices, expected, count * sizeof(unsigned long)) != 0)
+            {
+                printf("Wrong occurrences in myStringFindAll (round %d).\n", round);
+            }
+            unsigned long to = cyclic ? length : (needleLength <= length) ?
+                               length - needleLength + 1 : 0;
+            SearchMatches matches = {indices, 200, 0, false};
+            twoWaySearch(&factors, chars, length, 0, to, &matches);
+            if (matches.count != count ||
+                memcmp(indices, expected, count * sizeof(unsigned long)) != 0)
+            {
+                printf("Wrong occurrences in the Two-Way search (round %d).\n", round);
+            }
+        }
+        bool expectedFound = testMyStringFindHelper(chars, length, needleChars, needleLength,
+                                                    false, expected) != 0;
+        if (myStringFind(haystack, needle, &index) != expectedFound ||
+            (expectedFound && index != expected[0]))
+        {
+            printf("Wrong occurrence in myStringFind (round %d).\n", round);
+        }
+    }
+    // checks needles that make the filter switch to Two-Way in the middle of the haystack
+    char *text = malloc(5000);
+    char *pattern = malloc(100);
+    memset(text, 'a', 5000);
+    memset(pattern, 'a', 100);
+    myStringSetFromView(haystack, myStringViewOfBuffer(text, 5000));
+    myStringSetFromView(needle, myStringViewOfBuffer(pattern, 100));
+    unsigned long all = myStringFindAll(haystack, needle, false, indices, 200);
+    myStringSetFromCString(needle, "b");
+    myStringCat(needle, haystack);
+    myStringSetFromView(haystack, myStringViewOfBuffer(pattern, 99));
+    myStringCat(haystack, needle);
+    if (all != 4901 || indices[199] != 199 || myStringCount(haystack, needle, false) != 1 ||
+        myStringCount(haystack, haystack, true) != 1)
+    {
+        printf("Wrong occurrences of a repeated char.\n");
+    }
+    free(text);
+    free(pattern);
+    myStringFree(haystack);
+    myStringFree(needle);
+    printf("End test for myStringFind\n");
 }
 
 /**
- * @brief Tester for myStringCompare()
+ * @brief Tester for MyStringMatcher
  *
  * RETURN VALUE: none
  */
-static void testMyStringCompare()
+static void testMyStringMatcher()
 {
-    
-    printf("Start test for myStringCompare\n");
-    char *string1 = "bcfd";
-    char *string2 = "bcde";
-    char *string3 = "bcd";
-    char *string4 = "cd";
-    MyString *equalStruct1 = myStringAlloc();
-    myStringSetFromCString(equalStruct1, string1);
-    MyString *equalStruct2 = myStringClone(equalStruct1);
-    MyString *unequalStruct = myStringAlloc();
-    myStringSetFromCString(unequalStruct, string2);
-    MyString *shorterStruct = myStringAlloc();
-    myStringSetFromCString(shorterStruct, string3);
-    MyString *shortestStruct = myStringAlloc();
-    myStringSetFromCString(shortestStruct, string4);
-    // Checks that two equal structs are compared properly
-    if(myStringCompare(equalStruct1, equalStruct2) == BIGGER ||
-       myStringCompare(equalStruct1, equalStruct2) == SMALLER )
+    printf("Start test for MyStringMatcher\n");
+    // the example of Aho and Corasick, with a repeated and an empty pattern
+    const char *words[] = {"he", "she", "his", "hers", "", "he"};
+    MyString *patterns[6];
+    for (int i = 0; i < 6; i++)
     {
-        printComparisonHelper("comparison test", __func__, SAME,
-                              myStringCompare(equalStruct1, equalStruct2) == BIGGER);
+        patterns[i] = myStringAlloc();
+        myStringSetFromCString(patterns[i], words[i]);
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCompare(equalStruct1, unequalStruct) <= SAME)
+    MyStringMatcher *matcher = myStringMatcherCreate((const MyString * const *) patterns, 6);
+    MyString *str = myStringAlloc();
+    myStringSetFromCString(str, "ushers");
+    MyStringMatch matches[64];
+    MyStringMatch expected[64] = {{1, 1}, {0, 2}, {5, 2}, {3, 2}};
+    if (matcher == NULL || myStringMatcherFind(matcher, str, matches, 64) != 4 ||
+        memcmp(matches, expected, 4 * sizeof(MyStringMatch)) != 0)
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: -1\n");
-        printf("Actual: %d\n", myStringCompare(equalStruct1, unequalStruct));
+        printf("Wrong matches of the Aho-Corasick example.\n");
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCompare(unequalStruct, equalStruct1) >= 0)
+    if (myStringMatcherFind(matcher, str, matches, 1) != 4 || matches[0].pattern != 1 ||
+        myStringMatcherFind(NULL, str, matches, 64) != 0 ||
+        myStringMatcherCreate(NULL, 1) != NULL)
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: 1\n");
-        printf("Actual: %d\n", myStringCompare(unequalStruct, equalStruct1));
+        printf("Wrong results of MyStringMatcher on edge cases.\n");
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCompare(equalStruct1, shorterStruct) <= 0)
+    myStringMatcherDestroy(matcher);
+    // checks that a matcher of no patterns finds nothing
+    matcher = myStringMatcherCreate((const MyString * const *) patterns, 0);
+    if (matcher == NULL || myStringMatcherFind(matcher, str, matches, 64) != 0)
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: 1\n");
-        printf("Actual: %d\n", myStringCompare(equalStruct1, shorterStruct));
+        printf("Wrong matches of a matcher without patterns.\n");
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCompare(shorterStruct, shortestStruct) >= 0)
+    myStringMatcherDestroy(matcher);
+    // checks random patterns of few letters against myStringFindAll, and that scanning in chunks
+    // finds what scanning at once does
+    char chars[300];
+    unsigned long indices[300];
+    unsigned int seed = 1;
+    for (int round = 0; round < 300; round++)
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: -1\n");
-        printf("Actual: %d\n", myStringCompare(shorterStruct, shortestStruct));
+        seed = seed * 1103515245 + 12345;
+        int letters = 1 + (int) ((seed >> 16) % 4);
+        int patternCount = 1 + (int) ((seed >> 8) % 6);
+        for (int i = 0; i < patternCount; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            int length = 1 + (int) ((seed >> 16) % 5);
+            for (int k = 0; k < length; k++)
+            {
+                seed = seed * 1103515245 + 12345;
+                chars[k] = (char) ('a' + (seed >> 16) % letters);
+            }
+            myStringSetFromView(patterns[i], myStringViewOfBuffer(chars, length));
+        }
+        for (int i = 0; i < 300; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            chars[i] = (char) ('a' + (seed >> 16) % letters);
+        }
+        myStringSetFromView(str, myStringViewOfBuffer(chars, 300));
+        matcher = myStringMatcherCreate((const MyString * const *) patterns, patternCount);
+        unsigned long count = myStringMatcherFind(matcher, str, NULL, 0);
+        MyStringMatch *all = malloc((count + 1) * sizeof(MyStringMatch));
+        MyStringMatch *chunked = malloc((count + 1) * sizeof(MyStringMatch));
+        myStringMatcherFind(matcher, str, all, count);
+        unsigned long total = 0;
+        for (int i = 0; i < patternCount; i++)
+        {
+            unsigned long found = myStringFindAll(str, patterns[i], false, indices, 300);
+            // every occurrence of the pattern is a match with the same start
+            for (unsigned long k = 0, m = 0; k < found; k++, m++)
+            {
+                while (m < count && (all[m].pattern != (unsigned long) i ||
+                                     all[m].start != indices[k]))
+                {
+                    m++;
+                }
+                if (m == count)
+                {
+                    printf("Missing match of a pattern (round %d).\n", round);
+                    break;
+                }
+            }
+            total += found;
+        }
+        MyStringMatchState state = myStringMatcherStart();
+        unsigned long chunkedCount = 0;
+        for (unsigned long offset = 0; offset < 300;)
+        {
+            seed = seed * 1103515245 + 12345;
+            unsigned long length = (seed >> 16) % 20;
+            length = (offset + length > 300) ? 300 - offset : length;
+            chunkedCount += myStringMatcherScan(matcher, &state,
+                                                myStringViewOfBuffer(chars + offset, length),
+                                                chunked + chunkedCount, count - chunkedCount);
+            offset += length;
+        }
+        if (count != total || chunkedCount != count ||
+            memcmp(all, chunked, count * sizeof(MyStringMatch)) != 0)
+        {
+            printf("Wrong amount of matches (round %d).\n", round);
+        }
+        free(all);
+        free(chunked);
+        myStringMatcherDestroy(matcher);
     }
-    
-    myStringFree(equalStruct1);
-    myStringFree(equalStruct2);
-    myStringFree(unequalStruct);
-    myStringFree(shorterStruct);
-    myStringFree(shortestStruct);
-    printf("End test for myStringCompare\n");
+    for (int i = 0; i < 6; i++)
+    {
+        myStringFree(patterns[i]);
+    }
+    myStringFree(str);
+    printf("End test for MyStringMatcher\n");
 }
 
 /**
- * @brief Tester for myStringCustomCompare()
+ * @brief Helper for testMyStringIndex()
+ *        Checks the suffix and LCP arrays of an index against comparing its suffixes (or
+ *        rotations) char by char.
+ * RETURN VALUE:
+ * @return true if the arrays are right, false otherwise.
+ */
+static bool testMyStringIndexHelper(const MyStringIndex *index)
+{
+    unsigned long n = index -> length;
+    unsigned long textLength = index -> cyclic ? 2 * n : n;
+    const unsigned char *text = (const unsigned char *) index -> text;
+    bool *seen = calloc(n + 1, sizeof(bool));
+    bool valid = true;
+    for (unsigned long i = 0; i < n && valid; i++)
+    {
+        unsigned long suffix = index -> suffixes[i];
+        valid = suffix < n && !seen[suffix];
+        seen[suffix] = true;
+        if (!valid || i == 0)
+        {
+            valid = valid && index -> lcp[0] == 0;
+            continue;
+        }
+        // a rotation is compared as far as n chars, a suffix until it ends
+        unsigned long previous = index -> suffixes[i - 1];
+        unsigned long common = 0;
+        while (previous + common < textLength && suffix + common < textLength && common < n &&
+               text[previous + common] == text[suffix + common])
+        {
+            common++;
+        }
+        bool ordered;
+        if (index -> cyclic && common == n)
+        {
+            // equal rotations may come in any order
+            ordered = true;
+        }
+        else if (suffix + common == textLength || previous + common == textLength)
+        {
+            // a suffix comes before the longer suffixes it is a prefix of
+            ordered = previous + common == textLength;
+        }
+        else
+        {
+            ordered = text[previous + common] < text[suffix + common];
+        }
+        valid = ordered && index -> lcp[i] == common;
+    }
+    free(seen);
+    return valid;
+}
+
+/**
+ * @brief Helper for testMyStringIndex()
+ *        Compares two indices for qsort.
+ */
+static int testMyStringIndexCompareHelper(const void *index1, const void *index2)
+{
+    unsigned long first = *(const unsigned long *) index1;
+    unsigned long second = *(const unsigned long *) index2;
+    return (first > second) - (first < second);
+}
+
+/**
+ * @brief Tester for MyStringIndex
  *
  * RETURN VALUE: none
  */
-static void testMyStringCustomCompare()
+static void testMyStringIndex()
 {
-    printf("Start test for myStringCustomCompare\n");
-    char *string1 = "abcd";
-    char *string2 = "abce";
-    char *string3 = "abc";
-    char *string4 = "ad";
-    MyString *equalStruct1 = myStringAlloc();
-    myStringSetFromCString(equalStruct1, string1);
-    MyString *equalStruct2 = myStringClone(equalStruct1);
-    MyString *unequalStruct = myStringAlloc();
-    myStringSetFromCString(unequalStruct, string2);
-    MyString *shorterStruct = myStringAlloc();
-    myStringSetFromCString(shorterStruct, string3);
-    MyString *shortestStruct = myStringAlloc();
-    myStringSetFromCString(shortestStruct, string4);
-    // Checks that two equal structs are compared properly
-    if(myStringCustomCompare(equalStruct1, equalStruct2, defCompare) !=0)
+    printf("Start test for MyStringIndex\n");
+    MyString *str = myStringAlloc();
+    MyString *needle = myStringAlloc();
+    myStringSetFromCString(str, "banana");
+    MyStringIndex *index = myStringIndexBuild(str);
+    unsigned long start = 7;
+    unsigned long length = 7;
+    uint32_t bananaSuffixes[] = {5, 3, 1, 0, 4, 2};
+    uint32_t bananaLcp[] = {0, 1, 3, 0, 0, 2};
+    if (index == NULL || memcmp(index -> suffixes, bananaSuffixes, sizeof(bananaSuffixes)) != 0 ||
+        memcmp(index -> lcp, bananaLcp, sizeof(bananaLcp)) != 0 ||
+        myStringIndexLongestRepeat(index, &start, &length) == MYSTRING_ERROR || start != 1 ||
+        length != 3)
+    {
+        printf("Wrong suffix array of banana.\n");
+    }
+    myStringIndexDestroy(index);
+    if (myStringIndexBuild(NULL) != NULL || myStringIndexCount(NULL, str) != 0 ||
+        myStringIndexLongestRepeat(NULL, &start, &length) != MYSTRING_ERROR)
+    {
+        printImproperError(__func__, __LINE__);
+    }
+    // periodic texts, where the rotations that start in the second copy are many
+    const char *periodic[][2] = {{"cbcb", "b"}, {"ccacca", "a"}, {"abaabaaba", "abaa"}};
+    for (size_t i = 0; i < sizeof(periodic) / sizeof(periodic[0]); i++)
+    {
+        unsigned long found[9];
+        unsigned long expectedFound[9];
+        myStringSetFromCString(str, periodic[i][0]);
+        myStringSetFromCString(needle, periodic[i][1]);
+        index = myStringIndexBuildCyclic(str);
+        unsigned long count = myStringFindAll(str, needle, true, expectedFound, 9);
+        unsigned long located = myStringIndexLocate(index, needle, found, 9);
+        qsort(found, located, sizeof(unsigned long), testMyStringIndexCompareHelper);
+        if (index == NULL || !testMyStringIndexHelper(index) || located != count ||
+            myStringIndexCount(index, needle) != count ||
+            memcmp(found, expectedFound, count * sizeof(unsigned long)) != 0 ||
+            myStringIndexLongestRepeat(index, &start, &length) == MYSTRING_ERROR ||
+            length != myStringLen(str))
+        {
+            printf("Wrong occurrences in the cyclic index of %s.\n", periodic[i][0]);
+        }
+        myStringIndexDestroy(index);
+    }
+    // checks the arrays, counts and occurrences of random texts of few letters against
+    // comparing char by char and myStringFindAll, cyclic and not
+    char chars[200];
+    unsigned long indices[200];
+    unsigned long expected[200];
+    unsigned int seed = 1;
+    for (int round = 0; round < 400; round++)
+    {
+        seed = seed * 1103515245 + 12345;
+        unsigned long textLength = (seed >> 16) % 200;
+        int letters = 1 + (int) ((seed >> 8) % 4);
+        for (unsigned long i = 0; i < textLength; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            chars[i] = (char) ('a' + (seed >> 16) % letters);
+        }
+        myStringSetFromView(str, myStringViewOfBuffer(chars, textLength));
+        for (int cyclic = 0; cyclic < 2; cyclic++)
+        {
+            index = cyclic ? myStringIndexBuildCyclic(str) : myStringIndexBuild(str);
+            if (index == NULL || !testMyStringIndexHelper(index))
+            {
+                printf("Wrong suffix array (round %d).\n", round);
+                myStringIndexDestroy(index);
+                continue;
+            }
+            for (int query = 0; query < 10; query++)
+            {
+                seed = seed * 1103515245 + 12345;
+                unsigned long needleLength = (seed >> 16) % 8;
+                for (unsigned long i = 0; i < needleLength; i++)
+                {
+                    seed = seed * 1103515245 + 12345;
+                    chars[i] = (char) ('a' + (seed >> 16) % letters);
+                }
+                myStringSetFromView(needle, myStringViewOfBuffer(chars, needleLength));
+                unsigned long count = myStringFindAll(str, needle, cyclic, expected, 200);
+                unsigned long found = myStringIndexLocate(index, needle, indices, 200);
+                // the occurrences come in suffix order, so they are sorted before comparing
+                qsort(indices, found, sizeof(unsigned long), testMyStringIndexCompareHelper);
+                if (myStringIndexCount(index, needle) != count || found != count ||
+                    memcmp(indices, expected, count * sizeof(unsigned long)) != 0)
+                {
+                    printf("Wrong occurrences in the index (round %d).\n", round);
+                }
+            }
+            myStringIndexDestroy(index);
+        }
+    }
+    // checks deep recursions of SA-IS, on a long text of two letters and on a single letter
+    MyString *text = myStringAlloc();
+    for (int i = 0; i < 100000; i++)
     {
-        printf("Wrong value returned after comparison of 2 equal MyStrings.\n");
-        printf("Expected: 0\n");
-        printf("Actual: %d\n", myStringCustomCompare(equalStruct1, equalStruct2, defCompare));
+        seed = seed * 1103515245 + 12345;
+        myStringSetFromCString(needle, ((seed >> 16) % 3 == 0) ? "b" : "a");
+        myStringCat(text, needle);
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCustomCompare(equalStruct1, unequalStruct, defCompare) >= 0)
+    index = myStringIndexBuild(text);
+    if (index == NULL || !testMyStringIndexHelper(index))
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: -1\n");
-        printf("Actual: %d\n", myStringCustomCompare(equalStruct1, unequalStruct, defCompare));
+        printf("Wrong suffix array of a long text.\n");
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCustomCompare(unequalStruct, equalStruct1, defCompare) <= 0)
+    myStringIndexDestroy(index);
+    myStringSetFromView(text, myStringViewOfBuffer(chars, 0));
+    for (int i = 0; i < 3000; i++)
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: 1\n");
-        printf("Actual: %d\n", myStringCustomCompare(unequalStruct, equalStruct1, defCompare));
+        myStringSetFromCString(needle, "a");
+        myStringCat(text, needle);
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCustomCompare(equalStruct1, shorterStruct, defCompare) <= 0)
+    index = myStringIndexBuildCyclic(text);
+    myStringSetFromCString(needle, "aaaaa");
+    if (index == NULL || !testMyStringIndexHelper(index) ||
+        myStringIndexCount(index, needle) != 3000 ||
+        myStringIndexCount(index, text) != 3000)
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: 1\n");
-        printf("Actual: %d\n", myStringCustomCompare(equalStruct1, shorterStruct, defCompare));
+        printf("Wrong suffix array of a repeated char.\n");
     }
-    // Checks that two unequal structs are compared properly
-    if(myStringCustomCompare(shorterStruct, shortestStruct, defCompare) >= 0)
+    myStringIndexDestroy(index);
+    // checks that an index is the same after saving and loading it, and that broken files are
+    // not loaded
+    myStringSetFromCString(str, "mississippi");
+    index = myStringIndexBuildCyclic(str);
+    FILE *file = tmpfile();
+    if (file != NULL)
     {
-        printf("Wrong value returned after comparison of 2 unequal MyStrings.\n");
-        printf("Expected: -1\n");
-        printf("Actual: %d\n", myStringCustomCompare(shorterStruct, shortestStruct, defCompare));
+        myStringSetFromCString(needle, "ippim");
+        MyStringIndex *loaded = NULL;
+        if (myStringIndexSave(index, file) == MYSTRING_ERROR || fseek(file, 0, SEEK_SET) != 0 ||
+            (loaded = myStringIndexLoad(file)) == NULL || !loaded -> cyclic ||
+            loaded -> length != 11 || memcmp(loaded -> text, "mississippimississippi", 22) != 0 ||
+            memcmp(loaded -> suffixes, index -> suffixes, 11 * sizeof(uint32_t)) != 0 ||
+            memcmp(loaded -> lcp, index -> lcp, 11 * sizeof(uint32_t)) != 0 ||
+            myStringIndexCount(loaded, needle) != 1)
+        {
+            printf("Index changed by saving and loading it.\n");
+        }
+        myStringIndexDestroy(loaded);
+        // a suffix that appears twice
+        long suffixes = INDEX_MAGIC_SIZE + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint64_t) +
+                        11;
+        uint32_t twice = index -> suffixes[1];
+        fseek(file, suffixes, SEEK_SET);
+        fwrite(&twice, sizeof(uint32_t), 1, file);
+        fseek(file, 0, SEEK_SET);
+        if ((loaded = myStringIndexLoad(file)) != NULL)
+        {
+            printf("Broken index was loaded.\n");
+            myStringIndexDestroy(loaded);
+        }
+        // a file that ends too soon
+        fseek(file, 0, SEEK_SET);
+        myStringIndexSave(index, file);
+        fflush(file);
+        if (ftruncate(fileno(file), suffixes) != 0 || fseek(file, 0, SEEK_SET) != 0 ||
+            (loaded = myStringIndexLoad(file)) != NULL)
+        {
+            printf("Truncated index was loaded.\n");
+            myStringIndexDestroy(loaded);
+        }
+        // a length far beyond the end of the file
+        uint64_t huge = (NO_SUFFIX - 1) / 2;
+        fseek(file, suffixes - 11 - (long) sizeof(uint64_t), SEEK_SET);
+        fwrite(&huge, sizeof(huge), 1, file);
+        fflush(file);
+        if (fseek(file, 0, SEEK_SET) != 0 || (loaded = myStringIndexLoad(file)) != NULL)
+        {
+            printf("Index of a huge length was loaded.\n");
+            myStringIndexDestroy(loaded);
+        }
+        // the same from a pipe, which cannot seek
+        int pipeEnds[2];
+        if (pipe(pipeEnds) == 0)
+        {
+            char header[INDEX_MAGIC_SIZE + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint64_t) +
+                        11];
+            fseek(file, 0, SEEK_SET);
+            FILE *reader = fdopen(pipeEnds[0], "r");
+            if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+                write(pipeEnds[1], header, sizeof(header)) != (ssize_t) sizeof(header) ||
+                close(pipeEnds[1]) != 0 || reader == NULL ||
+                (loaded = myStringIndexLoad(reader)) != NULL)
+            {
+                printf("Index of a huge length was loaded from a pipe.\n");
+                myStringIndexDestroy(loaded);
+            }
+            if (reader != NULL)
+            {
+                fclose(reader);
+            }
+        }
+        fclose(file);
     }
-    
-    myStringFree(equalStruct1);
-    myStringFree(equalStruct2);
-    myStringFree(unequalStruct);
-    myStringFree(shorterStruct);
-    myStringFree(shortestStruct);
-    printf("End test for myStringCustomCompare\n");
+    myStringIndexDestroy(index);
+    myStringFree(text);
+    myStringFree(str);
+    myStringFree(needle);
+    printf("End test for MyStringIndex\n");
 }
 
 /**
- * @brief Tester for myStringCatTo()
- *
- * RETURN VALUE: none
+ * @brief Checks that a rope holds the chars of a buffer, going over its chunks and its chars.
+ * RETURN VALUE:
+ * @return true if it does.
  */
-static void testMyStringCatTo()
+static bool testRopeHelper(const MyRope *rope, const char *expected, unsigned long length)
 {
-    printf("Start test for myStringCatTo\n");
-    char *string1 = "first";
-    char *string2 = "morecharacters";
-    char *string3 = "firstmorecharacters";
-    MyString *str1 = myStringAlloc();
-    MyString *str2 = myStringAlloc();
-    MyString *str3 = myStringAlloc();
-    myStringSetFromCString(str1, string1);
-    myStringSetFromCString(str2, string2);
-    myStringCatTo(str1, str2, str3);
-    // checks that the length matches after catTo
-    if(myStringLen(str3) != myStringLen(str1) + myStringLen(str2))
+    if (myRopeLen(rope) != length)
     {
-        printCalculatorHelper(STRING_LENGTH, __func__, 19, myStringLen(str3));
+        return false;
     }
-    myStringSetFromCString(str1, string3);
-    // Checks that two equal structs are compared properly
-    if(myStringEqual(str3, str1) == 0)
+    unsigned long offset = 0;
+    MyStringView chunk;
+    while (myRopeNextChunk(rope, &offset, &chunk))
     {
-        printf("String does not match expected after myStringCatTo\n");
-        printf("Expected: firstmorecharacters\n");
-        printf("Actual: %s\n", str3 -> stringArray);
+        if (chunk.length == 0 || memcmp(chunk.chars, expected + offset - chunk.length,
+                                        chunk.length) != 0)
+        {
+            return false;
+        }
     }
-    myStringFree(str1);
-    myStringFree(str2);
-    myStringFree(str3);
-    printf("End test for myStringCatTo\n");
+    for (unsigned long i = 0; i < length; i += 97)
+    {
+        char c;
+        if (myRopeCharAt(rope, i, &c) != MYSTRING_SUCCESS || c != expected[i])
+        {
+            return false;
+        }
+    }
+    return offset == length;
 }
 
 /**
- * @brief Tester for myStringCat()
+ * @brief Tester for MyRope
  *
  * RETURN VALUE: none
  */
-static void testMyStringCat()
+static void testMyRope()
 {
-    printf("Start test for myStringCat\n");
-    char *string1 = "first";
-    char *string2 = "morecharacters";
-    char *string3 = "firstmorecharacters";
-    char *string4 = "firstmorecharactersfirstmorecharacters";
-    MyString *str1 = myStringAlloc();
-    MyString *str2 = myStringAlloc();
-    myStringSetFromCString(str1, string1);
-    myStringSetFromCString(str2, string2);
-    myStringCat(str1, str2);
-    myStringSetFromCString(str2, string3);
-    char *cString = myStringToCString(str1);
-    // Checks that length of structs is the same
-    if(myStringLen(str1) != myStringLen(str2))
+    printf("Start test for MyRope\n");
+    // builds a rope from fragments of many lengths, keeping the same chars in a buffer
+    char *expected = malloc(1 << 21);
+    char *fragment = malloc(3000);
+    unsigned long length = 0;
+    unsigned int seed = 7;
+    MyRope *rope = myRopeAlloc();
+    MyString *str = myStringAlloc();
+    for (int i = 0; i < 2000; i++)
     {
-        printCalculatorHelper(STRING_LENGTH, __func__, 19, myStringLen(str1));
+        seed = seed * 1103515245 + 12345;
+        unsigned long size = (i % 10 == 0) ? (seed >> 16) % 1000 : (seed >> 16) % 20;
+        for (unsigned long j = 0; j < size; j++)
+        {
+            fragment[j] = (char) ('a' + (i + j) % 26);
+        }
+        myStringSetFromView(str, myStringViewOfBuffer(fragment, size));
+        if (myRopeCatMyString(rope, str) != MYSTRING_SUCCESS)
+        {
+            printf("Failed to append in myRopeCatMyString.\n");
+        }
+        memcpy(expected + length, fragment, size);
+        length += size;
     }
-    // Checks that two equal structs are compared properly
-    if(myStringEqual(str1, str2) == 0)
+    // 2000 fragments, so an AVL tree of them is less than 1.45 * log2(2000) + 2 high
+    if (!testRopeHelper(rope, expected, length) || rope -> root -> height > 18)
     {
-        printf("String does not match expected after myStringCat\n");
-        printf("Expected: firstmorecharacters\n");
-        printf("Actual: %s\n", cString);
+        printf("Wrong value after myRopeCatMyString.\n");
     }
-    myStringCat(str1, str1);
-    myStringSetFromCString(str2, string4);
-    free(cString);
-    char *cString2 = myStringToCString(str1);
-    // Checks that two equal structs are compared properly
-    if(myStringEqual(str1, str2) == 0)
+    // inserts copies of slices and splits at random indexes, doing the same to the buffer
+    for (int i = 0; i < 200; i++)
     {
-        printf("String does not match expected after myStringCat with itself\n");
-        printf("Expected: firstmorecharactersfirstmorecharacters\n");
-        printf("Actual: %s\n", cString2);
+        seed = seed * 1103515245 + 12345;
+        unsigned long index = (seed >> 8) % (length + 1);
+        seed = seed * 1103515245 + 12345;
+        unsigned long start = (seed >> 8) % (length + 1);
+        unsigned long size = MIN(length - start, (seed >> 4) % 3000);
+        MyRope *first = myRopeClone(rope);
+        MyRope *slice = myRopeSplit(first, start);
+        MyRope *rest = myRopeSplit(slice, size);
+        if (myRopeLen(first) != start || myRopeLen(slice) != size ||
+            myRopeInsert(rope, index, slice) != MYSTRING_SUCCESS)
+        {
+            printf("Wrong split or insert in myRopeInsert.\n");
+        }
+        memcpy(fragment, expected + start, size);
+        memmove(expected + index + size, expected + index, length - index);
+        memcpy(expected + index, fragment, size);
+        length += size;
+        myRopeFree(first);
+        myRopeFree(slice);
+        myRopeFree(rest);
     }
-    myStringFree(str1);
-    myStringFree(str2);
-    free(cString2);
-    printf("End test for myStringCat\n");
-}
-
-
-/**
- * @brief Tester for myStringMemUsage()
- *
- * RETURN VALUE: none
- */
-static void testMyStringMemUsage()
-{
-    printf("Start test for myStringMemUsage\n");
-    MyString *str1 = myStringAlloc();
-    unsigned long memory = myStringMemUsage(str1);
-    unsigned long expectedSize = (sizeof(unsigned long) * 2) + sizeof(char) * 16 + 8;
-    if(memory != expectedSize)
+    if (!testRopeHelper(rope, expected, length))
     {
-        printf("Memory does not match that expected for empty struct in myStringMemUsage\n");
-        printf("Expected: %lu\n", expectedSize);
-        printf("Actual: %lu\n", memory);
+        printf("Wrong value after myRopeInsert.\n");
     }
-    
-    myStringFree(str1);
-    printf("End test for myStringMemUsage\n");
-}
-
-/**
- * @brief Tester for myStringSort()
- *
- * RETURN VALUE: none
- */
-static void testMyStringSort()
-{
-    printf("Start test for myStringSort\n");
-    char *string1 = "Monkey";
-    char *string2 = "Bear";
-    char *string3 = "Giraffe";
-    char *string4 = "Mongoose";
-    char *string5 = "Sloth";
-    MyString *str1 = myStringAlloc();
-    MyString *str2 = myStringAlloc();
-    MyString *str3 = myStringAlloc();
-    MyString *str4 = myStringAlloc();
-    MyString *str5 = myStringAlloc();
-    myStringSetFromCString(str1, string1);
-    myStringSetFromCString(str2, string2);
-    myStringSetFromCString(str3, string3);
-    myStringSetFromCString(str4, string4);
-    myStringSetFromCString(str5, string5);
-    MyString* array[] = {str1, str2, str3, str4, str5};
-    myStringSort(array, 5);
-    // check that the array is properly sorted
-    for(int i = 0; i < 4; i++)
+    // checks that flattening keeps the flat copy and that converting a MyString shares its array
+    MyString *flat = myRopeToMyString(rope);
+    MyString *again = myRopeToMyString(rope);
+    if (flat == NULL || myStringLen(flat) != length ||
+        memcmp(flat -> stringArray, expected, length) != 0 ||
+        again -> stringArray != flat -> stringArray || !testRopeHelper(rope, expected, length))
     {
-        if(myStringCompare(array[i], array[i + 1]) != -1)
+        printf("Wrong value after myRopeToMyString.\n");
+    }
+    MyRope *converted = myRopeFromMyString(flat);
+    if (converted -> root -> str -> stringArray != flat -> stringArray)
+    {
+        printf("Array was copied in myRopeFromMyString.\n");
+    }
+    // checks appending a rope to itself and writing it out both ways
+    myRopeCat(converted, converted);
+    memcpy(expected + length, expected, length);
+    FILE *files[] = {tmpfile(), tmpfile()};
+    if (myRopeWriteFd(converted, fileno(files[0])) != MYSTRING_SUCCESS ||
+        myRopeWrite(converted, files[1]) != MYSTRING_SUCCESS || fflush(files[1]) != 0)
+    {
+        printf("Failed to write in myRopeWriteFd.\n");
+    }
+    char *written = malloc(2 * length);
+    for (int i = 0; i < 2; i++)
+    {
+        rewind(files[i]);
+        if (fread(written, sizeof(char), 2 * length, files[i]) != 2 * length ||
+            memcmp(written, expected, 2 * length) != 0)
         {
-            printf("Array was not sorted properly in testMyStringSort\n");
-            printf("Expected: -1\n");
-            printf("Actual: %d\n", myStringCompare(array[i], array[i + 1]));
+            printf("Wrong content written by myRopeWriteFd.\n");
         }
+        fclose(files[i]);
     }
-    myStringFree(str1);
-    myStringFree(str2);
-    myStringFree(str3);
-    myStringFree(str4);
-    myStringFree(str5);
-    printf("End test for myStringSort\n");
+    // checks the errors
+    char c;
+    if (myRopeCharAt(rope, length, &c) != MYSTRING_ERROR || myRopeSplit(rope, length + 1) != NULL ||
+        myRopeInsert(rope, length + 1, rope) != MYSTRING_ERROR || myRopeLen(NULL) != 0)
+    {
+        printf("Index out of the rope was not found in myRopeCharAt.\n");
+    }
+    free(written);
+    free(expected);
+    free(fragment);
+    myStringFree(str);
+    myStringFree(flat);
+    myStringFree(again);
+    myRopeFree(rope);
+    myRopeFree(converted);
+    printf("End test for MyRope\n");
 }
 
 /**
- * @brief Tester for myStringCustomSort()
+ * @brief Tester for MyStringBuilder
  *
  * RETURN VALUE: none
  */
-static void testMyStringCustomSort()
+static void testMyStringBuilder()
 {
-    printf("Start test for myStringCustomSort\n");
-    
-    char *string1 = "bird";
-    char *string2 = "mouse";
-    char *string3 = "cat";
-    char *string4 = "Dog";
-    char *string5 = "elephant";
-    MyString *str1 = myStringAlloc();
-    MyString *str2 = myStringAlloc();
-    MyString *str3 = myStringAlloc();
-    MyString *str4 = myStringAlloc();
-    MyString *str5 = myStringAlloc();
-    myStringSetFromCString(str1, string1);
-    myStringSetFromCString(str2, string2);
-    myStringSetFromCString(str3, string3);
-    myStringSetFromCString(str4, string4);
-    myStringSetFromCString(str5, string5);
-    MyString* array[] = {str1, str2, str3, str4, str5};
-    myStringCustomSort(array, 5, compareCaster);
-    // checks that the array is properly sorted
-    for(int i = 0; i < 4; i++)
+    printf("Start test for MyStringBuilder\n");
+    MyStringBuilder *builder = myStringBuilderCreate();
+    MyString *str = myStringAlloc();
+    MyString *piece = myStringAlloc();
+    myStringSetFromCString(piece, "piece");
+    // checks every kind of piece, including ints and chars that share a scratch slice
+    myStringBuilderAppend(builder, piece);
+    myStringBuilderAppendChar(builder, ',');
+    myStringBuilderAppendInt(builder, -123);
+    myStringBuilderAppendChar(builder, ',');
+    myStringBuilderAppendInt(builder, 0);
+    myStringBuilderAppendCString(builder, ",c string,");
+    myStringBuilderAppendView(builder, myStringViewOfCString(""));
+    myStringBuilderAppendView(builder, myStringViewOfBuffer("view and more", 4));
+    const char *expected = "piece,-123,0,c string,view";
+    if(myStringBuilderLen(builder) != strlen(expected) || builder -> count != 4 ||
+       myStringBuilderFinish(builder, str) != MYSTRING_SUCCESS ||
+       !myStringViewEqual(myStringViewOf(str), myStringViewOfCString(expected)) ||
+       myStringBuilderLen(builder) != 0)
     {
-        if(myStringCompare(array[i], array[i + 1]) != -1)
+        printf("Wrong value after myStringBuilderFinish.\n");
+    }
+    // checks that the builder grows, and keeps its arrays when it is used again
+    for (int round = 0; round < 2; round++)
+    {
+        BuilderSlice *slices = builder -> slices;
+        char *scratch = builder -> scratch;
+        for (int i = 0; i < 100; i++)
         {
-            printf("Array was not sorted properly in testMyStringCustomSort\n");
-            printf("Expected: -1\n");
-            printf("Actual: %d\n", myStringCompare(array[i], array[i + 1]));
+            myStringBuilderAppendCString(builder, "ab");
+            myStringBuilderAppendInt(builder, i);
+        }
+        myStringBuilderFinish(builder, str);
+        if(myStringLen(str) != 390 ||
+           memcmp(str -> stringArray + 382, "ab98ab99", 8) != 0 ||
+           (round == 1 && (slices != builder -> slices || scratch != builder -> scratch)))
+        {
+            printf("Wrong value after round %d in myStringBuilderFinish.\n", round);
         }
     }
-    myStringFree(str1);
-    myStringFree(str2);
-    myStringFree(str3);
-    myStringFree(str4);
-    myStringFree(str5);
-
-    
-    printf("End test for myStringCustomSort\n");
-}
-
-/**
- * @brief Tester for myStringWrite()
- *
- * RETURN VALUE: none
- */
-static void testMyStringWrite()
-{
-    printf("Start test for myStringWrite\n");
-    FILE* newFile = fopen("newFile", "w");
-    char *stringWrite = "Write this to file";
-    MyString *str1 = myStringAlloc();
-    myStringSetFromCString(str1, stringWrite);
-    myStringWrite(str1, newFile);
-    char buffer[19];
-    fclose(newFile);
-    newFile = fopen("newFile", "r");
-    fgets(buffer, (int) myStringLen(str1) + 1, newFile);
-    MyString *str2 = myStringAlloc();
-    myStringSetFromCString(str2, buffer);
-    if(myStringEqual(str1, str2) == 0)
+    // checks building a MyString from itself, and an empty builder
+    myStringSetFromCString(str, "A string that is too long for the inline buffer");
+    myStringBuilderAppend(builder, str);
+    myStringBuilderAppendChar(builder, '|');
+    myStringBuilderAppend(builder, str);
+    if(myStringBuilderFinish(builder, str) != MYSTRING_SUCCESS || myStringLen(str) != 95 ||
+       str -> stringArray[47] != '|' ||
+       memcmp(str -> stringArray, str -> stringArray + 48, 47) != 0)
     {
-        printf("Array was not sorted properly in testMyStringWrite\n");
-        printf("Expected: 1\n");
-        printf("Actual: 0\n");
+        printf("Wrong value when building from the target in myStringBuilderFinish.\n");
     }
-    fclose(newFile);
-    myStringFree(str1);
-    myStringFree(str2);
-    printf("End test for myStringWrite\n");
+    if(myStringBuilderFinish(builder, str) != MYSTRING_SUCCESS || myStringLen(str) != 0 ||
+       myStringBuilderFinish(NULL, str) != MYSTRING_ERROR ||
+       myStringBuilderAppend(builder, NULL) != MYSTRING_ERROR)
+    {
+        printf("Wrong value for an empty builder in myStringBuilderFinish.\n");
+    }
+    myStringBuilderDestroy(builder);
+    myStringFree(str);
+    myStringFree(piece);
+    printf("End test for MyStringBuilder\n");
 }
 #endif
 
@@ -1863,23 +11629,54 @@ int main()
 
     testMyStringAlloc();
     testMyStringLen();
+    testMyStringCapacity();
+    testMyStringReserve();
+    testMyStringShrinkToFit();
+    testMyStringPacked();
+    testMyStringArena();
     testMyStringClone();
+    testMyStringCloneSharing();
     testMyStringSetFromMyString();
     testMyStringSetFromCString();
     testMyStringToCString();
     testMyStringToInt();
+    testMyStringToInt64();
+    testMyStringToDouble();
     testMyStringCustomEqual();
     testMyStringEqual();
     testMyStringSetFromInt();
+    testMyStringSetFromInt64();
+    testMyStringSetFromDouble();
     testMyStringFilter();
+    testMyStringFilterSet();
     testMyStringCustomCompare();
     testMyStringCompare();
     testMyStringCatTo();
     testMyStringCat();
+    testMyStringCatMany();
     testMyStringMemUsage();
     testMyStringSort();
     testMyStringCustomSort();
     testMyStringWrite();
+    testMyStringWriteMany();
+    testMyStringWriter();
+    testMyStringReadLine();
+    testMyStringPool();
+    testMyStringHash();
+    testMyStringMap();
+    testMyStringCompareKernels();
+    testMyStringNaturalCompare();
+    testMyStringSortStable();
+    testMyStringSortParallel();
+    testMyStringSortPrefix();
+    testMyStringView();
+    testMyStringSplit();
+    testMyStringFind();
+    testMyStringMatcher();
+    testMyStringIndex();
+    testMyRope();
+    testMyStringBuilder();
+    testMyStringStats();
     testMyStringFree();
     return 0;
 }
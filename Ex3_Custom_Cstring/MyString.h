@@ -34,7 +34,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
+#include <stdint.h>
 
 // -------------------------- const definitions -------------------------
 
@@ -43,17 +43,191 @@
 */
 #define MYSTR_ERROR_CODE -999
 
+/*
+ * Amount of buckets in the histogram of the lengths of freed strings in MyStringStats.
+ */
+#define MYSTRING_STATS_BUCKETS 24
+
 /*
  * MyString represents a manipulable string.
  */
 struct _MyString;
 typedef struct _MyString MyString;
 
+/*
+ * MyStringArena allocates many MyStrings that are all released together.
+ */
+struct _MyStringArena;
+typedef struct _MyStringArena MyStringArena;
+
+/*
+ * MyStringPool holds a single canonical copy of every MyString value interned in it.
+ */
+struct _MyStringPool;
+typedef struct _MyStringPool MyStringPool;
+
+/*
+ * MyStringMap maps MyString keys to pointers.
+ */
+struct _MyStringMap;
+typedef struct _MyStringMap MyStringMap;
+
+/*
+ * Statistics of a MyStringPool.
+ * hits / lookups is the hit rate, bytesSaved is the memory of the duplicates that were looked up
+ * (which the caller can free in favor of the canonical strings).
+ */
+typedef struct
+{
+    unsigned long lookups;
+    unsigned long hits;
+    unsigned long uniqueStrings;
+    unsigned long bytesSaved;
+} MyStringPoolStats;
+
+/*
+ * MyStringWriter buffers output to a stream or a file descriptor.
+ */
+struct _MyStringWriter;
+typedef struct _MyStringWriter MyStringWriter;
+
+/*
+ * MyStringLineReader splits the input of a file descriptor into lines.
+ */
+struct _MyStringLineReader;
+typedef struct _MyStringLineReader MyStringLineReader;
+
+/*
+ * MyStringBuilder assembles a MyString from many pieces with a single copy.
+ */
+struct _MyStringBuilder;
+typedef struct _MyStringBuilder MyStringBuilder;
+
+/*
+ * MyRope is a string kept as a balanced tree of chunks, for strings built from many pieces.
+ */
+struct _MyRope;
+typedef struct _MyRope MyRope;
+
+/*
+ * MyStringMatcher finds the occurrences of many patterns at once (an Aho-Corasick automaton).
+ */
+struct _MyStringMatcher;
+typedef struct _MyStringMatcher MyStringMatcher;
+
+/*
+ * MyStringIndex is a suffix array of a text, for answering many substring queries on it.
+ */
+struct _MyStringIndex;
+typedef struct _MyStringIndex MyStringIndex;
+
+/*
+ * When a MyStringWriter writes its buffer out:
+ * MYSTRING_FLUSH_SIZE when the buffer is full.
+ * MYSTRING_FLUSH_LINES after every given amount of lines (and when the buffer is full).
+ * MYSTRING_FLUSH_EXPLICIT only when myStringWriterFlush is called (the buffer grows as needed).
+ */
+typedef enum
+{
+    MYSTRING_FLUSH_SIZE,
+    MYSTRING_FLUSH_LINES,
+    MYSTRING_FLUSH_EXPLICIT
+} MyStringFlushPolicy;
+
+/*
+ * Statistics of the whole library, counted only when it is compiled with -DMYSTRING_STATS (see
+ * myStringStatsSnapshot). They count the memory of MyStrings: their structs and inline buffers
+ * and their arrays on the heap (not arena slabs, which the arena counts as a whole).
+ * allocs, frees and reallocs count the calls to malloc, free and realloc.
+ * bytesCopied counts the chars moved to another buffer when a string's capacity changed or a
+ * shared array was copied before a change (not the chars realloc moved).
+ * liveBytes is the memory of the strings that are allocated right now.
+ * freedSlack sums the capacity that the strings did not use when they were freed.
+ * freedLengths[0] counts the empty strings that were freed, and freedLengths[i] the ones freed
+ * with a length in [2^(i-1), 2^i) (the last bucket counts all the longer ones too).
+ */
+typedef struct
+{
+    bool enabled;
+    unsigned long allocs;
+    unsigned long frees;
+    unsigned long reallocs;
+    unsigned long bytesCopied;
+    unsigned long liveBytes;
+    unsigned long freedSlack;
+    unsigned long freedLengths[MYSTRING_STATS_BUCKETS];
+} MyStringStats;
+
+/*
+ * Statistics of a MyStringWriter.
+ * bytesWritten counts the bytes that were flushed, flushes the amount of flushes that wrote them.
+ */
+typedef struct
+{
+    unsigned long bytesWritten;
+    unsigned long flushes;
+} MyStringWriterStats;
+
+/*
+ * MyStringView is a read-only slice of chars that someone else owns: a MyString, a C string or
+ * any buffer (like a mapped file). It is passed by value and is never freed. A view of a MyString
+ * is valid until that MyString is changed or freed.
+ */
+typedef struct
+{
+    const char *chars;
+    unsigned long length;
+} MyStringView;
+
+/*
+ * MyCharSet is a class of chars (like the chars of a regex [...] class), one bit for every
+ * unsigned char value. Fill it with myCharSetClear and myCharSetAdd* before using it.
+ */
+typedef struct
+{
+    uint64_t bits[256 / 64];
+} MyCharSet;
+
+/*
+ * MyStringSplitter goes over the fields of a MyStringView without allocating
+ * (see myStringSplit and myStringTokenize). Its members are private.
+ */
+typedef struct
+{
+    const char *next;
+    const char *end;
+    MyCharSet delims;
+    char delim;
+    bool tokenize;
+    bool done;
+} MyStringSplitter;
+
+/*
+ * MyStringMatch is an occurrence found by a MyStringMatcher: the index of the pattern (in the
+ * array the matcher was created from) and the index it starts at in the scanned chars.
+ */
+typedef struct
+{
+    unsigned long pattern;
+    unsigned long start;
+} MyStringMatch;
+
+/*
+ * MyStringMatchState is where a MyStringMatcher is in a stream of chunks, so occurrences may
+ * span chunks (see myStringMatcherStart). Its members are private.
+ */
+typedef struct
+{
+    uint32_t node;
+    unsigned long offset;
+} MyStringMatchState;
+
 /* Return values */
 typedef enum 
 {
     MYSTRING_ERROR = -1,
     MYSTRING_SUCCESS = 0,
+    MYSTRING_EOF = 1,
 } MyStringRetVal;
 
 
@@ -77,9 +251,58 @@ MyString * myStringAlloc();
 void myStringFree(MyString *str);
 
 
+/**
+ * @brief Allocates a new MyString whose struct and chars are a single block of memory, with room
+ * 			for capacity chars. It is the caller's responsibility to free the returned MyString.
+ * 			The regular functions move the chars to a separate block when the string outgrows
+ * 			capacity, myStringCatEx and myStringReserveEx grow the whole block instead.
+ * @param capacity the length the string can reach while staying in a single block.
+ * RETURN VALUE:
+ * @return a pointer to the new string, or NULL if the allocation failed.
+ */
+MyString * myStringAllocPacked(unsigned long capacity);
+
+/**
+ * @brief Creates a new arena to allocate MyStrings in. MyStrings and their contents are
+ * 			allocated from big slabs and are all released together by myStringArenaReset or
+ * 			myStringArenaDestroy. It is the caller's responsibility to destroy the arena.
+ * @param slabSize the amount of bytes the arena allocates at once, 0 for the default.
+ * RETURN VALUE:
+ * @return a pointer to the new arena, or NULL if the allocation failed.
+ */
+MyStringArena * myStringArenaCreate(unsigned long slabSize);
+
+/**
+ * @brief Allocates a new MyString inside arena and sets its value to "" (the empty string).
+ * 			The MyString must not be used after the arena is reset or destroyed.
+ * 			Calling myStringFree on it does nothing.
+ * @param arena the arena to allocate in.
+ * RETURN VALUE:
+ * @return a pointer to the new string, or NULL if the allocation failed.
+ */
+MyString * myStringAllocIn(MyStringArena *arena);
+
+/**
+ * @brief Releases every MyString allocated in arena, in constant time. The arena can be used
+ * 			again, and keeps its memory to allocate from until it is destroyed.
+ * @param arena the arena to reset.
+ * If arena is NULL, no operation is performed.
+ */
+void myStringArenaReset(MyStringArena *arena);
+
+/**
+ * @brief Releases every MyString allocated in arena and the arena itself.
+ * @param arena the arena to destroy.
+ * If arena is NULL, no operation is performed.
+ */
+void myStringArenaDestroy(MyStringArena *arena);
+
+
 /**
  * @brief Allocates a new MyString with the same value as str. It is the caller's
  * 			responsibility to free the returned MyString.
+ * 			The clone may share its contents with str until one of them is changed. Clones
+ * 			that are only read can be used and freed from different threads.
  * @param str the MyString to clone.
  * RETURN VALUE:
  *   @return a pointer to the new string, or NULL if the allocation failed.
@@ -100,12 +323,62 @@ MyStringRetVal myStringSetFromMyString(MyString *str, const MyString *other);
  * @brief filter the value of str acording to a filter. 
  * 	remove from str all the occurrence of chars that are filtered by filt 
  *	(i.e. filr(char)==true)
+ * 	str is compacted in place, so filt may see chars before the one it is given that were
+ * 	already moved.
  * @param str the MyString to filter
  * @param filt the filter
  * RETURN VALUE:
  *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure. */
 MyStringRetVal myStringFilter(MyString *str, bool (*filt)(const char *));
 
+/**
+ * @brief Removes from str all the chars that are in set, keeping the order of the rest.
+ * 	Much faster than myStringFilter with a function doing the same (it checks 16 chars at a
+ * 	time on CPUs that can), so prefer it for stripping classes of chars from large strings.
+ * @param str the MyString to filter
+ * @param set the chars to remove
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure. */
+MyStringRetVal myStringFilterSet(MyString *str, const MyCharSet *set);
+
+/**
+ * @brief Empties set.
+ * @param set the MyCharSet to empty
+ */
+void myCharSetClear(MyCharSet *set);
+
+/**
+ * @brief Adds a char to set.
+ * @param set the MyCharSet to add to
+ * @param c the char to add
+ */
+void myCharSetAdd(MyCharSet *set, char c);
+
+/**
+ * @brief Adds every char of a C string to set (like the chars of " \t\n").
+ * @param set the MyCharSet to add to
+ * @param chars the null terminated chars to add
+ */
+void myCharSetAddChars(MyCharSet *set, const char *chars);
+
+/**
+ * @brief Adds every char from first to last (both included, as unsigned chars) to set,
+ * 	like the class [a-z]. Adds nothing if first is after last.
+ * @param set the MyCharSet to add to
+ * @param first the first char to add
+ * @param last the last char to add
+ */
+void myCharSetAddRange(MyCharSet *set, char first, char last);
+
+/**
+ * @brief Checks if a char is in set.
+ * @param set the MyCharSet to check
+ * @param c the char to look for
+ * RETURN VALUE:
+ *  @return true if c is in set, false otherwise (or if set is NULL).
+ */
+bool myCharSetHas(const MyCharSet *set, char c);
+
 
 /**
  * @brief Sets the value of str to the value of the given C string.
@@ -130,17 +403,85 @@ MyStringRetVal myStringSetFromCString(MyString *str, const char * cString);
  */
 MyStringRetVal myStringSetFromInt(MyString *str, int n);
 
+/**
+ * @brief Sets the value of str to the value of the 64 bit integer n (like myStringSetFromInt).
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringSetFromInt64(MyString *str, int64_t n);
+
+/**
+ * @brief Sets the value of str to the value of the unsigned 64 bit integer n.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringSetFromUInt64(MyString *str, uint64_t n);
+
+/**
+ * @brief Sets the value of str to the value of the double value, with the fewest significant
+ * 	digits (up to 17) that are read back (like with strtod) as the same double.
+ * 	(i.e. 0.1 gives "0.1", 1.0 / 3 gives "0.3333333333333333", 1e300 gives "1e+300")
+ * 	Denormal numbers may get more digits than they need. Infinity and NaN give "inf" and "nan".
+ * @param str the MyString to set.
+ * @param value the double to set from.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringSetFromDouble(MyString *str, double value);
+
 
 /**
  * @brief Returns the value of str as an integer.
  * 	If str cannot be parsed as an integer, 
  * 	the return value should be MYSTR_ERROR_CODE
  * 	NOTE: positive and negative integers should be supported.
+ * 	A value that does not fit in an int is an error too. Since MYSTR_ERROR_CODE is also a valid
+ * 	int, use myStringToInt64 to tell them apart.
  * @param str the MyString 
  * @return an integer
  */
 int myStringToInt(const MyString *str);
 
+/**
+ * @brief Parses str as a decimal 64 bit integer: digits with an optional leading '-'.
+ * @param str the MyString to parse.
+ * @param out set to the value (only on success).
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR if str is not an integer or its value does
+ *  not fit in 64 bits.
+ */
+MyStringRetVal myStringToInt64(const MyString *str, int64_t *out);
+
+/**
+ * @brief Parses str as a double: an optional sign, digits with an optional '.', and an optional
+ * 	exponent ('e' or 'E' and an integer), or "inf", "infinity" or "nan" in any case.
+ * 	The result is the closest double to the number.
+ * @param str the MyString to parse.
+ * @param out set to the value (only on success).
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR if str is not a number or it is too big
+ *  for a double (a number too small for one gives the closest double, like 0).
+ */
+MyStringRetVal myStringToDouble(const MyString *str, double *out);
+
+/**
+ * @brief Parses every MyString in strs like myStringToInt64 (like a column of a table).
+ * @param strs array of the MyStrings to parse.
+ * @param n the amount of MyStrings in strs.
+ * @param out array of n values to fill. The value of a MyString that can not be parsed is 0.
+ * @param valid array of n flags set to whether each MyString was parsed, or NULL.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS if all of them were parsed, MYSTRING_ERROR otherwise.
+ */
+MyStringRetVal myStringToInt64Many(const MyString * const *strs, unsigned long n, int64_t *out,
+                                   bool *valid);
+
+/**
+ * @brief Parses every MyString in strs like myStringToDouble, like myStringToInt64Many.
+ */
+MyStringRetVal myStringToDoubleMany(const MyString * const *strs, unsigned long n, double *out,
+                                    bool *valid);
+
 
 /**
  * @brief Returns the value of str as a C string, terminated with the
@@ -155,6 +496,7 @@ char * myStringToCString(const MyString *str);
 
 /**
  * @brief Appends a copy of the source MyString src to the destination MyString dst.
+ * 	src may be the same struct as dest.
  * @param dest the destination
  * @param src the MyString to append
  * RETURN VALUE:
@@ -162,6 +504,28 @@ char * myStringToCString(const MyString *str);
  */
 MyStringRetVal myStringCat(MyString * dest, const MyString * src);
 
+/**
+ * @brief Appends copies of the n MyStrings in srcs (in order) to the destination MyString dest.
+ * 	dest is resized at most once. Any of the sources may be dest itself.
+ * @param dest the destination
+ * @param srcs array of the MyStrings to append
+ * @param n the amount of MyStrings in srcs
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringCatMany(MyString *dest, const MyString * const *srcs, unsigned long n);
+
+/**
+ * @brief Like myStringCat, but a destination whose struct and chars are a single block stays
+ * 	that way. The MyString may move, so *dest is set to its new address.
+ * 	src may be the same struct as *dest.
+ * @param dest pointer to the destination
+ * @param src the MyString to append
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringCatEx(MyString **dest, const MyString *src);
+
 /**
  * @brief Sets result to be the concatenation of str1 and str2.
  * 	result should be initially allocated by the caller.
@@ -231,9 +595,35 @@ int myStringEqual(const MyString *str1, const MyString *str2);
 int myStringCustomEqual(const MyString *str1, const MyString *str2,
                         int (*foo)(const char *char1, const char * char2));
 
+/**
+ * @brief Char comparator for myStringCustomCompare and myStringCustomEqual (and myStringCustomSort)
+ * 	that ignores the case of ASCII letters.
+ * 	The compare functions recognize it, like the default comparators, and compare many chars at
+ * 	once instead of calling it for every char.
+ * @param char1
+ * @param char2
+ * RETURN VALUE:
+ * @return 0 if the chars are equal ignoring case, 1 if char1 is bigger, -1 if char2 is,
+ * 	and MYSTR_ERROR_CODE if they cannot be compared.
+ */
+int myStringCharCaseCompare(const char *char1, const char *char2);
+
+/**
+ * @brief Compares str1 and str2 treating runs of digits as numbers, so "file9" is smaller than "file10".
+ * 	Other chars are compared as in myStringCompare, and strings whose numbers only differ in leading
+ * 	zeros are ordered by myStringCompare.
+ * @param str1
+ * @param str2
+ * RETURN VALUE:
+ * @return 0 if the strings are equal, 1 if str1 is bigger, -1 if str2 is,
+ * 	and MYSTR_ERROR_CODE if they cannot be compared.
+ */
+int myStringNaturalCompare(const MyString *str1, const MyString *str2);
+
 
 /**
  * @return the amount of memory (all the memory that used by the MyString object itself and its allocations), in bytes, allocated to str1.
+ * 	Contents shared between clones are counted in full for each of them.
  */
 unsigned long myStringMemUsage(const MyString *str1);
 
@@ -242,14 +632,199 @@ unsigned long myStringMemUsage(const MyString *str1);
  */
 unsigned long myStringLen(const MyString *str1);
 
+/**
+ * @return the capacity of str1 (the length it can reach without reallocating).
+ */
+unsigned long myStringCapacity(const MyString *str1);
+
+/**
+ * @brief Makes sure str can hold a string of the given length without reallocating.
+ * 	Useful for pre-sizing a string before a loop of appends. Never shrinks str.
+ * @param str the MyString to reserve memory for.
+ * @param capacity the length str should be able to hold.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringReserve(MyString *str, unsigned long capacity);
+
+/**
+ * @brief Like myStringReserve, but a string whose struct and chars are a single block stays that
+ * 	way. The MyString may move, so *str is set to its new address.
+ * @param str pointer to the MyString to reserve memory for.
+ * @param capacity the length the string should be able to hold.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringReserveEx(MyString **str, unsigned long capacity);
+
+/**
+ * @brief Releases the unused capacity of str.
+ * @param str the MyString to shrink.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringShrinkToFit(MyString *str);
+
 /**
  * Writes the content of str to stream. (like fputs())
+ * Null bytes in str are written too, and the stream is not flushed.
  *
  * RETURNS:
  *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
  */
 MyStringRetVal myStringWrite(const MyString *str, FILE *stream);
 
+/**
+ * Writes n strings to stream, each followed by sep (NULL for no separator).
+ * The stream is not flushed.
+ *
+ * RETURNS:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriteMany(const MyString * const *strs, unsigned long n,
+                                 const MyString *sep, FILE *stream);
+
+/**
+ * Writes n strings to the file descriptor fd, each followed by sep (NULL for no separator),
+ * with as few system calls as possible (writev of many strings at once).
+ * Should not be mixed with writes to a FILE* of the same fd that were not flushed yet.
+ *
+ * RETURNS:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriteManyFd(const MyString * const *strs, unsigned long n,
+                                   const MyString *sep, int fd);
+
+/**
+ * @brief Creates a MyStringWriter that writes to stream. It is the caller's responsibility to
+ * 	destroy it (before closing stream).
+ * @param stream open file stream.
+ * @param bufferSize size of the buffer in bytes, 0 for a default size.
+ * @param policy when the buffer is written out.
+ * @param lines amount of lines between flushes with MYSTRING_FLUSH_LINES.
+ * RETURN VALUE:
+ * @return a pointer to the new writer, or NULL on failure.
+ */
+MyStringWriter * myStringWriterCreate(FILE *stream, unsigned long bufferSize,
+                                      MyStringFlushPolicy policy, unsigned long lines);
+
+/**
+ * @brief Creates a MyStringWriter that writes to the file descriptor fd.
+ * 	Like myStringWriterCreate.
+ */
+MyStringWriter * myStringWriterCreateFd(int fd, unsigned long bufferSize,
+                                        MyStringFlushPolicy policy, unsigned long lines);
+
+/**
+ * @brief Writes what is left in the buffer of writer and frees it. Flush first to check for errors.
+ * @param writer the writer to destroy.
+ * If writer is NULL, no operation is performed.
+ */
+void myStringWriterDestroy(MyStringWriter *writer);
+
+/**
+ * @brief Adds the content of str to writer (null bytes included).
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriterWrite(MyStringWriter *writer, const MyString *str);
+
+/**
+ * @brief Adds a C string to writer.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriterWriteCString(MyStringWriter *writer, const char *cString);
+
+/**
+ * @brief Adds a single char (like a separator) to writer.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriterWriteChar(MyStringWriter *writer, char c);
+
+/**
+ * @brief Adds the decimal representation of n to writer, like myStringSetFromInt.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriterWriteInt(MyStringWriter *writer, int n);
+
+/**
+ * @brief Writes the buffer of writer out, and flushes its stream.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure (the buffer is kept).
+ */
+MyStringRetVal myStringWriterFlush(MyStringWriter *writer);
+
+/**
+ * @brief Gets the statistics of writer.
+ * @param writer the writer.
+ * @param stats the statistics to fill.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringWriterGetStats(const MyStringWriter *writer, MyStringWriterStats *stats);
+
+/**
+ * @brief Sets str to the next line of stream (without the new line char). There is no limit on the
+ * 	length of the line, and the array of str is reused, so reading many lines into the same
+ * 	MyString allocates only when a line is longer than all the lines before it.
+ * @param str the MyString to set.
+ * @param stream open file stream.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS if a line was read (the last line may end without a new line),
+ *  MYSTRING_EOF if the stream had no more chars (str is then empty), MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringReadLine(MyString *str, FILE *stream);
+
+/**
+ * @brief Sets str to the chars of stream up to the next delim (which is read but not kept).
+ * 	Like myStringReadLine.
+ */
+MyStringRetVal myStringReadUntil(MyString *str, FILE *stream, char delim);
+
+/**
+ * @brief Creates a MyStringLineReader reading the file descriptor fd in big blocks.
+ * 	It is the caller's responsibility to destroy it. fd is not closed by the reader.
+ * @param fd open file descriptor.
+ * @param delim the char ending every line (like '\n').
+ * @param bufferSize size of the block read at once, 0 for a default size.
+ * RETURN VALUE:
+ * @return a pointer to the new reader, or NULL on failure.
+ */
+MyStringLineReader * myStringLineReaderCreate(int fd, char delim, unsigned long bufferSize);
+
+/**
+ * @brief Frees reader.
+ * If reader is NULL, no operation is performed.
+ */
+void myStringLineReaderDestroy(MyStringLineReader *reader);
+
+/**
+ * @brief Gets the next line of reader (without its delim), inside the buffer of the reader.
+ * 	Nothing is allocated or copied for a line unless it is longer than the buffer.
+ * @param reader the reader.
+ * @param line set to the first char of the line. It is valid until the next call.
+ * @param length set to the length of the line.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS if there was a line (the last line may end without a delim),
+ *  MYSTRING_EOF if there are no more lines, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringLineReaderNext(MyStringLineReader *reader, const char **line,
+                                      unsigned long *length);
+
+/**
+ * @brief Comparator of MyString pointers for myStringCustomSort and qsort, ordering them like
+ * 	myStringCompare. myStringCustomSort and myStringCustomSortParallel sort with myStringSort and
+ * 	myStringSortParallel when given it.
+ * @param str1 pointer to a pointer to a MyString.
+ * @param str2 pointer to a pointer to a MyString.
+ * RETURN VALUE:
+ *  @return the result of myStringCompare on the two MyStrings.
+ */
+int myStringDefaultCompare(const void *str1, const void *str2);
+
 /**
  * @brief sort an array of MyString pointers
  * @param arr
@@ -268,5 +843,626 @@ void myStringCustomSort(MyString **arr, int len, int (*foo)(const void* str1, co
   */
 void myStringSort(MyString **arr, int len);
 
+/**
+ * @brief sorts an array of MyString pointers according to the default comparison (like in myStringCompare),
+ * 	keeping equal MyStrings in the order they had.
+ * @param arr
+ * @param len
+ *
+ * RETURN VALUE: none
+ */
+void myStringSortStable(MyString **arr, int len);
+
+/**
+ * @brief sorts an array of MyString pointers like myStringSort, using several threads for big arrays.
+ * @param arr
+ * @param len
+ * @param nthreads the amount of threads to use, 0 or less for one per core.
+ *
+ * RETURN VALUE: none
+ */
+void myStringSortParallel(MyString **arr, int len, int nthreads);
+
+/**
+ * @brief sorts an array of MyString pointers like myStringCustomSort, using several threads for big arrays.
+ * 	The comparator is called from several threads at once.
+ * @param arr
+ * @param len
+ * @param comparator custom comparator
+ * @param nthreads the amount of threads to use, 0 or less for one per core.
+ *
+ * RETURN VALUE: none
+ */
+void myStringCustomSortParallel(MyString **arr, int len,
+                                int (*foo)(const void *str1, const void *str2), int nthreads);
+
+/**
+ * @brief Creates a new, empty MyStringPool. It is the caller's responsibility to destroy it.
+ * RETURN VALUE:
+ * @return a pointer to the new pool, or NULL if the allocation failed.
+ */
+MyStringPool * myStringPoolCreate();
+
+/**
+ * @brief Frees pool and all the canonical MyStrings in it.
+ * @param pool the pool to destroy.
+ * If pool is NULL, no operation is performed.
+ */
+void myStringPoolDestroy(MyStringPool *pool);
+
+/**
+ * @brief Returns the canonical MyString with the same value as str, adding a copy of str to the
+ * 	pool if needed. Two MyStrings interned in the same pool are equal if and only if the returned
+ * 	pointers are equal. The canonical MyString belongs to the pool and must not be changed.
+ * 	May be called from many threads at once.
+ * @param pool the pool to intern in.
+ * @param str the MyString to intern.
+ * RETURN VALUE:
+ * @return the canonical MyString, or NULL if the allocation failed.
+ */
+const MyString * myStringIntern(MyStringPool *pool, const MyString *str);
+
+/**
+ * @brief Gets the statistics of pool.
+ * @param pool the pool.
+ * @param stats the statistics to fill.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringPoolGetStats(MyStringPool *pool, MyStringPoolStats *stats);
+
+/**
+ * @brief Returns a 64 bit hash of str. Equal strings have equal hashes.
+ * 	The hash is kept in str until str is changed, so hashing it again is O(1).
+ * @param str the MyString to hash.
+ * RETURN VALUE:
+ * @return the hash of str, or 0 if str is NULL.
+ */
+uint64_t myStringHash(const MyString *str);
+
+/**
+ * @brief Creates a new, empty MyStringMap. It is the caller's responsibility to destroy it.
+ * RETURN VALUE:
+ * @return a pointer to the new map, or NULL if the allocation failed.
+ */
+MyStringMap * myStringMapCreate();
+
+/**
+ * @brief Frees map and its copies of the keys. The values are not freed.
+ * @param map the map to destroy.
+ * If map is NULL, no operation is performed.
+ */
+void myStringMapDestroy(MyStringMap *map);
+
+/**
+ * @brief Maps key to value in map, replacing any value key had. The map keeps its own copy of key.
+ * @param map the map.
+ * @param key the key.
+ * @param value the value.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringMapInsert(MyStringMap *map, const MyString *key, void *value);
+
+/**
+ * @brief Looks for the value of key in map.
+ * @param map the map.
+ * @param key the key to look for.
+ * @param value set to the value of key if it is found (may be NULL).
+ * RETURN VALUE:
+ * @return true if key is in map, false otherwise.
+ */
+bool myStringMapFind(const MyStringMap *map, const MyString *key, void **value);
+
+/**
+ * @brief Removes key and its value from map.
+ * @param map the map.
+ * @param key the key to remove.
+ * RETURN VALUE:
+ * @return true if key was in map, false otherwise.
+ */
+bool myStringMapErase(MyStringMap *map, const MyString *key);
+
+/**
+ * @return the amount of keys in map.
+ */
+unsigned long myStringMapSize(const MyStringMap *map);
+
+/**
+ * @brief Gets a view of the chars of str.
+ * @param str the MyString to view.
+ * RETURN VALUE:
+ * @return the view, which is empty if str is NULL.
+ */
+MyStringView myStringViewOf(const MyString *str);
+
+/**
+ * @brief Gets a view of cString, without its null byte.
+ * @param cString the C string to view.
+ * RETURN VALUE:
+ * @return the view, which is empty if cString is NULL.
+ */
+MyStringView myStringViewOfCString(const char *cString);
+
+/**
+ * @brief Gets a view of the first length chars of chars (which may contain null bytes).
+ * @param chars the chars to view.
+ * @param length the amount of chars.
+ * RETURN VALUE:
+ * @return the view, which is empty if chars is NULL.
+ */
+MyStringView myStringViewOfBuffer(const char *chars, unsigned long length);
+
+/**
+ * @brief Gets a view of length chars of view starting at index start. Both are cut to fit view.
+ * RETURN VALUE:
+ * @return the view.
+ */
+MyStringView myStringViewSlice(MyStringView view, unsigned long start, unsigned long length);
+
+/**
+ * @brief Compares two views like myStringCompare.
+ * RETURN VALUE:
+ * @return 0 if they are equal, a value greater than 0 if view1 is bigger and less than 0 if it is
+ * 	smaller.
+ */
+int myStringViewCompare(MyStringView view1, MyStringView view2);
+
+/**
+ * @brief Checks if two views have the same chars, like myStringEqual.
+ * RETURN VALUE:
+ * @return a value greater than zero if they are equal, zero if they are not.
+ */
+int myStringViewEqual(MyStringView view1, MyStringView view2);
+
+/**
+ * @brief Gets the integer value of view, like myStringToInt.
+ * RETURN VALUE:
+ * @return the integer, or MYSTR_ERROR_CODE if view is not an integer.
+ */
+int myStringViewToInt(MyStringView view);
+
+/**
+ * @brief Parses view like myStringToInt64.
+ */
+MyStringRetVal myStringViewToInt64(MyStringView view, int64_t *out);
+
+/**
+ * @brief Parses view like myStringToDouble.
+ */
+MyStringRetVal myStringViewToDouble(MyStringView view, double *out);
+
+/**
+ * @brief Writes the chars of view to stream, like myStringWrite.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringViewWrite(MyStringView view, FILE *stream);
+
+/**
+ * @brief Returns a 64 bit hash of view, which is the same as myStringHash of a MyString with the
+ * 	same chars.
+ * RETURN VALUE:
+ * @return the hash of view.
+ */
+uint64_t myStringViewHash(MyStringView view);
+
+/**
+ * @brief Looks for the first occurrence of needle in haystack.
+ * @param haystack the view to search in.
+ * @param needle the view to search for. An empty needle is found at index 0.
+ * @param index set to the index of the occurrence if one is found (may be NULL).
+ * RETURN VALUE:
+ * @return true if needle occurs in haystack, false otherwise.
+ */
+bool myStringViewFind(MyStringView haystack, MyStringView needle, unsigned long *index);
+
+/**
+ * @brief Looks for the first occurrence of needle in haystack (see myStringViewFind).
+ * @param haystack the MyString to search in.
+ * @param needle the MyString to search for. An empty needle is found at index 0.
+ * @param index set to the index of the occurrence if one is found (may be NULL).
+ * RETURN VALUE:
+ * @return true if needle occurs in haystack, false otherwise (or if either is NULL).
+ */
+bool myStringFind(const MyString *haystack, const MyString *needle, unsigned long *index);
+
+/**
+ * @brief Finds all the occurrences of needle in haystack, overlapping ones included (so "aa"
+ * 	occurs twice in "aaa"). A cyclic search also finds the occurrences that wrap around the end
+ * 	of haystack back to its start, so "bca" occurs twice in the cyclic "abcabc" and a needle
+ * 	may be longer than haystack. There is at most one occurrence for every index of haystack.
+ * 	Runs in linear time even for needles like "aaa...ab".
+ * @param haystack the MyString to search in.
+ * @param needle the MyString to search for. An empty needle never occurs.
+ * @param cyclic whether occurrences may wrap around the end of haystack.
+ * @param indices array the indices of the first occurrences are stored in, in increasing order
+ * 	(may be NULL).
+ * @param maxIndices the size of indices.
+ * RETURN VALUE:
+ * @return the amount of occurrences, even if it is more than maxIndices (0 if either is NULL).
+ */
+unsigned long myStringFindAll(const MyString *haystack, const MyString *needle, bool cyclic,
+                              unsigned long *indices, unsigned long maxIndices);
+
+/**
+ * @brief Counts the occurrences of needle in haystack (see myStringFindAll).
+ * @param haystack the MyString to search in.
+ * @param needle the MyString to search for. An empty needle never occurs.
+ * @param cyclic whether occurrences may wrap around the end of haystack.
+ * RETURN VALUE:
+ * @return the amount of occurrences (0 if either is NULL).
+ */
+unsigned long myStringCount(const MyString *haystack, const MyString *needle, bool cyclic);
+
+/**
+ * @brief Sets the value of str to the chars of view. view may be a view of str itself.
+ * @param str the MyString to set.
+ * @param view the chars to set from.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringSetFromView(MyString *str, MyStringView view);
+
+/**
+ * @brief Starts splitting view on every delim. Every delim ends a field, so adjacent delims have
+ * 	an empty field between them and a view with n delims has n + 1 fields (like a CSV line).
+ * 	Nothing is allocated: the fields are views of view.
+ * @param view the view to split.
+ * @param delim the char between the fields.
+ * RETURN VALUE:
+ * @return the splitter to pass to myStringSplitNext.
+ */
+MyStringSplitter myStringSplit(MyStringView view, char delim);
+
+/**
+ * @brief Starts splitting view into tokens, which are the longest runs of chars that are not in
+ * 	delims (like strtok, but without changing view). There are no empty tokens.
+ * 	Nothing is allocated: the tokens are views of view.
+ * @param view the view to split.
+ * @param delims the chars between the tokens (like " \t").
+ * RETURN VALUE:
+ * @return the splitter to pass to myStringSplitNext.
+ */
+MyStringSplitter myStringTokenize(MyStringView view, MyStringView delims);
+
+/**
+ * @brief Gets the next field of splitter.
+ * @param splitter the splitter, from myStringSplit or myStringTokenize.
+ * @param field set to the next field.
+ * RETURN VALUE:
+ * @return true if there was a field, false if there are no more fields.
+ */
+bool myStringSplitNext(MyStringSplitter *splitter, MyStringView *field);
+
+/**
+ * @brief Allocates a new, empty MyRope. It is the caller's responsibility to free it.
+ * RETURN VALUE:
+ * @return a pointer to the new rope, or NULL if the allocation failed.
+ */
+MyRope * myRopeAlloc();
+
+/**
+ * @brief Allocates a new MyRope with the value of str. The array of a MyString on the heap is
+ * 	shared instead of copied (like in myStringClone).
+ * @param str the MyString to convert.
+ * RETURN VALUE:
+ * @return a pointer to the new rope, or NULL on failure.
+ */
+MyRope * myRopeFromMyString(const MyString *str);
+
+/**
+ * @brief Allocates a new MyRope with the value of rope, sharing all of its chunks. O(1).
+ * RETURN VALUE:
+ * @return a pointer to the new rope, or NULL on failure.
+ */
+MyRope * myRopeClone(const MyRope *rope);
+
+/**
+ * @brief Frees rope (chunks shared with other ropes are kept for them).
+ * If rope is NULL, no operation is performed.
+ */
+void myRopeFree(MyRope *rope);
+
+/**
+ * @return the amount of chars in rope.
+ */
+unsigned long myRopeLen(const MyRope *rope);
+
+/**
+ * @brief Appends other to rope in O(log n), where n is the amount of chunks. The chunks are
+ * 	shared, not copied, except that two short chunks that meet are merged, so it copies at most
+ * 	a short leaf's chars (512). other is not changed and may be rope itself.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure (rope is unchanged).
+ */
+MyStringRetVal myRopeCat(MyRope *rope, const MyRope *other);
+
+/**
+ * @brief Appends the value of str to rope, like myRopeCat. Short strings are merged with the
+ * 	chunk before them so ropes built from many small pieces do not have tiny chunks.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure (rope is unchanged).
+ */
+MyStringRetVal myRopeCatMyString(MyRope *rope, const MyString *str);
+
+/**
+ * @brief Inserts other into rope before the char at index, in O(log n).
+ * @param index where to insert, myRopeLen(rope) to append.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure (rope is unchanged).
+ */
+MyStringRetVal myRopeInsert(MyRope *rope, unsigned long index, const MyRope *other);
+
+/**
+ * @brief Splits rope in O(log n): rope keeps its first index chars and the rest are moved to a
+ * 	new rope. It is the caller's responsibility to free the new rope.
+ * RETURN VALUE:
+ * @return a pointer to the new rope, or NULL on failure (rope is then unchanged).
+ */
+MyRope * myRopeSplit(MyRope *rope, unsigned long index);
+
+/**
+ * @brief Gets the char of rope at index in O(log n).
+ * @param c set to the char.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR if index is not in rope.
+ */
+MyStringRetVal myRopeCharAt(const MyRope *rope, unsigned long index, char *c);
+
+/**
+ * @brief Allocates a new MyString with the value of rope. It is the caller's responsibility to
+ * 	free it. The chars are copied once, and rope then keeps the flat copy as its single chunk
+ * 	(sharing its array), so converting it again is O(1) until rope is changed.
+ * RETURN VALUE:
+ * @return a pointer to the new string, or NULL on failure.
+ */
+MyString * myRopeToMyString(MyRope *rope);
+
+/**
+ * @brief Gets the chunk of rope holding the char at offset, from offset to the end of the chunk.
+ * 	Start with offset 0 to go over all the chunks of rope in order. The chunk is valid until rope
+ * 	is changed or freed.
+ * @param offset the index of the first char of the chunk, moved past it.
+ * @param chunk set to the chunk.
+ * RETURN VALUE:
+ * @return true if there was a chunk, false if offset is at the end of rope.
+ */
+bool myRopeNextChunk(const MyRope *rope, unsigned long *offset, MyStringView *chunk);
+
+/**
+ * @brief Writes the content of rope to stream, a chunk at a time.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myRopeWrite(const MyRope *rope, FILE *stream);
+
+/**
+ * @brief Writes the content of rope to the file descriptor fd, giving many chunks at a time to
+ * 	writev.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myRopeWriteFd(const MyRope *rope, int fd);
+
+/**
+ * @brief Creates a new, empty MyStringBuilder. It is the caller's responsibility to destroy it.
+ * 	A builder records pieces and copies them all at once in myStringBuilderFinish, and can then
+ * 	be used again without allocating.
+ * RETURN VALUE:
+ * @return a pointer to the new builder, or NULL if the allocation failed.
+ */
+MyStringBuilder * myStringBuilderCreate();
+
+/**
+ * @brief Frees builder.
+ * If builder is NULL, no operation is performed.
+ */
+void myStringBuilderDestroy(MyStringBuilder *builder);
+
+/**
+ * @brief Drops the pieces of builder, keeping its memory for the next ones.
+ */
+void myStringBuilderReset(MyStringBuilder *builder);
+
+/**
+ * @return the total length of the pieces in builder.
+ */
+unsigned long myStringBuilderLen(const MyStringBuilder *builder);
+
+/**
+ * @brief Appends the chars of str to builder. They are not copied, so str must not be changed or
+ * 	freed until builder is finished or reset.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringBuilderAppend(MyStringBuilder *builder, const MyString *str);
+
+/**
+ * @brief Appends the chars of cString to builder, which must be kept like in
+ * 	myStringBuilderAppend.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringBuilderAppendCString(MyStringBuilder *builder, const char *cString);
+
+/**
+ * @brief Appends the chars of view to builder, which must be kept like in myStringBuilderAppend.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringBuilderAppendView(MyStringBuilder *builder, MyStringView view);
+
+/**
+ * @brief Appends the decimal representation of n to builder (like myStringSetFromInt).
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringBuilderAppendInt(MyStringBuilder *builder, int n);
+
+/**
+ * @brief Appends the char c to builder.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure.
+ */
+MyStringRetVal myStringBuilderAppendChar(MyStringBuilder *builder, char c);
+
+/**
+ * @brief Sets the value of str to the pieces of builder, resizing str at most once, and resets
+ * 	builder. A piece may be str itself.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on failure (builder is then kept).
+ */
+MyStringRetVal myStringBuilderFinish(MyStringBuilder *builder, MyString *str);
+
+/**
+ * @brief Compiles patterns into a MyStringMatcher. The patterns are copied, so they may be
+ * 	changed or freed afterwards. Empty patterns never occur.
+ * 	It is the caller's responsibility to destroy the returned matcher.
+ * @param patterns array of the patterns to find.
+ * @param n the amount of patterns.
+ * RETURN VALUE:
+ * @return the new matcher, or NULL if a pattern is NULL or the allocation failed.
+ */
+MyStringMatcher * myStringMatcherCreate(const MyString * const *patterns, unsigned long n);
+
+/**
+ * @brief Frees a MyStringMatcher. Does nothing if matcher is NULL.
+ */
+void myStringMatcherDestroy(MyStringMatcher *matcher);
+
+/**
+ * @brief Starts a stream of chunks (like the blocks of a file) to scan with a matcher.
+ * RETURN VALUE:
+ * @return the state before the first chunk.
+ */
+MyStringMatchState myStringMatcherStart();
+
+/**
+ * @brief Finds the occurrences of the patterns of matcher that end in chunk, in a single pass
+ * 	over it. Occurrences are found in the order of their ends, and a longer pattern first
+ * 	when two end together. Their starts are counted from the start of the stream.
+ * 	To scan a chunk again with a larger array, keep a copy of state from before the scan.
+ * @param matcher the matcher of the patterns.
+ * @param state the state of the stream, updated to after chunk.
+ * @param chunk the next chars of the stream.
+ * @param matches array the first occurrences are stored in (may be NULL).
+ * @param maxMatches the size of matches.
+ * RETURN VALUE:
+ * @return the amount of occurrences, even if it is more than maxMatches (0 on NULL arguments).
+ */
+unsigned long myStringMatcherScan(const MyStringMatcher *matcher, MyStringMatchState *state,
+                                  MyStringView chunk, MyStringMatch *matches,
+                                  unsigned long maxMatches);
+
+/**
+ * @brief Finds the occurrences of the patterns of matcher in str (see myStringMatcherScan).
+ * RETURN VALUE:
+ * @return the amount of occurrences, even if it is more than maxMatches (0 on NULL arguments).
+ */
+unsigned long myStringMatcherFind(const MyStringMatcher *matcher, const MyString *str,
+                                  MyStringMatch *matches, unsigned long maxMatches);
+
+/**
+ * @brief Builds a suffix array index of str (with SA-IS) and its LCP array, in linear time.
+ * 	The index keeps a copy of str, so str may be changed or freed afterwards.
+ * 	The index keeps about 9 bytes for every char of str (10 when cyclic, as the text is kept
+ * 	twice), and building it needs about 20 more for every char for a while (40 when cyclic).
+ * 	str must be shorter than 4 GB.
+ * 	It is the caller's responsibility to destroy the returned index.
+ * @param str the text to index.
+ * RETURN VALUE:
+ * @return the new index, or NULL if str is NULL, too long or the allocation failed.
+ */
+MyStringIndex * myStringIndexBuild(const MyString *str);
+
+/**
+ * @brief Builds a cyclic index of str (see myStringIndexBuild) by indexing str doubled, so its
+ * 	queries also find the occurrences that wrap around the end of str (like a cyclic
+ * 	myStringCount). str must be shorter than 2 GB.
+ * @param str the text to index.
+ * RETURN VALUE:
+ * @return the new index, or NULL if str is NULL, too long or the allocation failed.
+ */
+MyStringIndex * myStringIndexBuildCyclic(const MyString *str);
+
+/**
+ * @brief Frees a MyStringIndex. Does nothing if index is NULL.
+ */
+void myStringIndexDestroy(MyStringIndex *index);
+
+/**
+ * @brief Counts the occurrences of needle in the text of index, like myStringCount (cyclic for
+ * 	an index built with myStringIndexBuildCyclic), in O(m log n) where m is the length of
+ * 	needle and n of the text.
+ * @param index the index of the text.
+ * @param needle the MyString to search for. An empty needle never occurs.
+ * RETURN VALUE:
+ * @return the amount of occurrences (0 if either is NULL).
+ */
+unsigned long myStringIndexCount(const MyStringIndex *index, const MyString *needle);
+
+/**
+ * @brief Finds the occurrences of needle in the text of index (see myStringIndexCount), in
+ * 	O(m log n + k) where k is the amount of occurrences. The indices come in the order of the
+ * 	suffixes that start there, not in increasing order.
+ * @param index the index of the text.
+ * @param needle the MyString to search for. An empty needle never occurs.
+ * @param indices array the indices of the first occurrences are stored in (may be NULL).
+ * @param maxIndices the size of indices.
+ * RETURN VALUE:
+ * @return the amount of occurrences, even if it is more than maxIndices (0 if either is NULL).
+ */
+unsigned long myStringIndexLocate(const MyStringIndex *index, const MyString *needle,
+                                  unsigned long *indices, unsigned long maxIndices);
+
+/**
+ * @brief Finds the longest substring that occurs at least twice in the text of index (the
+ * 	occurrences may overlap, and wrap around the end of the text for a cyclic index), from
+ * 	the LCP array in O(n).
+ * @param index the index of the text.
+ * @param start set to the index of one of its occurrences (0 if there is no repeat).
+ * @param length set to its length (0 if no char occurs twice).
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on NULL arguments.
+ */
+MyStringRetVal myStringIndexLongestRepeat(const MyStringIndex *index, unsigned long *start,
+                                          unsigned long *length);
+
+/**
+ * @brief Writes index to stream, so it can be loaded instead of built again. The file is only
+ * 	meant to be loaded on a machine of the same byte order.
+ * RETURN VALUE:
+ *  @return MYSTRING_SUCCESS on success, MYSTRING_ERROR on NULL arguments or a write error.
+ */
+MyStringRetVal myStringIndexSave(const MyStringIndex *index, FILE *stream);
+
+/**
+ * @brief Reads an index written by myStringIndexSave from stream, checking that it is a valid
+ * 	index. The memory is allocated as the data arrives, so a broken length in the file only
+ * 	costs about as much as the file holds, even when stream cannot seek (a pipe).
+ * 	It is the caller's responsibility to destroy the returned index.
+ * RETURN VALUE:
+ * @return the loaded index, or NULL if stream does not hold a valid index or the allocation
+ * 	failed.
+ */
+MyStringIndex * myStringIndexLoad(FILE *stream);
+
+/**
+ * @brief Gets the statistics of the library so far. The counters are read one at a time, so
+ * 	while other threads change strings they may not all be from the same moment.
+ * RETURN VALUE:
+ * @return the statistics, all 0 with enabled false unless the library was compiled with
+ * 	-DMYSTRING_STATS.
+ */
+MyStringStats myStringStatsSnapshot();
+
+/**
+ * @brief Sets the counters of the library to 0 (liveBytes too, so it then counts the memory
+ * 	allocated since the reset minus the memory freed since). Does nothing unless the library
+ * 	was compiled with -DMYSTRING_STATS.
+ */
+void myStringStatsReset();
+
 #endif // _MYSTRING_H
 
@@ -0,0 +1,1188 @@
+/********************************************************************************
+ * @file MyStringBench.c
+ * @author  Dan Kufra
+ * @version 1.0
+ * @date 13.08.2015
+ *
+ * @brief Benchmarks for the SLabC Standard Strings library.
+ *
+ * @section DESCRIPTION
+ * Times the operations of the MyString library on big, randomly generated inputs and prints
+ * the results. Every benchmark uses the same fixed seed so runs can be compared.
+ * Cache behaviour can be measured by running the program under perf stat. Compiled with
+ * -DBENCH_CACHE_MISSES (make bench BENCHFLAGS=-DBENCH_CACHE_MISSES), the packed benchmark
+ * also counts the L1 data cache misses of each layout with perf_event_open.
+ ********************************************************************************/
+
+// ------------------------------ includes ------------------------------
+#define _POSIX_C_SOURCE 200809L
+#ifdef BENCH_CACHE_MISSES
+// for syscall
+#define _DEFAULT_SOURCE
+#endif
+#include "MyString.h"
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <math.h>
+#include <ctype.h>
+#ifdef BENCH_CACHE_MISSES
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+// -------------------------- const definitions -------------------------
+/*
+ * @def SORT_COUNT
+ * @brief Amount of strings sorted in the sort benchmarks
+ */
+#define SORT_COUNT 1000000
+/*
+ * @def SORT_LENGTH
+ * @brief Length of every string sorted in the sort benchmarks
+ */
+#define SORT_LENGTH 40
+/*
+ * @def COMPARE_LENGTH
+ * @brief Length of the strings compared in the compare benchmark
+ */
+#define COMPARE_LENGTH 4096
+/*
+ * @def COMPARE_ROUNDS
+ * @brief Amount of times the strings are compared in the compare benchmark
+ */
+#define COMPARE_ROUNDS 100000
+/*
+ * @def WRITE_COUNT
+ * @brief Amount of strings written in the write benchmark
+ */
+#define WRITE_COUNT 1000000
+/*
+ * @def READ_LINES
+ * @brief Amount of lines in the file of the read benchmark
+ */
+#define READ_LINES 4000000
+/*
+ * @def CSV_LINES
+ * @brief Amount of lines split in the split benchmark
+ */
+#define CSV_LINES 200000
+/*
+ * @def CSV_FIELDS
+ * @brief Amount of fields in every line of the split benchmark
+ */
+#define CSV_FIELDS 50
+/*
+ * @def ROPE_FRAGMENTS
+ * @brief Amount of fragments a document is built from in the rope benchmark
+ */
+#define ROPE_FRAGMENTS 10000
+/*
+ * @def BUILD_LINES
+ * @brief Amount of lines assembled in the builder benchmark
+ */
+#define BUILD_LINES 1000000
+/*
+ * @def FORMAT_COUNT
+ * @brief Amount of ints formatted in the format benchmark
+ */
+#define FORMAT_COUNT 10000000
+/*
+ * @def PARSE_COUNT
+ * @brief Amount of numbers parsed in the parse benchmark
+ */
+#define PARSE_COUNT 1000000
+/*
+ * @def PARSE_ROUNDS
+ * @brief Amount of times the numbers are parsed in the parse benchmark
+ */
+#define PARSE_ROUNDS 10
+/*
+ * @def FILTER_SIZE
+ * @brief Length of the text stripped in the filter benchmark
+ */
+#define FILTER_SIZE (64 * 1024 * 1024)
+/*
+ * @def FILTER_ROUNDS
+ * @brief Amount of times the text is stripped in the filter benchmark
+ */
+#define FILTER_ROUNDS 5
+/*
+ * @def SEARCH_SIZE
+ * @brief Length of the text searched in the search benchmark
+ */
+#define SEARCH_SIZE (1024 * 1024)
+/*
+ * @def SEARCH_NEEDLE_SIZE
+ * @brief Length of the needle of the search benchmark
+ */
+#define SEARCH_NEEDLE_SIZE 1000
+/*
+ * @def SEARCH_ROUNDS
+ * @brief Amount of times random text is searched in the search benchmark
+ */
+#define SEARCH_ROUNDS 20
+/*
+ * @def KEYWORD_COUNT
+ * @brief Amount of keywords looked for in the matcher benchmark
+ */
+#define KEYWORD_COUNT 2000
+/*
+ * @def KEYWORD_TEXT_SIZE
+ * @brief Length of the text scanned in the matcher benchmark
+ */
+#define KEYWORD_TEXT_SIZE (4 * 1024 * 1024)
+/*
+ * @def INDEX_TEXT_SIZE
+ * @brief Length of the text indexed in the index benchmark
+ */
+#define INDEX_TEXT_SIZE (8 * 1024 * 1024)
+/*
+ * @def INDEX_QUERIES
+ * @brief Amount of substrings counted in the index benchmark
+ */
+#define INDEX_QUERIES 1000
+/*
+ * @def INT_FIELD_SIZE
+ * @brief Room for an int and the comma before it in the split benchmark
+ */
+#define INT_FIELD_SIZE 12
+/*
+ * @def SEED
+ * @brief Seed of the random generator
+ */
+#define SEED 88172645463325252ULL
+/*
+ * @def ALPHABET_SIZE
+ * @brief Amount of letters used in random strings
+ */
+#define ALPHABET_SIZE 26
+
+/*
+ * Random generator state
+ */
+static unsigned long long randomState = SEED;
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * @brief xorshift random generator, so results do not depend on the libc rand().
+ * @return the next random number.
+ */
+static unsigned long long nextRandom()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return randomState;
+}
+
+/**
+ * @brief Fills buffer with length random lowercase letters and a null byte.
+ * @param buffer buffer of at least length + 1 chars.
+ * @param length amount of letters.
+ */
+static void randomWord(char *buffer, int length)
+{
+    for (int i = 0; i < length; i++)
+    {
+        buffer[i] = (char) ('a' + nextRandom() % ALPHABET_SIZE);
+    }
+    buffer[length] = '\0';
+}
+
+/**
+ * @brief Shuffles an array of MyString pointers.
+ * @param arr the array.
+ * @param len the length of arr.
+ */
+static void shuffle(MyString **arr, int len)
+{
+    for (int i = len - 1; i > 0; i--)
+    {
+        int j = (int) (nextRandom() % (i + 1));
+        MyString *temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+/**
+ * @brief Gets the current time.
+ * @return seconds since an arbitrary point.
+ */
+static double now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Frees an array of MyStrings and the array itself.
+ * @param arr the array.
+ * @param len the length of arr.
+ */
+static void freeAll(MyString **arr, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        myStringFree(arr[i]);
+    }
+    free(arr);
+}
+
+#ifdef BENCH_CACHE_MISSES
+/**
+ * @brief Opens a disabled counter of the L1 data cache read misses of this thread.
+ * @return the file descriptor of the counter, or -1 if perf events are not available.
+ */
+static int openCacheCounter()
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * @brief Sorts arr with myStringSort, counting the L1 data cache misses.
+ * @return the amount of misses, or -1 if they could not be counted.
+ */
+static long long countSortMisses(MyString **arr, int len)
+{
+    int counter = openCacheCounter();
+    if (counter >= 0)
+    {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    myStringSort(arr, len);
+    long long misses = -1;
+    if (counter >= 0)
+    {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) != sizeof(misses))
+        {
+            misses = -1;
+        }
+        close(counter);
+    }
+    return misses;
+}
+#endif
+
+/**
+ * @brief Sorts SORT_COUNT strings whose chars are in a separate block from their struct, and
+ *        the same strings allocated as single blocks with myStringAllocPacked.
+ *        The structs are all allocated before any of the chars, like strings that are filled
+ *        after being created, so the separate layout pays a pointer chase to another cache line.
+ */
+static void benchPackedSort()
+{
+    MyString **separate = malloc(SORT_COUNT * sizeof(MyString *));
+    MyString **packed = malloc(SORT_COUNT * sizeof(MyString *));
+    char word[SORT_LENGTH + 1];
+    for (int i = 0; i < SORT_COUNT; i++)
+    {
+        separate[i] = myStringAlloc();
+    }
+    for (int i = 0; i < SORT_COUNT; i++)
+    {
+        randomWord(word, SORT_LENGTH);
+        myStringSetFromCString(separate[i], word);
+        packed[i] = myStringAllocPacked(SORT_LENGTH);
+        myStringSetFromCString(packed[i], word);
+    }
+    shuffle(separate, SORT_COUNT);
+    shuffle(packed, SORT_COUNT);
+    double start = now();
+    myStringSort(separate, SORT_COUNT);
+    double separateTime = now() - start;
+    start = now();
+    myStringSort(packed, SORT_COUNT);
+    double packedTime = now() - start;
+    printf("myStringSort %d strings: separate %.3fs, packed %.3fs (%.2fx)\n",
+           SORT_COUNT, separateTime, packedTime, separateTime / packedTime);
+#ifdef BENCH_CACHE_MISSES
+    // shuffles and sorts them again, counting the misses instead of timing
+    shuffle(separate, SORT_COUNT);
+    shuffle(packed, SORT_COUNT);
+    long long separateMisses = countSortMisses(separate, SORT_COUNT);
+    long long packedMisses = countSortMisses(packed, SORT_COUNT);
+    if (separateMisses < 0 || packedMisses < 0)
+    {
+        printf("myStringSort L1 data cache misses: perf events are not available\n");
+    }
+    else
+    {
+        printf("myStringSort L1 data cache misses: separate %lld, packed %lld (%.2fx)\n",
+               separateMisses, packedMisses, (double) separateMisses / packedMisses);
+    }
+#endif
+    freeAll(separate, SORT_COUNT);
+    freeAll(packed, SORT_COUNT);
+}
+
+/**
+ * @brief qsort comparator of MyString pointers, the way myStringSort used to sort.
+ */
+static int qsortCompare(const void *str1, const void *str2)
+{
+    return myStringCompare(*(MyString * const *) str1, *(MyString * const *) str2);
+}
+
+/**
+ * @brief Sorts SORT_COUNT log lines (sharing their first chars, like lines of the same day) with
+ *        qsort and a comparator, with myStringSort and with myStringSortStable.
+ */
+static void benchSort()
+{
+    MyString **lines = malloc(SORT_COUNT * sizeof(MyString *));
+    MyString **copy = malloc(SORT_COUNT * sizeof(MyString *));
+    char line[SORT_LENGTH * 2];
+    char word[SORT_LENGTH + 1];
+    for (int i = 0; i < SORT_COUNT; i++)
+    {
+        randomWord(word, SORT_LENGTH / 2);
+        sprintf(line, "2015-08-13 %02d:%02d:%02d INFO %s", (int) (nextRandom() % 24),
+                (int) (nextRandom() % 60), (int) (nextRandom() % 60), word);
+        lines[i] = myStringAlloc();
+        myStringSetFromCString(lines[i], line);
+    }
+    memcpy(copy, lines, SORT_COUNT * sizeof(MyString *));
+    double start = now();
+    qsort(copy, SORT_COUNT, sizeof(MyString *), qsortCompare);
+    double qsortTime = now() - start;
+    memcpy(copy, lines, SORT_COUNT * sizeof(MyString *));
+    start = now();
+    myStringSort(copy, SORT_COUNT);
+    double radixTime = now() - start;
+    memcpy(copy, lines, SORT_COUNT * sizeof(MyString *));
+    start = now();
+    myStringSortStable(copy, SORT_COUNT);
+    double stableTime = now() - start;
+    printf("sort %d log lines: qsort %.3fs, myStringSort %.3fs (%.2fx), "
+           "myStringSortStable %.3fs (%.2fx)\n", SORT_COUNT, qsortTime, radixTime,
+           qsortTime / radixTime, stableTime, qsortTime / stableTime);
+    free(copy);
+    freeAll(lines, SORT_COUNT);
+}
+
+/**
+ * @brief Sorts SORT_COUNT random words with myStringSortParallel for every power of 2 of threads
+ *        up to twice the amount of cores, and prints the speedup over myStringSort.
+ */
+static void benchParallelSort()
+{
+    MyString **words = malloc(SORT_COUNT * sizeof(MyString *));
+    MyString **copy = malloc(SORT_COUNT * sizeof(MyString *));
+    char word[SORT_LENGTH + 1];
+    for (int i = 0; i < SORT_COUNT; i++)
+    {
+        randomWord(word, SORT_LENGTH);
+        words[i] = myStringAlloc();
+        myStringSetFromCString(words[i], word);
+    }
+    memcpy(copy, words, SORT_COUNT * sizeof(MyString *));
+    double start = now();
+    myStringSort(copy, SORT_COUNT);
+    double serialTime = now() - start;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("parallel sort %d strings on %ld cores: serial %.3fs", SORT_COUNT, cores, serialTime);
+    for (int threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        memcpy(copy, words, SORT_COUNT * sizeof(MyString *));
+        start = now();
+        myStringSortParallel(copy, SORT_COUNT, threads);
+        double parallelTime = now() - start;
+        printf(", %d threads %.3fs (%.2fx)", threads, parallelTime, serialTime / parallelTime);
+    }
+    printf("\n");
+    free(copy);
+    freeAll(words, SORT_COUNT);
+}
+
+/**
+ * @brief Writes WRITE_COUNT lines to /dev/null the way myStringWrite used to (a C string copy,
+ *        fputs and fflush for every string), with myStringWrite, with myStringWriteMany, with
+ *        myStringWriteManyFd and with a MyStringWriter on the file descriptor.
+ */
+static void benchWrite()
+{
+    MyString **lines = malloc(WRITE_COUNT * sizeof(MyString *));
+    char word[SORT_LENGTH + 1];
+    for (int i = 0; i < WRITE_COUNT; i++)
+    {
+        randomWord(word, SORT_LENGTH);
+        lines[i] = myStringAlloc();
+        myStringSetFromCString(lines[i], word);
+    }
+    MyString *newLine = myStringAlloc();
+    myStringSetFromCString(newLine, "\n");
+    FILE *stream = fopen("/dev/null", "w");
+    double start = now();
+    for (int i = 0; i < WRITE_COUNT; i++)
+    {
+        char *cString = myStringToCString(lines[i]);
+        fputs(cString, stream);
+        fputs("\n", stream);
+        fflush(stream);
+        free(cString);
+    }
+    double copyTime = now() - start;
+    start = now();
+    for (int i = 0; i < WRITE_COUNT; i++)
+    {
+        myStringWrite(lines[i], stream);
+        myStringWrite(newLine, stream);
+    }
+    fflush(stream);
+    double writeTime = now() - start;
+    start = now();
+    myStringWriteMany((const MyString * const *) lines, WRITE_COUNT, newLine, stream);
+    fflush(stream);
+    double manyTime = now() - start;
+    fclose(stream);
+    int fd = open("/dev/null", O_WRONLY);
+    start = now();
+    myStringWriteManyFd((const MyString * const *) lines, WRITE_COUNT, newLine, fd);
+    double fdTime = now() - start;
+    MyStringWriter *writer = myStringWriterCreateFd(fd, 0, MYSTRING_FLUSH_SIZE, 0);
+    start = now();
+    for (int i = 0; i < WRITE_COUNT; i++)
+    {
+        myStringWriterWrite(writer, lines[i]);
+        myStringWriterWriteChar(writer, '\n');
+    }
+    myStringWriterFlush(writer);
+    double writerTime = now() - start;
+    myStringWriterDestroy(writer);
+    close(fd);
+    printf("write %d lines: copy and flush %.3fs, myStringWrite %.3fs (%.2fx), "
+           "myStringWriteMany %.3fs (%.2fx), myStringWriteManyFd %.3fs (%.2fx), "
+           "MyStringWriter %.3fs (%.2fx)\n", WRITE_COUNT, copyTime, writeTime,
+           copyTime / writeTime, manyTime, copyTime / manyTime, fdTime, copyTime / fdTime,
+           writerTime, copyTime / writerTime);
+    myStringFree(newLine);
+    freeAll(lines, WRITE_COUNT);
+}
+
+/**
+ * @brief Writes READ_LINES log lines to a temporary file and reads them back with
+ *        myStringReadLine and with a MyStringLineReader, printing the speed of each.
+ */
+static void benchReadLine()
+{
+    FILE *file = tmpfile();
+    char word[SORT_LENGTH + 1];
+    for (int i = 0; i < READ_LINES; i++)
+    {
+        randomWord(word, (int) (nextRandom() % SORT_LENGTH));
+        fprintf(file, "2015-08-13 12:00:%02d INFO %s\n", i % 60, word);
+    }
+    fflush(file);
+    double size = ftell(file);
+    rewind(file);
+    MyString *line = myStringAlloc();
+    unsigned long total = 0;
+    double start = now();
+    while (myStringReadLine(line, file) == MYSTRING_SUCCESS)
+    {
+        total += myStringLen(line);
+    }
+    double readLineTime = now() - start;
+    lseek(fileno(file), 0, SEEK_SET);
+    MyStringLineReader *reader = myStringLineReaderCreate(fileno(file), '\n', 0);
+    const char *chars;
+    unsigned long length;
+    start = now();
+    while (myStringLineReaderNext(reader, &chars, &length) == MYSTRING_SUCCESS)
+    {
+        total += length;
+    }
+    double readerTime = now() - start;
+    printf("read %d lines (%.0f MB): myStringReadLine %.3fs (%.2f GB/s), "
+           "MyStringLineReader %.3fs (%.2f GB/s) [%lu]\n", READ_LINES, size / 1e6, readLineTime,
+           size / readLineTime / 1e9, readerTime, size / readerTime / 1e9, total);
+    myStringLineReaderDestroy(reader);
+    myStringFree(line);
+    fclose(file);
+}
+
+/**
+ * @brief Parses the int fields of CSV lines, once by copying every field into its own MyString
+ *        and once with views from myStringSplit, which do not allocate.
+ */
+static void benchSplit()
+{
+    // a single line of numbers is parsed over and over, so only the parsing is timed
+    char line[CSV_FIELDS * INT_FIELD_SIZE];
+    int length = 0;
+    for (int i = 0; i < CSV_FIELDS; i++)
+    {
+        length += sprintf(line + length, "%s%d", (i == 0) ? "" : ",",
+                          (int) (nextRandom() % 2000000) - 1000000);
+    }
+    MyStringView view = myStringViewOfBuffer(line, (unsigned long) length);
+    long sum = 0;
+    double start = now();
+    for (int i = 0; i < CSV_LINES; i++)
+    {
+        const char *field = line;
+        for (const char *c = line; c <= line + length; c++)
+        {
+            if (c == line + length || *c == ',')
+            {
+                MyString *str = myStringAlloc();
+                myStringSetFromView(str, myStringViewOfBuffer(field, (unsigned long) (c - field)));
+                sum += myStringToInt(str);
+                myStringFree(str);
+                field = c + 1;
+            }
+        }
+    }
+    double copyTime = now() - start;
+    start = now();
+    for (int i = 0; i < CSV_LINES; i++)
+    {
+        MyStringSplitter splitter = myStringSplit(view, ',');
+        MyStringView field;
+        while (myStringSplitNext(&splitter, &field))
+        {
+            sum += myStringViewToInt(field);
+        }
+    }
+    double splitTime = now() - start;
+    printf("split %d lines of %d fields: MyString per field %.3fs, views %.3fs (%.2fx) [%ld]\n",
+           CSV_LINES, CSV_FIELDS, copyTime, splitTime, copyTime / splitTime, sum);
+}
+
+/**
+ * @brief Builds a document by putting every fragment before the ones already in it, once with
+ *        myStringCatTo (which copies the whole document every time) and once with a MyRope that
+ *        is flattened at the end.
+ */
+static void benchRope()
+{
+    MyString **fragments = malloc(ROPE_FRAGMENTS * sizeof(MyString *));
+    char word[SORT_LENGTH + 1];
+    for (int i = 0; i < ROPE_FRAGMENTS; i++)
+    {
+        randomWord(word, SORT_LENGTH);
+        fragments[i] = myStringAlloc();
+        myStringSetFromCString(fragments[i], word);
+    }
+    MyString *document = myStringAlloc();
+    MyString *temp = myStringAlloc();
+    double start = now();
+    for (int i = 0; i < ROPE_FRAGMENTS; i++)
+    {
+        myStringCatTo(fragments[i], document, temp);
+        MyString *swap = document;
+        document = temp;
+        temp = swap;
+    }
+    double stringTime = now() - start;
+    start = now();
+    MyRope *rope = myRopeAlloc();
+    MyRope *fragment = myRopeAlloc();
+    for (int i = 0; i < ROPE_FRAGMENTS; i++)
+    {
+        myRopeFree(fragment);
+        fragment = myRopeFromMyString(fragments[i]);
+        myRopeInsert(rope, 0, fragment);
+    }
+    MyString *flat = myRopeToMyString(rope);
+    double ropeTime = now() - start;
+    printf("prepend %d fragments (%lu chars): myStringCatTo %.3fs, MyRope %.3fs (%.2fx) [%d]\n",
+           ROPE_FRAGMENTS, myStringLen(flat), stringTime, ropeTime, stringTime / ropeTime,
+           myStringEqual(document, flat));
+    for (int i = 0; i < ROPE_FRAGMENTS; i++)
+    {
+        myStringFree(fragments[i]);
+    }
+    free(fragments);
+    myStringFree(document);
+    myStringFree(temp);
+    myStringFree(flat);
+    myRopeFree(rope);
+    myRopeFree(fragment);
+}
+
+/**
+ * @brief Assembles log lines from 15 pieces, once with a myStringCat for every piece and once
+ *        with a MyStringBuilder that copies them all at once.
+ */
+static void benchBuilder()
+{
+    char word[SORT_LENGTH + 1];
+    randomWord(word, SORT_LENGTH);
+    MyString *message = myStringAlloc();
+    MyString *level = myStringAlloc();
+    MyString *separator = myStringAlloc();
+    MyString *number = myStringAlloc();
+    myStringSetFromCString(message, word);
+    myStringSetFromCString(level, "INFO");
+    myStringSetFromCString(separator, " | ");
+    MyString *line = myStringAlloc();
+    unsigned long total = 0;
+    double start = now();
+    for (int i = 0; i < BUILD_LINES; i++)
+    {
+        myStringSetFromCString(line, "");
+        for (int j = 0; j < 3; j++)
+        {
+            myStringSetFromInt(number, i + j);
+            myStringCat(line, number);
+            myStringCat(line, separator);
+            myStringCat(line, level);
+            myStringCat(line, separator);
+            myStringCat(line, message);
+        }
+        total += myStringLen(line);
+    }
+    double catTime = now() - start;
+    MyStringBuilder *builder = myStringBuilderCreate();
+    start = now();
+    for (int i = 0; i < BUILD_LINES; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            myStringBuilderAppendInt(builder, i + j);
+            myStringBuilderAppend(builder, separator);
+            myStringBuilderAppend(builder, level);
+            myStringBuilderAppend(builder, separator);
+            myStringBuilderAppend(builder, message);
+        }
+        myStringBuilderFinish(builder, line);
+        total += myStringLen(line);
+    }
+    double builderTime = now() - start;
+    printf("build %d lines of 15 pieces: myStringCat %.3fs, MyStringBuilder %.3fs (%.2fx) [%lu]\n",
+           BUILD_LINES, catTime, builderTime, catTime / builderTime, total);
+    myStringBuilderDestroy(builder);
+    myStringFree(message);
+    myStringFree(level);
+    myStringFree(separator);
+    myStringFree(number);
+    myStringFree(line);
+}
+
+/**
+ * @brief The int formatting myStringSetFromInt used to have, with pow and floor on doubles for
+ *        every digit, kept as the baseline of the format benchmark.
+ * @return the amount of chars written.
+ */
+static unsigned long powFormatInt(int n, char *buffer)
+{
+    int magnitude = (n < 0) ? -n : n;
+    double digits = 0;
+    while (floor(magnitude / pow(10.0, digits)) != 0)
+    {
+        digits++;
+    }
+    unsigned long length = (unsigned long) digits + (n <= 0);
+    unsigned long i = 0;
+    unsigned long digitCounter = length;
+    if (n < 0)
+    {
+        buffer[i++] = '-';
+        n = -n;
+        digitCounter--;
+    }
+    for (; i < length; i++)
+    {
+        long divider = (n / pow(10.0, digitCounter - 1));
+        buffer[i] = floor(divider) + '0';
+        n -= (pow(10.0, digitCounter - 1) * divider);
+        digitCounter--;
+    }
+    return length;
+}
+
+/**
+ * @brief Formats random ints of all sizes with the old pow based code, with snprintf and with
+ *        myStringSetFromInt.
+ */
+static void benchFormat()
+{
+    int *values = malloc(FORMAT_COUNT * sizeof(int));
+    for (int i = 0; i < FORMAT_COUNT; i++)
+    {
+        // spread the values over all the amounts of digits and both signs
+        values[i] = (int) (nextRandom() >> (nextRandom() % 32 + 33));
+        values[i] = (nextRandom() % 2 == 0) ? values[i] : -values[i];
+    }
+    char buffer[INT_FIELD_SIZE];
+    unsigned long total = 0;
+    double start = now();
+    for (int i = 0; i < FORMAT_COUNT; i++)
+    {
+        total += powFormatInt(values[i], buffer);
+    }
+    double powTime = now() - start;
+    start = now();
+    for (int i = 0; i < FORMAT_COUNT; i++)
+    {
+        total += (unsigned long) snprintf(buffer, sizeof(buffer), "%d", values[i]);
+    }
+    double printfTime = now() - start;
+    MyString *str = myStringAlloc();
+    start = now();
+    for (int i = 0; i < FORMAT_COUNT; i++)
+    {
+        myStringSetFromInt(str, values[i]);
+        total += myStringLen(str);
+    }
+    double tableTime = now() - start;
+    printf("format %d ints: pow %.3fs, snprintf %.3fs, myStringSetFromInt %.3fs (%.2fx, %.2fx) "
+           "[%lu]\n", FORMAT_COUNT, powTime, printfTime, tableTime, powTime / tableTime,
+           printfTime / tableTime, total);
+    myStringFree(str);
+    free(values);
+}
+
+/**
+ * @brief Parses a column of numbers into an array, with strtoll and strtod (on C strings) and with
+ *        myStringToInt64Many and myStringToDoubleMany.
+ */
+static void benchParse()
+{
+    MyString **ints = malloc(PARSE_COUNT * sizeof(MyString *));
+    MyString **doubles = malloc(PARSE_COUNT * sizeof(MyString *));
+    char **intStrings = malloc(PARSE_COUNT * sizeof(char *));
+    char **doubleStrings = malloc(PARSE_COUNT * sizeof(char *));
+    int64_t *intColumn = malloc(PARSE_COUNT * sizeof(int64_t));
+    double *doubleColumn = malloc(PARSE_COUNT * sizeof(double));
+    char buffer[SORT_LENGTH];
+    for (int i = 0; i < PARSE_COUNT; i++)
+    {
+        // ids and counters of all sizes, and measurements with a few decimals
+        snprintf(buffer, sizeof(buffer), "%lld",
+                 (long long) (nextRandom() >> (nextRandom() % 64)) / 2);
+        ints[i] = myStringAlloc();
+        myStringSetFromCString(ints[i], buffer);
+        intStrings[i] = myStringToCString(ints[i]);
+        snprintf(buffer, sizeof(buffer), "%.*f", (int) (nextRandom() % 4) + 1,
+                 (double) (nextRandom() % 10000000) / 100);
+        doubles[i] = myStringAlloc();
+        myStringSetFromCString(doubles[i], buffer);
+        doubleStrings[i] = myStringToCString(doubles[i]);
+    }
+    double sum = 0;
+    double start = now();
+    for (int round = 0; round < PARSE_ROUNDS; round++)
+    {
+        for (int i = 0; i < PARSE_COUNT; i++)
+        {
+            intColumn[i] = strtoll(intStrings[i], NULL, 10);
+        }
+        sum += (double) intColumn[round];
+    }
+    double strtollTime = now() - start;
+    start = now();
+    for (int round = 0; round < PARSE_ROUNDS; round++)
+    {
+        myStringToInt64Many((const MyString * const *) ints, PARSE_COUNT, intColumn, NULL);
+        sum += (double) intColumn[round];
+    }
+    double intTime = now() - start;
+    start = now();
+    for (int round = 0; round < PARSE_ROUNDS; round++)
+    {
+        for (int i = 0; i < PARSE_COUNT; i++)
+        {
+            doubleColumn[i] = strtod(doubleStrings[i], NULL);
+        }
+        sum += doubleColumn[round];
+    }
+    double strtodTime = now() - start;
+    start = now();
+    for (int round = 0; round < PARSE_ROUNDS; round++)
+    {
+        myStringToDoubleMany((const MyString * const *) doubles, PARSE_COUNT, doubleColumn, NULL);
+        sum += doubleColumn[round];
+    }
+    double doubleTime = now() - start;
+    printf("parse %d numbers %d times: strtoll %.3fs, myStringToInt64Many %.3fs (%.2fx), "
+           "strtod %.3fs, myStringToDoubleMany %.3fs (%.2fx) [%g]\n", PARSE_COUNT, PARSE_ROUNDS,
+           strtollTime, intTime, strtollTime / intTime, strtodTime, doubleTime,
+           strtodTime / doubleTime, sum);
+    for (int i = 0; i < PARSE_COUNT; i++)
+    {
+        myStringFree(ints[i]);
+        myStringFree(doubles[i]);
+        free(intStrings[i]);
+        free(doubleStrings[i]);
+    }
+    free(ints);
+    free(doubles);
+    free(intStrings);
+    free(doubleStrings);
+    free(intColumn);
+    free(doubleColumn);
+}
+
+/**
+ * @brief Char comparator the library does not recognize, so it is called for every char.
+ */
+static int charCompare(const char *char1, const char *char2)
+{
+    return (*char1 > *char2) - (*char1 < *char2);
+}
+
+/**
+ * @brief Compares two long strings that only differ in their last char, calling a comparator
+ *        for every char and with the compare kernel behind myStringCompare.
+ */
+static void benchCompare()
+{
+    char word[COMPARE_LENGTH + 1];
+    randomWord(word, COMPARE_LENGTH);
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
+    myStringSetFromCString(str1, word);
+    word[COMPARE_LENGTH - 1] = '~';
+    myStringSetFromCString(str2, word);
+    long sum = 0;
+    double start = now();
+    for (int i = 0; i < COMPARE_ROUNDS; i++)
+    {
+        sum += myStringCustomCompare(str1, str2, charCompare);
+    }
+    double callbackTime = now() - start;
+    start = now();
+    for (int i = 0; i < COMPARE_ROUNDS; i++)
+    {
+        sum += myStringCompare(str1, str2);
+    }
+    double kernelTime = now() - start;
+    printf("compare %d chars %d times: callback %.3fs, kernel %.3fs (%.2fx) [%ld]\n",
+           COMPARE_LENGTH, COMPARE_ROUNDS, callbackTime, kernelTime, callbackTime / kernelTime,
+           sum);
+    myStringFree(str1);
+    myStringFree(str2);
+}
+
+/**
+ * @brief Filter the library does not recognize: removes white space and punctuation.
+ */
+static bool isSpaceOrPunct(const char *c)
+{
+    return isspace((unsigned char) *c) || ispunct((unsigned char) *c);
+}
+
+/**
+ * @brief Strips white space and punctuation from a large text, calling a filter for every char
+ *        and with a MyCharSet, and prints the throughput of both.
+ */
+static void benchFilter()
+{
+    const char *separators = " \t\n,.;:!?\"'()-";
+    char *text = malloc(FILTER_SIZE);
+    for (int i = 0; i < FILTER_SIZE; i++)
+    {
+        unsigned long long r = nextRandom();
+        text[i] = (r % 5 == 0) ? separators[(r >> 8) % strlen(separators)]
+                               : (char) ('a' + (r >> 8) % ALPHABET_SIZE);
+    }
+    MyString *original = myStringAlloc();
+    myStringSetFromView(original, myStringViewOfBuffer(text, FILTER_SIZE));
+    free(text);
+    MyCharSet set;
+    myCharSetClear(&set);
+    for (int c = 0; c < 256; c++)
+    {
+        if (isspace(c) || ispunct(c))
+        {
+            myCharSetAdd(&set, (char) c);
+        }
+    }
+    MyString *str = myStringAlloc();
+    double callbackTime = 0;
+    double setTime = 0;
+    for (int i = 0; i < FILTER_ROUNDS; i++)
+    {
+        myStringSetFromMyString(str, original);
+        double start = now();
+        myStringFilter(str, isSpaceOrPunct);
+        callbackTime += now() - start;
+        unsigned long kept = myStringLen(str);
+        myStringSetFromMyString(str, original);
+        start = now();
+        myStringFilterSet(str, &set);
+        setTime += now() - start;
+        if (myStringLen(str) != kept)
+        {
+            printf("filter and set filter kept a different amount of chars\n");
+        }
+    }
+    double bytes = (double) FILTER_SIZE * FILTER_ROUNDS;
+    printf("strip %d MB %d times: callback %.2f GB/s, char set %.2f GB/s (%.2fx)\n",
+           FILTER_SIZE / (1024 * 1024), FILTER_ROUNDS, bytes / callbackTime / 1e9,
+           bytes / setTime / 1e9, callbackTime / setTime);
+    myStringFree(str);
+    myStringFree(original);
+}
+
+/**
+ * @brief The substring count of the perceptron exercise (countSubStr), which goes back to the
+ *        char after the start of a partial match on every mismatch, kept as the baseline of the
+ *        search benchmark.
+ * @return the amount of occurrences of str2 in str1, wrapping around its end if isCyclic.
+ */
+static unsigned int restartCount(const char *str1, const char *str2, int isCyclic)
+{
+    if (str1 == NULL || str1[0] == '\0' || str2 == NULL || str2[0] == '\0')
+    {
+        return 0;
+    }
+    int total_count = 0;
+    int j = 0;
+    int i = 0;
+    int first_found = 0;
+    do
+    {
+        if (*(str2 + j) != '\0')
+        {
+            if (*(str2 + j) == *(str1 + i))
+            {
+                if (j == 0)
+                {
+                    first_found = i;
+                }
+                j++;
+                i++;
+            }
+            else
+            {
+                if (j == 0)
+                {
+                    i++;
+                }
+                else
+                {
+                    i = first_found + 1;
+                    j = 0;
+                }
+            }
+        }
+        if (*(str2 + j) == '\0')
+        {
+            total_count++;
+            i = ++first_found;
+            if (*(str1 + i) != '\0')
+            {
+                j = 0;
+            }
+        }
+        if (isCyclic && *(str1 + i) == '\0' && *(str2 + j) != '\0' && j != 0)
+        {
+            i = 0;
+        }
+    } while (*(str1 + i) != '\0');
+    return total_count;
+}
+
+/**
+ * @brief Counts a needle in random text and the needle "aaa...ab" in "aaa...a" (which makes
+ *        restarting after a mismatch quadratic), cyclic and not, with countSubStr and
+ *        myStringCount.
+ */
+static void benchSearch()
+{
+    char *text = malloc(SEARCH_SIZE + 1);
+    char *needle = malloc(SEARCH_NEEDLE_SIZE + 1);
+    for (int i = 0; i < SEARCH_SIZE; i++)
+    {
+        text[i] = (char) ('a' + nextRandom() % ALPHABET_SIZE);
+    }
+    text[SEARCH_SIZE] = '\0';
+    // the needle is a word of the text, so there is at least one occurrence
+    memcpy(needle, text + SEARCH_SIZE / 2, 8);
+    needle[8] = '\0';
+    MyString *haystackStr = myStringAlloc();
+    MyString *needleStr = myStringAlloc();
+    myStringSetFromCString(haystackStr, text);
+    myStringSetFromCString(needleStr, needle);
+    unsigned long total = 0;
+    double start = now();
+    for (int i = 0; i < SEARCH_ROUNDS; i++)
+    {
+        total += restartCount(text, needle, i % 2);
+    }
+    double restartTime = now() - start;
+    start = now();
+    for (int i = 0; i < SEARCH_ROUNDS; i++)
+    {
+        total += myStringCount(haystackStr, needleStr, i % 2);
+    }
+    double searchTime = now() - start;
+    printf("count a word in %d random chars %d times: countSubStr %.3fs, myStringCount %.3fs "
+           "(%.2fx) [%lu]\n", SEARCH_SIZE, SEARCH_ROUNDS, restartTime, searchTime,
+           restartTime / searchTime, total);
+    memset(text, 'a', SEARCH_SIZE);
+    memset(needle, 'a', SEARCH_NEEDLE_SIZE);
+    needle[SEARCH_NEEDLE_SIZE - 1] = 'b';
+    needle[SEARCH_NEEDLE_SIZE] = '\0';
+    myStringSetFromCString(haystackStr, text);
+    myStringSetFromCString(needleStr, needle);
+    start = now();
+    total = restartCount(text, needle, 0) + restartCount(text, needle, 1);
+    restartTime = now() - start;
+    start = now();
+    total += myStringCount(haystackStr, needleStr, false) +
+             myStringCount(haystackStr, needleStr, true);
+    searchTime = now() - start;
+    printf("count \"a...ab\" (%d chars) in %d \"a\"s: countSubStr %.3fs, myStringCount %.4fs "
+           "(%.0fx) [%lu]\n", SEARCH_NEEDLE_SIZE, SEARCH_SIZE, restartTime, searchTime,
+           restartTime / searchTime, total);
+    myStringFree(haystackStr);
+    myStringFree(needleStr);
+    free(text);
+    free(needle);
+}
+
+/**
+ * @brief Looks for thousands of keywords in text made of words (a tenth of them keywords), with
+ *        a pass of myStringCount for every keyword and with a single pass of a MyStringMatcher.
+ */
+static void benchMatcher()
+{
+    MyString **keywords = malloc(KEYWORD_COUNT * sizeof(MyString *));
+    char word[ALPHABET_SIZE];
+    for (int i = 0; i < KEYWORD_COUNT; i++)
+    {
+        int length = 4 + (int) (nextRandom() % 9);
+        randomWord(word, length);
+        keywords[i] = myStringAlloc();
+        myStringSetFromView(keywords[i], myStringViewOfBuffer(word, (unsigned long) length));
+    }
+    MyStringBuilder *builder = myStringBuilderCreate();
+    MyString *text = myStringAlloc();
+    while (myStringBuilderLen(builder) < KEYWORD_TEXT_SIZE)
+    {
+        if (nextRandom() % 10 == 0)
+        {
+            myStringBuilderAppend(builder, keywords[nextRandom() % KEYWORD_COUNT]);
+        }
+        else
+        {
+            int length = 2 + (int) (nextRandom() % 9);
+            randomWord(word, length);
+            myStringBuilderAppendView(builder, myStringViewOfBuffer(word, (unsigned long) length));
+        }
+        myStringBuilderAppendChar(builder, ' ');
+    }
+    myStringBuilderFinish(builder, text);
+    unsigned long total = 0;
+    double start = now();
+    for (int i = 0; i < KEYWORD_COUNT; i++)
+    {
+        total += myStringCount(text, keywords[i], false);
+    }
+    double countTime = now() - start;
+    start = now();
+    MyStringMatcher *matcher = myStringMatcherCreate((const MyString * const *) keywords,
+                                                     KEYWORD_COUNT);
+    double buildTime = now() - start;
+    start = now();
+    unsigned long matched = myStringMatcherFind(matcher, text, NULL, 0);
+    double matchTime = now() - start;
+    double megabytes = (double) myStringLen(text) / (1024 * 1024);
+    printf("find %d keywords in %.0f MB: myStringCount per keyword %.3fs, matcher build %.4fs, "
+           "scan %.3fs (%.0f MB/s, %.2fx) [%lu %lu]\n", KEYWORD_COUNT, megabytes, countTime,
+           buildTime, matchTime, megabytes / matchTime, countTime / (buildTime + matchTime),
+           total, matched);
+    myStringMatcherDestroy(matcher);
+    myStringBuilderDestroy(builder);
+    myStringFree(text);
+    freeAll(keywords, KEYWORD_COUNT);
+}
+
+/**
+ * @brief Counts many substrings of a large text, with a pass of myStringCount for every one and
+ *        with a MyStringIndex of the text (whose build time is counted too).
+ */
+static void benchIndex()
+{
+    char word[ALPHABET_SIZE];
+    MyStringBuilder *builder = myStringBuilderCreate();
+    MyString *text = myStringAlloc();
+    while (myStringBuilderLen(builder) < INDEX_TEXT_SIZE)
+    {
+        // few letters, so the text has many repeats like real text does
+        int length = 2 + (int) (nextRandom() % 7);
+        for (int i = 0; i < length; i++)
+        {
+            word[i] = (char) ('a' + nextRandom() % 8);
+        }
+        myStringBuilderAppendView(builder, myStringViewOfBuffer(word, (unsigned long) length));
+        myStringBuilderAppendChar(builder, ' ');
+    }
+    myStringBuilderFinish(builder, text);
+    MyStringView view = myStringViewOf(text);
+    MyString **queries = malloc(INDEX_QUERIES * sizeof(MyString *));
+    for (int i = 0; i < INDEX_QUERIES; i++)
+    {
+        unsigned long length = 4 + nextRandom() % 8;
+        queries[i] = myStringAlloc();
+        myStringSetFromView(queries[i], myStringViewSlice(view, nextRandom() % (view.length -
+                                                                                 length), length));
+    }
+    unsigned long total = 0;
+    double start = now();
+    for (int i = 0; i < INDEX_QUERIES; i++)
+    {
+        total += myStringCount(text, queries[i], false);
+    }
+    double countTime = now() - start;
+    start = now();
+    MyStringIndex *index = myStringIndexBuild(text);
+    double buildTime = now() - start;
+    start = now();
+    for (int i = 0; i < INDEX_QUERIES; i++)
+    {
+        total -= myStringIndexCount(index, queries[i]);
+    }
+    double queryTime = now() - start;
+    printf("count %d substrings of %d MB: myStringCount %.3fs, index build %.3fs, queries %.4fs "
+           "(%.2fx) [%lu]\n", INDEX_QUERIES, INDEX_TEXT_SIZE / (1024 * 1024), countTime,
+           buildTime, queryTime, countTime / (buildTime + queryTime), total);
+    myStringIndexDestroy(index);
+    myStringBuilderDestroy(builder);
+    myStringFree(text);
+    freeAll(queries, INDEX_QUERIES);
+}
+
+/**
+ * @brief Runs all the benchmarks.
+ * @return 0 when done
+ */
+int main()
+{
+    benchPackedSort();
+    benchCompare();
+    benchSort();
+    benchParallelSort();
+    benchWrite();
+    benchReadLine();
+    benchSplit();
+    benchRope();
+    benchBuilder();
+    benchFormat();
+    benchParse();
+    benchFilter();
+    benchSearch();
+    benchMatcher();
+    benchIndex();
+    return 0;
+}
@@ -6,16 +6,6 @@
  * @brief Message to be added between our two MyStrings in file
  */
 #define MESSAGE " is smaller than "
-/*
- * @def NULL_BYTE
- * @brief Null byte character
- */
-#define NULL_BYTE '\0'
-/*
- * @def MAX_SIZE
- * @brief Max size of string to be received
- */
-#define MAX_SIZE 500
 /*
  * @def PROMPT
  * @brief Message to be printed to user before string inputs
@@ -25,7 +15,7 @@
  * @def NEW_LINE
  * @brief new line character
  */
-#define NEW_LINE "\n"
+#define NEW_LINE '\n'
 /*
  * @def FILE_NAME
  * @brief Output file name
@@ -33,40 +23,35 @@
 #define FILE_NAME "test.out"
 
 /**
- * @brief Writes the appropriate strings to the file.
+ * @brief Writes the appropriate strings to the writer.
  */
-void stringWriter(const MyString* string1, const MyString* string2, FILE *stream)
+void stringWriter(const MyString* string1, const MyString* string2, MyStringWriter *writer)
 {
-    myStringWrite(string1, stream);
-    fputs(MESSAGE, stream);
-    myStringWrite(string2, stream);
-    fputs(NEW_LINE, stream);
+    myStringWriterWrite(writer, string1);
+    myStringWriterWriteCString(writer, MESSAGE);
+    myStringWriterWrite(writer, string2);
+    myStringWriterWriteChar(writer, NEW_LINE);
 }
 
 /**
  * @brief Compares the two strings and sends appropriate parameters to stringWriter
  */
-void compareAndWriteToFile(const char* str1, const char* str2, FILE *stream)
+void compareAndWriteToFile(const MyString* myStr1, const MyString* myStr2, FILE *stream)
 {
-    // allocate two my strings and set them from our c strings
-    MyString *myStr1 = myStringAlloc();
-    MyString *myStr2 = myStringAlloc();
-    myStringSetFromCString(myStr1, str1);
-    myStringSetFromCString(myStr2, str2);
-    // compare the two and send to stringWriter appropriately
+    // compare the two and send to stringWriter appropriately, with a writer flushing every line
+    MyStringWriter *writer = myStringWriterCreate(stream, 0, MYSTRING_FLUSH_LINES, 1);
     int comparison = myStringCompare(myStr1, myStr2);
     if(comparison <= 0)
     {
-        stringWriter(myStr1, myStr2, stream);
+        stringWriter(myStr1, myStr2, writer);
     }
     else
     {
-        stringWriter(myStr2, myStr1, stream);
+        stringWriter(myStr2, myStr1, writer);
     }
-    // flush the stream and free our MyStrings
-    fflush(stream);
-    myStringFree(myStr1);
-    myStringFree(myStr2);
+    // flush the writer
+    myStringWriterFlush(writer);
+    myStringWriterDestroy(writer);
 }
 
 /**
@@ -75,18 +60,19 @@ void compareAndWriteToFile(const char* str1, const char* str2, FILE *stream)
  */
 int main()
 {
-    // initialize two char arrays the size of maximum size
-    char str1[MAX_SIZE] = {NULL_BYTE};
-    char str2[MAX_SIZE] = {NULL_BYTE};
-    // prompt the user and scan their input
+    // allocate two MyStrings, prompt the user and read a line of input into each (of any length)
+    MyString *str1 = myStringAlloc();
+    MyString *str2 = myStringAlloc();
     printf(PROMPT);
-    scanf("%s", str1);
+    myStringReadLine(str1, stdin);
     printf(PROMPT);
-    scanf(" %[^\n]s", str2);
+    myStringReadLine(str2, stdin);
     // open a file called "test.out" and send it and the strings to compareAndWriteToFile
     FILE *testFile = fopen(FILE_NAME, "w");
     compareAndWriteToFile(str1, str2, testFile);
     fclose(testFile);
+    myStringFree(str1);
+    myStringFree(str2);
     return 0;
 }
 